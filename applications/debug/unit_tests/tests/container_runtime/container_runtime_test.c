@@ -0,0 +1,400 @@
+#include "../test.h" // IWYU pragma: keep
+
+#include <furi.h>
+#include <furi_hal.h>
+#include <furi/containerization/containerization.h>
+#include <furi/containerization/container_runtime_i.h>
+
+// Test containers run in the shared runtime: container ids tag storage
+// accounts, so a second runtime would collide with it
+#define CONTAINER_RUNTIME_TEST_NAME "unit_test_ct"
+
+// Records are reused this many times, every earlier handle has to go stale
+#define CONTAINER_RUNTIME_TEST_REUSES 3
+
+// Restarts until the back-off is well past the cap
+#define CONTAINER_RUNTIME_TEST_RESTARTS 12
+
+// Random values tried per back-off for the jitter bounds
+#define CONTAINER_RUNTIME_TEST_RANDOMS 64
+
+// Scheduler samples memory and retries admissions once a second
+#define CONTAINER_RUNTIME_TEST_TIMEOUT_MS 5000
+#define CONTAINER_RUNTIME_TEST_POLL_MS    50
+
+#define CONTAINER_RUNTIME_TEST_FLAG_EXIT (1 << 0)
+
+// Budget of a load container on top of what it allocates
+#define CONTAINER_RUNTIME_TEST_SLACK 2048
+
+// Load of a small preemption victim, well below the shortfall it is preempted for
+#define CONTAINER_RUNTIME_TEST_SMALL_LOAD 256
+
+// Memory a candidate is short of, more than a small victim releases
+#define CONTAINER_RUNTIME_TEST_SHORTFALL 1024
+
+typedef struct {
+    size_t size; // Allocated by the container for as long as it runs
+} ContainerRuntimeTestLoad;
+
+typedef enum {
+    ContainerRuntimeTestSmallBestEffort,
+    ContainerRuntimeTestLarge,
+    ContainerRuntimeTestSmallNormal,
+    ContainerRuntimeTestCandidate,
+    ContainerRuntimeTestCount,
+} ContainerRuntimeTestContainer;
+
+static const char* const container_runtime_test_names[ContainerRuntimeTestCount] = {
+    "unit_test_s0",
+    "unit_test_l",
+    "unit_test_s1",
+    "unit_test_h",
+};
+
+static ContainerRuntime* runtime;
+// Outlive a failed test, its containers may still be started until teardown
+static FuriSemaphore* ready;
+static ContainerRuntimeTestLoad loads[ContainerRuntimeTestCount];
+
+static Container* container_runtime_test_create(const char* name) {
+    const ContainerConfig config = {
+        .name = name,
+        .image = "unit_test",
+        .restart_policy = ContainerRestartPolicyNever,
+        .priority_class = ContainerPriorityClassBestEffort,
+        .resource_limits = {.max_memory = 1024, .max_threads = 1},
+    };
+
+    return container_create(runtime, &config);
+}
+
+static bool container_runtime_test_signal(uint32_t signal, void* arg, void* context) {
+    UNUSED(arg);
+    if(signal != FuriSignalExit) return false;
+
+    furi_thread_flags_set((FuriThreadId)context, CONTAINER_RUNTIME_TEST_FLAG_EXIT);
+    return true;
+}
+
+// Fails right away, so the runtime keeps restarting it
+static int32_t container_runtime_test_crash(void* context) {
+    UNUSED(context);
+    return 1;
+}
+
+// Holds its load until asked to exit, heap is traced to the container
+static int32_t container_runtime_test_load(void* context) {
+    ContainerRuntimeTestLoad* load = context;
+    void* memory = malloc(load->size);
+
+    furi_thread_set_signal_callback(
+        furi_thread_get_current(), container_runtime_test_signal, furi_thread_get_current_id());
+    furi_semaphore_release(ready);
+    furi_thread_flags_wait(CONTAINER_RUNTIME_TEST_FLAG_EXIT, FuriFlagWaitAny, FuriWaitForever);
+
+    free(memory);
+    return 0;
+}
+
+static Container* container_runtime_test_create_load(
+    const char* name,
+    ContainerPriorityClass priority_class,
+    uint32_t max_memory,
+    ContainerRuntimeTestLoad* load) {
+    const ContainerConfig config = {
+        .name = name,
+        .image = "unit_test",
+        .args = load,
+        .restart_policy = ContainerRestartPolicyNever,
+        .priority_class = priority_class,
+        .resource_limits = {.max_memory = max_memory, .max_threads = 1},
+        .entry_point = container_runtime_test_load,
+    };
+
+    return container_create(runtime, &config);
+}
+
+static ContainerStatus container_runtime_test_status(Container* container) {
+    ContainerStatus status;
+    container_get_status(container, &status);
+    return status;
+}
+
+static bool
+    container_runtime_test_wait_restart_pending(Container* container, uint32_t restart_count) {
+    for(uint32_t waited = 0; waited < CONTAINER_RUNTIME_TEST_TIMEOUT_MS;
+        waited += CONTAINER_RUNTIME_TEST_POLL_MS) {
+        const ContainerStatus status = container_runtime_test_status(container);
+        if(status.restart_pending && status.restart_count == restart_count) return true;
+        furi_delay_ms(CONTAINER_RUNTIME_TEST_POLL_MS);
+    }
+
+    return false;
+}
+
+static bool container_runtime_test_wait_running(Container* container) {
+    for(uint32_t waited = 0; waited < CONTAINER_RUNTIME_TEST_TIMEOUT_MS;
+        waited += CONTAINER_RUNTIME_TEST_POLL_MS) {
+        if(container_runtime_test_status(container).state == ContainerStateRunning) return true;
+        furi_delay_ms(CONTAINER_RUNTIME_TEST_POLL_MS);
+    }
+
+    return false;
+}
+
+// Preemption accounts victims by their sampled memory_used
+static bool container_runtime_test_wait_sampled(Container* container, size_t memory_used) {
+    for(uint32_t waited = 0; waited < CONTAINER_RUNTIME_TEST_TIMEOUT_MS;
+        waited += CONTAINER_RUNTIME_TEST_POLL_MS) {
+        if(container_runtime_test_status(container).memory_used >= memory_used) return true;
+        furi_delay_ms(CONTAINER_RUNTIME_TEST_POLL_MS);
+    }
+
+    return false;
+}
+
+// Sequence of the first admission of container after sequence, UINT32_MAX if none
+static uint32_t container_runtime_test_find_admission(uint32_t sequence, ContainerId container) {
+    ContainerTrace* trace = container_runtime_get_trace(runtime);
+    ContainerTraceEvent event;
+
+    while(container_trace_read(trace, &sequence, &event, 1)) {
+        if(event.type == ContainerTraceEventAdmission && event.container == container) {
+            return sequence;
+        }
+    }
+
+    return UINT32_MAX;
+}
+
+static void container_runtime_test_setup(void) {
+    runtime = furi_get_container_runtime();
+    furi_check(runtime);
+    ready = furi_semaphore_alloc(ContainerRuntimeTestCount, 0);
+}
+
+// Failed assertions return early, containers they leave behind would take the names
+static void container_runtime_test_teardown(void) {
+    Container* container = container_runtime_find(runtime, CONTAINER_RUNTIME_TEST_NAME);
+    if(container) container_delete(container);
+
+    for(size_t i = 0; i < ContainerRuntimeTestCount; i++) {
+        container = container_runtime_find(runtime, container_runtime_test_names[i]);
+        if(container) container_delete(container);
+    }
+
+    furi_semaphore_free(ready);
+}
+
+MU_TEST(container_runtime_test_generation) {
+    Container* container = container_runtime_test_create(CONTAINER_RUNTIME_TEST_NAME);
+    mu_assert(container, "create failed");
+    ContainerId ids[CONTAINER_RUNTIME_TEST_REUSES + 1];
+    ids[0] = container_get_id(container);
+    mu_assert(container_runtime_get(runtime, ids[0]) == container, "id not resolved");
+
+    for(size_t i = 1; i < COUNT_OF(ids); i++) {
+        mu_assert(container_delete(container), "delete failed");
+        mu_assert(!container_runtime_get(runtime, ids[i - 1]), "deleted id resolved");
+        mu_assert(
+            !container_runtime_find(runtime, CONTAINER_RUNTIME_TEST_NAME), "deleted name found");
+
+        // Freed record is the first one handed out again
+        Container* reused = container_runtime_test_create(CONTAINER_RUNTIME_TEST_NAME);
+        mu_assert(reused == container, "record not reused");
+        ids[i] = container_get_id(reused);
+        mu_assert(container_runtime_get(runtime, ids[i]) == reused, "id not resolved");
+
+        // Same record, none of its earlier handles resolve to it
+        for(size_t j = 0; j < i; j++) {
+            mu_assert(ids[j] != ids[i], "generation not bumped");
+            mu_assert(!container_runtime_get(runtime, ids[j]), "stale id resolved");
+        }
+    }
+
+    mu_assert(container_delete(container), "delete failed");
+    mu_assert(!container_runtime_get(runtime, ids[COUNT_OF(ids) - 1]), "deleted id resolved");
+    mu_assert(!container_runtime_get(runtime, CONTAINER_ID_INVALID), "invalid id resolved");
+}
+
+// Candidate short of CONTAINER_RUNTIME_TEST_SHORTFALL preempts the small
+// BestEffort container for its class, then the large Normal one for its size.
+// Their memory_used covers the shortfall, so the small Normal one keeps running.
+MU_TEST(container_runtime_test_preemption) {
+    ContainerRuntimeTestLoad* small_load = &loads[ContainerRuntimeTestSmallBestEffort];
+    ContainerRuntimeTestLoad* large_load = &loads[ContainerRuntimeTestLarge];
+    ContainerRuntimeTestLoad* no_load = &loads[ContainerRuntimeTestCandidate];
+    small_load->size = CONTAINER_RUNTIME_TEST_SMALL_LOAD;
+    // Larger than any other free block, so it splits the largest one
+    large_load->size = memmgr_heap_get_max_free_block() / 2;
+    no_load->size = 0;
+    Container* containers[ContainerRuntimeTestCount];
+
+    containers[ContainerRuntimeTestSmallBestEffort] = container_runtime_test_create_load(
+        container_runtime_test_names[ContainerRuntimeTestSmallBestEffort],
+        ContainerPriorityClassBestEffort,
+        small_load->size + CONTAINER_RUNTIME_TEST_SLACK,
+        small_load);
+    containers[ContainerRuntimeTestLarge] = container_runtime_test_create_load(
+        container_runtime_test_names[ContainerRuntimeTestLarge],
+        ContainerPriorityClassNormal,
+        large_load->size + CONTAINER_RUNTIME_TEST_SLACK,
+        large_load);
+    containers[ContainerRuntimeTestSmallNormal] = container_runtime_test_create_load(
+        container_runtime_test_names[ContainerRuntimeTestSmallNormal],
+        ContainerPriorityClassNormal,
+        small_load->size + CONTAINER_RUNTIME_TEST_SLACK,
+        small_load);
+
+    for(size_t i = 0; i < ContainerRuntimeTestCandidate; i++) {
+        mu_assert(containers[i], "create failed");
+        mu_assert(container_start(containers[i]), "start failed");
+        mu_assert(
+            furi_semaphore_acquire(ready, CONTAINER_RUNTIME_TEST_TIMEOUT_MS) == FuriStatusOk,
+            "not ready");
+    }
+    mu_assert(
+        container_runtime_test_wait_sampled(
+            containers[ContainerRuntimeTestLarge], large_load->size),
+        "large load not sampled");
+    mu_assert(
+        container_runtime_test_wait_sampled(
+            containers[ContainerRuntimeTestSmallBestEffort], small_load->size),
+        "small load not sampled");
+
+    // Admission takes the budget plus a fifth, candidate misses the largest block by the shortfall
+    const size_t required = memmgr_heap_get_max_free_block() + CONTAINER_RUNTIME_TEST_SHORTFALL;
+    containers[ContainerRuntimeTestCandidate] = container_runtime_test_create_load(
+        container_runtime_test_names[ContainerRuntimeTestCandidate],
+        ContainerPriorityClassHigh,
+        required * 5 / 6,
+        no_load);
+    mu_assert(containers[ContainerRuntimeTestCandidate], "create failed");
+
+    ContainerTraceEvent event;
+    uint32_t sequence = 0;
+    while(container_trace_read(container_runtime_get_trace(runtime), &sequence, &event, 1)) {
+    }
+
+    mu_assert(!container_start(containers[ContainerRuntimeTestCandidate]), "candidate admitted");
+    ContainerStatus status =
+        container_runtime_test_status(containers[ContainerRuntimeTestCandidate]);
+    mu_assert(status.admission_pending, "candidate not waiting");
+    mu_assert(!status.preempted, "candidate preempted");
+
+    // Lowest class first, then the largest heap user, until their memory covers the shortfall
+    status = container_runtime_test_status(containers[ContainerRuntimeTestSmallBestEffort]);
+    mu_assert(status.preempted && status.admission_pending, "lowest class not preempted");
+    status = container_runtime_test_status(containers[ContainerRuntimeTestLarge]);
+    mu_assert(status.preempted && status.admission_pending, "largest user not preempted");
+    status = container_runtime_test_status(containers[ContainerRuntimeTestSmallNormal]);
+    mu_assert(!status.preempted && !status.admission_pending, "preempted past the shortfall");
+    mu_assert(status.state == ContainerStateRunning, "not running");
+
+    // Candidate starts once the victims are gone, then the victims come back
+    for(size_t i = 0; i < ContainerRuntimeTestCount; i++) {
+        mu_assert(container_runtime_test_wait_running(containers[i]), "not started again");
+        status = container_runtime_test_status(containers[i]);
+        mu_assert(!status.preempted && !status.admission_pending, "still waiting");
+    }
+
+    // Both wait for the large victim's heap, the higher class is admitted first
+    const uint32_t candidate = container_runtime_test_find_admission(
+        sequence, container_get_id(containers[ContainerRuntimeTestCandidate]));
+    const uint32_t large = container_runtime_test_find_admission(
+        sequence, container_get_id(containers[ContainerRuntimeTestLarge]));
+    mu_assert(candidate != UINT32_MAX && large != UINT32_MAX, "admission not traced");
+    mu_assert(candidate < large, "admitted out of class order");
+
+    for(size_t i = 0; i < ContainerRuntimeTestCount; i++) {
+        mu_assert(container_delete(containers[i]), "delete failed");
+    }
+}
+
+MU_TEST(container_runtime_test_backoff) {
+    // Doubles from the minimum up to the cap while runs are short
+    uint32_t backoff = 0;
+    uint32_t expected = CONTAINER_RESTART_BACKOFF_MIN_MS;
+    for(size_t i = 0; i < CONTAINER_RUNTIME_TEST_RESTARTS; i++) {
+        backoff = container_restart_backoff_next(backoff, furi_ms_to_ticks(1000));
+        mu_assert_int_eq(expected, backoff);
+        expected = MIN(expected * 2, (uint32_t)CONTAINER_RESTART_BACKOFF_MAX_MS);
+    }
+    mu_assert_int_eq(CONTAINER_RESTART_BACKOFF_MAX_MS, backoff);
+
+    // Starts over once a run lasts the reset period, a failed start never ran
+    const uint32_t reset_ticks = furi_ms_to_ticks(CONTAINER_RESTART_BACKOFF_RESET_MS);
+    mu_assert_int_eq(
+        CONTAINER_RESTART_BACKOFF_MAX_MS, container_restart_backoff_next(backoff, reset_ticks - 1));
+    mu_assert_int_eq(
+        CONTAINER_RESTART_BACKOFF_MIN_MS, container_restart_backoff_next(backoff, reset_ticks));
+    mu_assert_int_eq(
+        CONTAINER_RESTART_BACKOFF_MAX_MS, container_restart_backoff_next(backoff, 0));
+
+    // Jitter takes up to a quarter off, never adds to the back-off
+    const uint32_t backoffs[] = {
+        CONTAINER_RESTART_BACKOFF_MIN_MS,
+        CONTAINER_RESTART_BACKOFF_MIN_MS * 2,
+        CONTAINER_RESTART_BACKOFF_MAX_MS,
+    };
+    for(size_t i = 0; i < COUNT_OF(backoffs); i++) {
+        const uint32_t shortest = backoffs[i] - backoffs[i] / 4;
+        mu_assert_int_eq(backoffs[i], container_restart_delay(backoffs[i], 0));
+        mu_assert_int_eq(shortest, container_restart_delay(backoffs[i], backoffs[i] / 4));
+        mu_assert_int_eq(backoffs[i], container_restart_delay(backoffs[i], backoffs[i] / 4 + 1));
+
+        for(size_t j = 0; j < CONTAINER_RUNTIME_TEST_RANDOMS; j++) {
+            const uint32_t delay = container_restart_delay(backoffs[i], furi_hal_random_get());
+            mu_assert_int_between(shortest, backoffs[i], delay);
+        }
+    }
+}
+
+// Delay reported for a crashing container is the back-off with bounded jitter
+MU_TEST(container_runtime_test_restart_delay) {
+    const ContainerConfig config = {
+        .name = CONTAINER_RUNTIME_TEST_NAME,
+        .image = "unit_test",
+        .restart_policy = ContainerRestartPolicyOnFailure,
+        .priority_class = ContainerPriorityClassBestEffort,
+        .resource_limits = {.max_memory = 1024, .max_threads = 1},
+        .entry_point = container_runtime_test_crash,
+    };
+    Container* container = container_create(runtime, &config);
+    mu_assert(container, "create failed");
+    mu_assert(container_start(container), "start failed");
+
+    // Polling eats into the delay before it is read
+    uint32_t backoff = CONTAINER_RESTART_BACKOFF_MIN_MS;
+    for(uint32_t restart_count = 0; restart_count < 2; restart_count++) {
+        mu_assert(
+            container_runtime_test_wait_restart_pending(container, restart_count),
+            "restart not pending");
+        const ContainerStatus status = container_runtime_test_status(container);
+        mu_assert_int_eq(ContainerExitReasonError, status.exit_reason);
+        mu_assert_int_between(
+            backoff - backoff / 4 - 2 * CONTAINER_RUNTIME_TEST_POLL_MS,
+            backoff,
+            status.restart_delay);
+        backoff *= 2;
+    }
+
+    mu_assert(container_delete(container), "delete failed");
+}
+
+MU_TEST_SUITE(test_container_runtime) {
+    MU_SUITE_CONFIGURE(&container_runtime_test_setup, &container_runtime_test_teardown);
+
+    MU_RUN_TEST(container_runtime_test_generation);
+    MU_RUN_TEST(container_runtime_test_preemption);
+    MU_RUN_TEST(container_runtime_test_backoff);
+    MU_RUN_TEST(container_runtime_test_restart_delay);
+}
+
+int run_minunit_test_container_runtime(void) {
+    MU_RUN_SUITE(test_container_runtime);
+    return MU_EXIT_CODE;
+}
+
+TEST_API_DEFINE(run_minunit_test_container_runtime)
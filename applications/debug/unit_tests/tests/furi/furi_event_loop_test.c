@@ -1,6 +1,7 @@
 #include "../test.h"
 #include <furi.h>
 #include <furi_hal.h>
+#include <core/message_pool.h>
 
 #include <FreeRTOS.h>
 #include <task.h>
@@ -537,3 +538,282 @@ void test_furi_event_loop(void) {
     furi_event_flag_free(data.event_flag);
     furi_semaphore_free(data.semaphore);
 }
+
+#define TIMER_BENCH_FIRES     20000UL
+#define TIMER_BENCH_MAX_COUNT 1000UL
+
+typedef struct {
+    FuriEventLoop* event_loop;
+    bool rearm; // One-shot timers started again from their callback, like setTimeout chains
+    uint32_t fires;
+    uint32_t start;
+    uint32_t cycles;
+} TestFuriEventLoopTimerBench;
+
+typedef struct {
+    TestFuriEventLoopTimerBench* bench;
+    FuriEventLoopTimer* timer;
+    uint32_t interval;
+} TestFuriEventLoopTimerBenchItem;
+
+static void test_furi_event_loop_timer_bench_callback(void* context) {
+    TestFuriEventLoopTimerBenchItem* item = context;
+    TestFuriEventLoopTimerBench* bench = item->bench;
+
+    // Timers already expired may still run before the loop stops
+    if(bench->fires == TIMER_BENCH_FIRES) return;
+
+    if(bench->fires == 0) bench->start = DWT->CYCCNT;
+    if(bench->rearm) furi_event_loop_timer_start(item->timer, item->interval);
+
+    bench->fires++;
+    if(bench->fires == TIMER_BENCH_FIRES) {
+        bench->cycles = DWT->CYCCNT - bench->start;
+        furi_event_loop_stop(bench->event_loop);
+    }
+}
+
+// Intervals of a few ticks keep the loop busy, so the time per expiration is all timer handling
+static void test_furi_event_loop_timer_bench_run(
+    TestFuriEventLoopTimerBench* bench,
+    size_t count,
+    bool rearm) {
+    FuriEventLoop* event_loop = furi_event_loop_alloc();
+    *bench = (TestFuriEventLoopTimerBench){.event_loop = event_loop, .rearm = rearm};
+    TestFuriEventLoopTimerBenchItem* items =
+        malloc(sizeof(TestFuriEventLoopTimerBenchItem) * count);
+
+    for(size_t i = 0; i < count; i++) {
+        items[i].bench = bench;
+        items[i].interval = 1 + i % 8;
+        items[i].timer = furi_event_loop_timer_alloc(
+            event_loop,
+            test_furi_event_loop_timer_bench_callback,
+            rearm ? FuriEventLoopTimerTypeOnce : FuriEventLoopTimerTypePeriodic,
+            &items[i]);
+        furi_event_loop_timer_start(items[i].timer, items[i].interval);
+    }
+
+    furi_event_loop_run(event_loop);
+
+    for(size_t i = 0; i < count; i++) {
+        furi_event_loop_timer_free(items[i].timer);
+    }
+    free(items);
+    furi_event_loop_free(event_loop);
+}
+
+/* Cost of an expiration with few and with many timers armed, should grow
+ * with the logarithm of the timer count. */
+void test_furi_event_loop_timer_bench(void) {
+    // Leave most of the heap to the rest of the system
+    const size_t count = MIN(TIMER_BENCH_MAX_COUNT, memmgr_get_free_heap() / 4 / 128);
+    const size_t counts[] = {8, count};
+
+    for(size_t i = 0; i < COUNT_OF(counts); i++) {
+        TestFuriEventLoopTimerBench periodic, rearm;
+        test_furi_event_loop_timer_bench_run(&periodic, counts[i], false);
+        mu_assert_int_eq(TIMER_BENCH_FIRES, periodic.fires);
+        test_furi_event_loop_timer_bench_run(&rearm, counts[i], true);
+        mu_assert_int_eq(TIMER_BENCH_FIRES, rearm.fires);
+
+        FURI_LOG_I(
+            TAG,
+            "%u timers: periodic %lu, rearmed %lu cycles per expiration",
+            counts[i],
+            periodic.cycles / periodic.fires,
+            rearm.cycles / rearm.fires);
+    }
+}
+
+#define PENDING_BURST_COUNT  (8UL)
+#define PENDING_THREAD_COUNT (64UL)
+#define PENDING_TOTAL_COUNT  (PENDING_BURST_COUNT + PENDING_THREAD_COUNT)
+#define PENDING_BATCH_SIZE   (3UL)
+
+typedef struct {
+    FuriEventLoop* event_loop;
+    volatile uint32_t called;
+    bool out_of_order;
+} TestFuriEventLoopPending;
+
+typedef struct {
+    TestFuriEventLoopPending* data;
+    uint32_t index;
+} TestFuriEventLoopPendingItem;
+
+static void test_furi_event_loop_pending_order_callback(void* context) {
+    TestFuriEventLoopPendingItem* item = context;
+    TestFuriEventLoopPending* data = item->data;
+
+    if(item->index != data->called) data->out_of_order = true;
+    data->called++;
+
+    if(data->called == PENDING_TOTAL_COUNT) {
+        furi_event_loop_stop(data->event_loop);
+    }
+}
+
+static int32_t test_furi_event_loop_pending_producer(void* context) {
+    TestFuriEventLoopPendingItem* items = context;
+    TestFuriEventLoopPending* data = items[0].data;
+
+    for(uint32_t i = PENDING_BURST_COUNT; i < PENDING_TOTAL_COUNT; i++) {
+        furi_event_loop_pend_callback(
+            data->event_loop, test_furi_event_loop_pending_order_callback, &items[i]);
+
+        // Let the event loop catch up after every burst, so the queue never fills up
+        if((i + 1) % PENDING_BURST_COUNT == 0) {
+            while(data->called <= i) {
+                furi_delay_tick(1);
+            }
+        }
+    }
+
+    return 0;
+}
+
+void test_furi_event_loop_pending(void) {
+    TestFuriEventLoopPending data = {.event_loop = furi_event_loop_alloc()};
+    TestFuriEventLoopPendingItem* items =
+        malloc(sizeof(TestFuriEventLoopPendingItem) * PENDING_TOTAL_COUNT);
+
+    for(uint32_t i = 0; i < PENDING_TOTAL_COUNT; i++) {
+        items[i].data = &data;
+        items[i].index = i;
+    }
+
+    furi_event_loop_set_pending_batch_size(data.event_loop, PENDING_BATCH_SIZE);
+
+    // Pended before the loop runs, delivered in batches on a single notification
+    for(uint32_t i = 0; i < PENDING_BURST_COUNT; i++) {
+        furi_event_loop_pend_callback(
+            data.event_loop, test_furi_event_loop_pending_order_callback, &items[i]);
+    }
+
+    FuriThread* producer_thread = furi_thread_alloc_ex(
+        "pending_producer", 1 * 1024, test_furi_event_loop_pending_producer, items);
+    furi_thread_start(producer_thread);
+
+    furi_event_loop_run(data.event_loop);
+
+    furi_thread_join(producer_thread);
+    furi_thread_free(producer_thread);
+
+    FuriEventLoopPendingStats stats;
+    furi_event_loop_get_pending_stats(data.event_loop, &stats);
+
+    // Nothing drains the stopped loop, so the queue fills up and refuses the next one
+    size_t queued = 0;
+    while(queued <= PENDING_TOTAL_COUNT &&
+          furi_event_loop_pend_callback(
+              data.event_loop, test_furi_event_loop_pending_order_callback, &items[0])) {
+        queued++;
+    }
+    FuriEventLoopPendingStats full_stats;
+    furi_event_loop_get_pending_stats(data.event_loop, &full_stats);
+
+    furi_event_loop_free(data.event_loop);
+    free(items);
+
+    mu_assert_int_eq(PENDING_TOTAL_COUNT, data.called);
+    mu_assert(!data.out_of_order, "pending callbacks called out of order");
+    mu_assert_int_eq(PENDING_TOTAL_COUNT, stats.pended);
+    mu_assert(stats.coalesced >= PENDING_BURST_COUNT - 1, "burst not coalesced");
+    mu_assert(stats.peak >= PENDING_BURST_COUNT, "burst not queued at once");
+    mu_assert(
+        stats.deferred >= PENDING_BURST_COUNT / PENDING_BATCH_SIZE, "batch size not applied");
+    mu_assert(stats.wakeups < stats.pended, "no wakeups saved");
+    mu_assert_int_eq(0, stats.dropped);
+
+    mu_assert(queued > 0 && queued <= PENDING_TOTAL_COUNT, "full queue not refused");
+    mu_assert_int_eq(1, full_stats.dropped);
+    mu_assert_int_eq(queued, full_stats.peak);
+}
+
+#define MESSAGE_POOL_COUNT    (4UL)
+#define MESSAGE_POOL_MESSAGES (64UL)
+
+typedef struct {
+    uint32_t index;
+    uint8_t payload[60];
+} TestFuriEventLoopPoolMessage;
+
+typedef struct {
+    FuriEventLoop* event_loop;
+    FuriMessagePool* message_pool;
+    uint32_t received;
+    bool corrupted;
+} TestFuriEventLoopPool;
+
+static void test_furi_event_loop_pool_callback(FuriEventLoopObject* object, void* context) {
+    TestFuriEventLoopPool* data = context;
+    furi_check(data->message_pool == object);
+
+    TestFuriEventLoopPoolMessage* message;
+    furi_check(furi_message_pool_get(data->message_pool, (void**)&message, 0) == FuriStatusOk);
+
+    if(message->index != data->received ||
+       message->payload[COUNT_OF(message->payload) - 1] != (uint8_t)message->index) {
+        data->corrupted = true;
+    }
+    furi_message_pool_release(data->message_pool, message);
+
+    data->received++;
+    if(data->received == MESSAGE_POOL_MESSAGES) {
+        furi_event_loop_stop(data->event_loop);
+    }
+}
+
+static int32_t test_furi_event_loop_pool_producer(void* context) {
+    TestFuriEventLoopPool* data = context;
+
+    // Far more messages than slots, every slot goes around many times
+    for(uint32_t i = 0; i < MESSAGE_POOL_MESSAGES; i++) {
+        TestFuriEventLoopPoolMessage* message;
+        furi_check(
+            furi_message_pool_acquire(data->message_pool, (void**)&message, FuriWaitForever) ==
+            FuriStatusOk);
+
+        message->index = i;
+        memset(message->payload, i, sizeof(message->payload));
+        furi_message_pool_put(data->message_pool, message);
+    }
+
+    return 0;
+}
+
+void test_furi_event_loop_message_pool(void) {
+    TestFuriEventLoopPool data = {
+        .event_loop = furi_event_loop_alloc(),
+        .message_pool =
+            furi_message_pool_alloc(MESSAGE_POOL_COUNT, sizeof(TestFuriEventLoopPoolMessage)),
+    };
+
+    furi_event_loop_subscribe_message_pool(
+        data.event_loop,
+        data.message_pool,
+        FuriEventLoopEventIn,
+        test_furi_event_loop_pool_callback,
+        &data);
+
+    FuriThread* producer_thread = furi_thread_alloc_ex(
+        "pool_producer", 1 * 1024, test_furi_event_loop_pool_producer, &data);
+    furi_thread_start(producer_thread);
+
+    furi_event_loop_run(data.event_loop);
+
+    furi_thread_join(producer_thread);
+    furi_thread_free(producer_thread);
+
+    furi_event_loop_unsubscribe(data.event_loop, data.message_pool);
+    furi_event_loop_free(data.event_loop);
+
+    // Every slot must be back, free checks it
+    const uint32_t space = furi_message_pool_get_space(data.message_pool);
+    furi_message_pool_free(data.message_pool);
+
+    mu_assert_int_eq(MESSAGE_POOL_MESSAGES, data.received);
+    mu_assert(!data.corrupted, "message pool messages corrupted or out of order");
+    mu_assert_int_eq(MESSAGE_POOL_COUNT, space);
+}
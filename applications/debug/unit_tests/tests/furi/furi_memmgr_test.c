@@ -1,8 +1,13 @@
 #include "../test.h" // IWYU pragma: keep
+#include <furi.h>
+#include <furi_hal.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <m-dict.h>
+
+#define TAG "TestFuriMemmgr"
 
 void test_furi_memmgr(void) {
     void* ptr;
@@ -37,3 +42,452 @@ void test_furi_memmgr(void) {
     }
     free(ptr);
 }
+
+#define MEMMGR_REPLAY_SLOTS     192
+#define MEMMGR_REPLAY_PINNED    24 // Slots only freed at the end, they pin fragments in place
+#define MEMMGR_REPLAY_STEPS     8000
+#define MEMMGR_REPLAY_MAX_BYTES (32 * 1024)
+
+typedef struct {
+    uint32_t count;
+    uint64_t total;
+    uint32_t max;
+} MemmgrReplayTiming;
+
+static void memmgr_replay_timing_add(MemmgrReplayTiming* timing, uint32_t cycles) {
+    timing->count++;
+    timing->total += cycles;
+    if(cycles > timing->max) timing->max = cycles;
+}
+
+static uint32_t memmgr_replay_random(uint32_t* state) {
+    *state = *state * 1664525UL + 1013904223UL;
+    return *state >> 8;
+}
+
+// Roughly what the firmware asks for: mostly strings and small records, some buffers
+static size_t memmgr_replay_size(uint32_t* state) {
+    const uint32_t kind = memmgr_replay_random(state) % 100;
+    const uint32_t value = memmgr_replay_random(state);
+    if(kind < 60) return 8 + value % 56;
+    if(kind < 90) return 64 + value % 448;
+    return 512 + value % 3584;
+}
+
+/* Replays the same allocation trace on every build, run it on a HEAP=heap4 and
+ * a HEAP=tlsf firmware to compare the allocators. */
+void test_furi_memmgr_replay(void) {
+    void** pointers = malloc(sizeof(void*) * MEMMGR_REPLAY_SLOTS);
+    size_t* sizes = malloc(sizeof(size_t) * MEMMGR_REPLAY_SLOTS);
+    MemmgrReplayTiming alloc_timing = {0};
+    MemmgrReplayTiming free_timing = {0};
+
+    const size_t heap_before = memmgr_get_free_heap();
+    const size_t budget = MIN((size_t)MEMMGR_REPLAY_MAX_BYTES, heap_before / 4);
+    size_t live = 0;
+    uint32_t state = 0x5EED;
+
+    for(size_t step = 0; step < MEMMGR_REPLAY_STEPS; step++) {
+        const size_t slot = memmgr_replay_random(&state) % MEMMGR_REPLAY_SLOTS;
+
+        if(pointers[slot]) {
+            if(slot < MEMMGR_REPLAY_PINNED) continue;
+
+            const uint32_t start = DWT->CYCCNT;
+            free(pointers[slot]);
+            memmgr_replay_timing_add(&free_timing, DWT->CYCCNT - start);
+            pointers[slot] = NULL;
+            live -= sizes[slot];
+        } else {
+            const size_t size = memmgr_replay_size(&state);
+            if(live + size > budget) continue;
+
+            const uint32_t start = DWT->CYCCNT;
+            pointers[slot] = malloc(size);
+            memmgr_replay_timing_add(&alloc_timing, DWT->CYCCNT - start);
+            sizes[slot] = size;
+            live += size;
+        }
+    }
+
+    // Fragmentation while the pinned and live blocks are still in place
+    const size_t heap_free = memmgr_get_free_heap();
+    const size_t max_block = memmgr_heap_get_max_free_block();
+    const uint32_t fragmentation = 100 - (uint32_t)((uint64_t)max_block * 100 / heap_free);
+
+    for(size_t slot = 0; slot < MEMMGR_REPLAY_SLOTS; slot++) {
+        free(pointers[slot]);
+    }
+    free(sizes);
+    free(pointers);
+
+    mu_assert(alloc_timing.count > 0, "no allocations replayed");
+    mu_assert(free_timing.count > 0, "no frees replayed");
+
+    const uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+    FURI_LOG_I(
+        TAG,
+        "malloc: %lu calls, mean %lu max %lu cycles (%lu us)",
+        alloc_timing.count,
+        (uint32_t)(alloc_timing.total / alloc_timing.count),
+        alloc_timing.max,
+        alloc_timing.max / cycles_per_us);
+    FURI_LOG_I(
+        TAG,
+        "free: %lu calls, mean %lu max %lu cycles (%lu us)",
+        free_timing.count,
+        (uint32_t)(free_timing.total / free_timing.count),
+        free_timing.max,
+        free_timing.max / cycles_per_us);
+    FURI_LOG_I(
+        TAG,
+        "fragmentation: %lu%%, largest block %zu of %zu free",
+        fragmentation,
+        max_block,
+        heap_free);
+
+    // Other threads may allocate meanwhile, but never this much
+    mu_assert(memmgr_get_free_heap() + 1024 >= heap_before, "replay leaked memory");
+}
+
+#define MEMMGR_TRACE_BENCH_SLOTS 64
+#define MEMMGR_TRACE_BENCH_STEPS 4000
+
+// Per-thread allocation maps of the dictionary based heap trace, kept as a reference
+DICT_DEF2(MemmgrTraceBenchAllocDict, uint32_t, uint32_t) //-V1048
+
+DICT_DEF2( //-V1048
+    MemmgrTraceBenchThreadDict,
+    uint32_t,
+    M_DEFAULT_OPLIST,
+    MemmgrTraceBenchAllocDict_t,
+    DICT_OPLIST(MemmgrTraceBenchAllocDict))
+
+typedef enum {
+    MemmgrTraceBenchModeUntraced,
+    MemmgrTraceBenchModeOwner, // Heap trace of the thread enabled
+    MemmgrTraceBenchModeDict, // Untraced, the dictionary bookkeeping done by hand
+    MemmgrTraceBenchModeCount,
+} MemmgrTraceBenchMode;
+
+typedef struct {
+    MemmgrTraceBenchMode mode;
+    MemmgrReplayTiming alloc_timing;
+    MemmgrReplayTiming free_timing;
+} MemmgrTraceBench;
+
+static int32_t memmgr_trace_bench_thread(void* context) {
+    MemmgrTraceBench* bench = context;
+    void* pointers[MEMMGR_TRACE_BENCH_SLOTS] = {0};
+    uint32_t state = 0xB0A7;
+
+    MemmgrTraceBenchThreadDict_t thread_dict;
+    MemmgrTraceBenchThreadDict_init(thread_dict);
+    if(bench->mode == MemmgrTraceBenchModeDict) {
+        MemmgrTraceBenchAllocDict_t alloc_dict;
+        MemmgrTraceBenchAllocDict_init(alloc_dict);
+        MemmgrTraceBenchThreadDict_set_at(
+            thread_dict, (uint32_t)furi_thread_get_current_id(), alloc_dict);
+        MemmgrTraceBenchAllocDict_clear(alloc_dict);
+    }
+
+    for(size_t step = 0; step < MEMMGR_TRACE_BENCH_STEPS; step++) {
+        const size_t slot = memmgr_replay_random(&state) % MEMMGR_TRACE_BENCH_SLOTS;
+        const size_t size = MIN(memmgr_replay_size(&state), 1024U);
+
+        const uint32_t start = DWT->CYCCNT;
+        MemmgrTraceBenchAllocDict_t* alloc_dict = NULL;
+        if(bench->mode == MemmgrTraceBenchModeDict) {
+            alloc_dict =
+                MemmgrTraceBenchThreadDict_get(thread_dict, (uint32_t)furi_thread_get_current_id());
+        }
+
+        if(pointers[slot]) {
+            if(alloc_dict) MemmgrTraceBenchAllocDict_erase(*alloc_dict, (uint32_t)pointers[slot]);
+            free(pointers[slot]);
+            memmgr_replay_timing_add(&bench->free_timing, DWT->CYCCNT - start);
+            pointers[slot] = NULL;
+        } else {
+            pointers[slot] = malloc(size);
+            if(alloc_dict) {
+                MemmgrTraceBenchAllocDict_set_at(*alloc_dict, (uint32_t)pointers[slot], size);
+            }
+            memmgr_replay_timing_add(&bench->alloc_timing, DWT->CYCCNT - start);
+        }
+    }
+
+    for(size_t slot = 0; slot < MEMMGR_TRACE_BENCH_SLOTS; slot++) {
+        free(pointers[slot]);
+    }
+    MemmgrTraceBenchThreadDict_clear(thread_dict);
+
+    return 0;
+}
+
+/* Allocation overhead of per-thread heap accounting: owner tags in the blocks
+ * against the per-thread dictionaries they replaced. */
+void test_furi_memmgr_trace_bench(void) {
+    static const char* const mode_names[MemmgrTraceBenchModeCount] = {
+        [MemmgrTraceBenchModeUntraced] = "untraced",
+        [MemmgrTraceBenchModeOwner] = "owner tag",
+        [MemmgrTraceBenchModeDict] = "dictionary",
+    };
+    MemmgrTraceBench bench[MemmgrTraceBenchModeCount] = {0};
+
+    for(size_t mode = 0; mode < MemmgrTraceBenchModeCount; mode++) {
+        bench[mode].mode = mode;
+
+        FuriThread* thread =
+            furi_thread_alloc_ex("MemmgrTraceBench", 2048, memmgr_trace_bench_thread, &bench[mode]);
+        if(mode == MemmgrTraceBenchModeOwner) {
+            furi_thread_enable_heap_trace(thread);
+        } else {
+            furi_thread_disable_heap_trace(thread);
+        }
+
+        furi_thread_start(thread);
+        furi_thread_join(thread);
+
+        // Every block was freed by the thread, its counter must be back to zero
+        if(mode == MemmgrTraceBenchModeOwner) {
+            mu_assert_int_eq(0, furi_thread_get_heap_size(thread));
+        }
+        furi_thread_free(thread);
+
+        mu_assert(bench[mode].alloc_timing.count > 0, "no allocations");
+        mu_assert(bench[mode].free_timing.count > 0, "no frees");
+    }
+
+    const MemmgrReplayTiming* untraced_alloc = &bench[MemmgrTraceBenchModeUntraced].alloc_timing;
+    const MemmgrReplayTiming* untraced_free = &bench[MemmgrTraceBenchModeUntraced].free_timing;
+    const uint32_t untraced_alloc_mean = untraced_alloc->total / untraced_alloc->count;
+    const uint32_t untraced_free_mean = untraced_free->total / untraced_free->count;
+
+    for(size_t mode = 0; mode < MemmgrTraceBenchModeCount; mode++) {
+        const MemmgrReplayTiming* alloc_timing = &bench[mode].alloc_timing;
+        const MemmgrReplayTiming* free_timing = &bench[mode].free_timing;
+        const uint32_t alloc_mean = alloc_timing->total / alloc_timing->count;
+        const uint32_t free_mean = free_timing->total / free_timing->count;
+        FURI_LOG_I(
+            TAG,
+            "%s: malloc mean %lu (%+ld) max %lu, free mean %lu (%+ld) max %lu cycles",
+            mode_names[mode],
+            alloc_mean,
+            (int32_t)(alloc_mean - untraced_alloc_mean),
+            alloc_timing->max,
+            free_mean,
+            (int32_t)(free_mean - untraced_free_mean),
+            free_timing->max);
+    }
+}
+
+#define MEMMGR_REPORT_BLOCK_SIZE 4000
+
+static int32_t memmgr_report_thread(void* context) {
+    FuriSemaphore* allocated = context;
+    void* block = malloc(MEMMGR_REPORT_BLOCK_SIZE);
+
+    furi_semaphore_release(allocated);
+    furi_thread_flags_wait(1, FuriFlagWaitAny, FuriWaitForever);
+
+    free(block);
+    return 0;
+}
+
+void test_furi_memmgr_report(void) {
+    FuriSemaphore* allocated = furi_semaphore_alloc(1, 0);
+    FuriThread* thread =
+        furi_thread_alloc_ex("MemmgrReport", 1024, memmgr_report_thread, allocated);
+    furi_thread_enable_heap_trace(thread);
+    furi_thread_start(thread);
+    mu_assert_int_eq(FuriStatusOk, furi_semaphore_acquire(allocated, FuriWaitForever));
+
+    MemmgrHeapReport* report = malloc(sizeof(MemmgrHeapReport));
+    memmgr_heap_get_report(report);
+
+    furi_thread_flags_set(furi_thread_get_id(thread), 1);
+    furi_thread_join(thread);
+    furi_thread_free(thread);
+    furi_semaphore_free(allocated);
+
+    mu_assert_int_eq(MEMMGR_HEAP_REPORT_VERSION, report->version);
+    mu_assert(report->fragmentation <= 1000, "fragmentation out of range");
+    mu_assert(report->largest_free_block <= report->free_size, "largest block above free");
+    mu_assert(report->min_free_size <= report->free_size, "minimum above free");
+
+    size_t free_blocks = 0;
+    for(size_t bin = 0; bin < MEMMGR_HEAP_REPORT_BINS; bin++) {
+        free_blocks += report->free_histogram[bin];
+    }
+    mu_assert_int_eq(report->free_blocks, free_blocks);
+
+    // The traced thread holds the block, which falls into the 2048 to 4095 bytes bin
+    bool found = false;
+    for(size_t i = 0; i < report->owner_count; i++) {
+        const MemmgrHeapReportOwner* owner = &report->owners[i];
+        size_t blocks = 0;
+        for(size_t bin = 0; bin < MEMMGR_HEAP_REPORT_BINS; bin++) {
+            blocks += owner->histogram[bin];
+        }
+        mu_assert_int_eq(owner->blocks, blocks);
+
+        if(owner->thread_id == (uint32_t)furi_thread_get_id(thread)) {
+            found = true;
+            mu_assert(owner->size >= MEMMGR_REPORT_BLOCK_SIZE, "owner size too small");
+            mu_assert(owner->histogram[11] > 0, "block missing from owner histogram");
+        }
+    }
+    // Unless more traced threads than the report lists hold more memory
+    if(report->owner_count < MEMMGR_HEAP_REPORT_OWNERS) {
+        mu_assert(found, "traced thread missing from report");
+    }
+
+    free(report);
+}
+
+#define MEMMGR_SLAB_TEST_OBJECT_SIZE  128 // Largest class, the least used one
+#define MEMMGR_SLAB_TEST_PAGE_OBJECTS (MEMMGR_HEAP_SLAB_PAGE_SIZE / MEMMGR_SLAB_TEST_OBJECT_SIZE)
+#define MEMMGR_SLAB_TEST_MAX_OBJECTS  (32 * MEMMGR_SLAB_TEST_PAGE_OBJECTS) // Largest arena
+#define MEMMGR_SLAB_TEST_NONE         SIZE_MAX
+
+// Class that served an allocation, or fell back to the heap for it
+typedef struct {
+    size_t served;
+    size_t fallback;
+} MemmgrSlabTestClass;
+
+static void memmgr_slab_test_get_stats(MemmgrHeapSlabStats* stats) {
+    for(size_t index = 0; index < memmgr_heap_get_slab_count(); index++) {
+        memmgr_heap_get_slab_stats(index, &stats[index]);
+    }
+}
+
+static MemmgrSlabTestClass
+    memmgr_slab_test_compare(const MemmgrHeapSlabStats* before, const MemmgrHeapSlabStats* after) {
+    MemmgrSlabTestClass slab_class = {MEMMGR_SLAB_TEST_NONE, MEMMGR_SLAB_TEST_NONE};
+    for(size_t index = 0; index < memmgr_heap_get_slab_count(); index++) {
+        if(after[index].allocations != before[index].allocations) slab_class.served = index;
+        if(after[index].fallbacks != before[index].fallbacks) slab_class.fallback = index;
+    }
+    return slab_class;
+}
+
+typedef struct {
+    bool served;
+    size_t before;
+    size_t allocated;
+    size_t after;
+} MemmgrSlabTestOwner;
+
+static int32_t memmgr_slab_test_owner_thread(void* context) {
+    MemmgrSlabTestOwner* owner = context;
+    const FuriThreadId thread_id = furi_thread_get_current_id();
+    MemmgrHeapSlabStats before[MEMMGR_HEAP_SLAB_COUNT];
+    MemmgrHeapSlabStats after[MEMMGR_HEAP_SLAB_COUNT];
+
+    furi_kernel_lock();
+    memmgr_slab_test_get_stats(before);
+    owner->before = memmgr_heap_get_thread_memory(thread_id);
+    void* object = malloc(20);
+    owner->allocated = memmgr_heap_get_thread_memory(thread_id);
+    memmgr_slab_test_get_stats(after);
+    free(object);
+    owner->after = memmgr_heap_get_thread_memory(thread_id);
+    furi_kernel_unlock();
+
+    owner->served = memmgr_slab_test_compare(before, after).served == 1;
+    return 0;
+}
+
+/* Size class slabs of HEAP_SLAB builds. The scheduler is suspended while
+ * allocating, so the stats only change by the allocations of the test. */
+void test_furi_memmgr_slab(void) {
+    if(!memmgr_heap_get_slab_count()) {
+        FURI_LOG_I(TAG, "built without slabs");
+        return;
+    }
+
+    MemmgrHeapSlabStats before[MEMMGR_HEAP_SLAB_COUNT];
+    MemmgrHeapSlabStats after[MEMMGR_HEAP_SLAB_COUNT];
+    MemmgrHeapSlabStats freed[MEMMGR_HEAP_SLAB_COUNT];
+
+    // Requests are rounded up to the smallest class that fits
+    static const size_t sizes[] = {1, 16, 17, 32, 33, 64, 65, 128, 129};
+    static const size_t classes[] = {0, 0, 1, 1, 2, 2, 3, 3, MEMMGR_SLAB_TEST_NONE};
+    MemmgrSlabTestClass served[COUNT_OF(sizes)];
+    void* objects[COUNT_OF(sizes)];
+    size_t used[COUNT_OF(sizes)];
+
+    for(size_t i = 0; i < COUNT_OF(sizes); i++) {
+        furi_kernel_lock();
+        memmgr_slab_test_get_stats(before);
+        objects[i] = malloc(sizes[i]);
+        memmgr_slab_test_get_stats(after);
+        furi_kernel_unlock();
+        served[i] = memmgr_slab_test_compare(before, after);
+    }
+
+    // Freeing a slab object through vPortFree returns it to its class
+    for(size_t i = 0; i < COUNT_OF(sizes); i++) {
+        const size_t index = served[i].served;
+        furi_kernel_lock();
+        if(index != MEMMGR_SLAB_TEST_NONE) memmgr_heap_get_slab_stats(index, &before[index]);
+        free(objects[i]);
+        if(index != MEMMGR_SLAB_TEST_NONE) memmgr_heap_get_slab_stats(index, &after[index]);
+        furi_kernel_unlock();
+        used[i] = index != MEMMGR_SLAB_TEST_NONE ? before[index].used - after[index].used : 0;
+    }
+
+    for(size_t i = 0; i < COUNT_OF(sizes); i++) {
+        // Out of pages the class passes the request on to the heap
+        const size_t index = served[i].served != MEMMGR_SLAB_TEST_NONE ? served[i].served :
+                                                                           served[i].fallback;
+        mu_assert_int_eq(classes[i], index);
+        mu_assert_int_eq(served[i].served != MEMMGR_SLAB_TEST_NONE, used[i]);
+    }
+
+    // Objects beyond the free ones of the class take a page, freeing them gives it back
+    void** pointers = malloc(sizeof(void*) * MEMMGR_SLAB_TEST_MAX_OBJECTS);
+    const size_t index = memmgr_heap_get_slab_count() - 1;
+
+    furi_kernel_lock();
+    memmgr_heap_get_slab_stats(index, &before[index]);
+    const size_t free_pages = memmgr_heap_get_slab_free_pages();
+    const size_t count = MIN(
+        (before[index].pages + 1) * MEMMGR_SLAB_TEST_PAGE_OBJECTS - before[index].used,
+        (size_t)MEMMGR_SLAB_TEST_MAX_OBJECTS);
+    for(size_t i = 0; i < count; i++) {
+        pointers[i] = malloc(MEMMGR_SLAB_TEST_OBJECT_SIZE);
+    }
+    const size_t free_pages_taken = memmgr_heap_get_slab_free_pages();
+    memmgr_heap_get_slab_stats(index, &after[index]);
+    for(size_t i = 0; i < count; i++) {
+        free(pointers[i]);
+    }
+    const size_t free_pages_after = memmgr_heap_get_slab_free_pages();
+    memmgr_heap_get_slab_stats(index, &freed[index]);
+    furi_kernel_unlock();
+    free(pointers);
+
+    if(free_pages) {
+        mu_assert_int_eq(free_pages - 1, free_pages_taken);
+        mu_assert_int_eq(before[index].pages + 1, after[index].pages);
+    }
+    mu_assert_int_eq(free_pages, free_pages_after);
+    mu_assert_int_eq(before[index].pages, freed[index].pages);
+    mu_assert_int_eq(before[index].used, freed[index].used);
+
+    // Slab objects count towards the traced thread that allocated them
+    MemmgrSlabTestOwner owner = {0};
+    FuriThread* thread =
+        furi_thread_alloc_ex("MemmgrSlabOwner", 1024, memmgr_slab_test_owner_thread, &owner);
+    furi_thread_enable_heap_trace(thread);
+    furi_thread_start(thread);
+    furi_thread_join(thread);
+    furi_thread_free(thread);
+
+    if(owner.served) {
+        mu_assert_int_eq(owner.before + 32, owner.allocated);
+    }
+    mu_assert_int_eq(owner.before, owner.after);
+}
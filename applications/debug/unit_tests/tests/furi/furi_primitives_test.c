@@ -1,14 +1,19 @@
 #include <furi.h>
+#include <core/message_pool.h>
 #include "../test.h" // IWYU pragma: keep
 
 #define MESSAGE_QUEUE_CAPACITY     (16U)
 #define MESSAGE_QUEUE_ELEMENT_SIZE (sizeof(uint32_t))
 
+#define MESSAGE_POOL_CAPACITY     (8U)
+#define MESSAGE_POOL_ELEMENT_SIZE (13U)
+
 #define STREAM_BUFFER_SIZE      (32U)
 #define STREAM_BUFFER_TRG_LEVEL (STREAM_BUFFER_SIZE / 2U)
 
 typedef struct {
     FuriMessageQueue* message_queue;
+    FuriMessagePool* message_pool;
     FuriStreamBuffer* stream_buffer;
 } TestFuriPrimitivesData;
 
@@ -49,6 +54,56 @@ static void test_furi_message_queue(TestFuriPrimitivesData* data) {
     mu_assert_int_eq(MESSAGE_QUEUE_CAPACITY, furi_message_queue_get_space(message_queue));
 }
 
+static void test_furi_message_pool(TestFuriPrimitivesData* data) {
+    FuriMessagePool* message_pool = data->message_pool;
+    void* slots[MESSAGE_POOL_CAPACITY];
+
+    mu_assert_int_eq(0, furi_message_pool_get_count(message_pool));
+    mu_assert_int_eq(MESSAGE_POOL_CAPACITY, furi_message_pool_get_space(message_pool));
+    mu_assert_int_eq(MESSAGE_POOL_CAPACITY, furi_message_pool_get_capacity(message_pool));
+    mu_assert_int_eq(MESSAGE_POOL_ELEMENT_SIZE, furi_message_pool_get_message_size(message_pool));
+
+    for(uint32_t i = 0;; ++i) {
+        mu_assert_int_eq(MESSAGE_POOL_CAPACITY - i, furi_message_pool_get_space(message_pool));
+        mu_assert_int_eq(i, furi_message_pool_get_count(message_pool));
+
+        void* slot;
+        if(furi_message_pool_acquire(message_pool, &slot, 0) != FuriStatusOk) {
+            break;
+        }
+
+        mu_assert_int_eq(0, (uint32_t)slot % sizeof(uint32_t));
+        for(uint32_t j = 0; j < i; ++j) {
+            mu_assert(slot != slots[j], "Slot acquired twice");
+        }
+
+        slots[i] = slot;
+        memset(slot, i, MESSAGE_POOL_ELEMENT_SIZE);
+        furi_message_pool_put(message_pool, slot);
+    }
+
+    mu_assert_int_eq(0, furi_message_pool_get_space(message_pool));
+    mu_assert_int_eq(MESSAGE_POOL_CAPACITY, furi_message_pool_get_count(message_pool));
+
+    for(uint32_t i = 0;; ++i) {
+        mu_assert_int_eq(i, furi_message_pool_get_space(message_pool));
+        mu_assert_int_eq(MESSAGE_POOL_CAPACITY - i, furi_message_pool_get_count(message_pool));
+
+        uint8_t* slot;
+        if(furi_message_pool_get(message_pool, (void**)&slot, 0) != FuriStatusOk) {
+            break;
+        }
+
+        // Same memory in the same order, nothing copied
+        mu_assert(slot == slots[i], "Slot passed out of order");
+        mu_assert_int_eq(i, slot[MESSAGE_POOL_ELEMENT_SIZE - 1]);
+        furi_message_pool_release(message_pool, slot);
+    }
+
+    mu_assert_int_eq(0, furi_message_pool_get_count(message_pool));
+    mu_assert_int_eq(MESSAGE_POOL_CAPACITY, furi_message_pool_get_space(message_pool));
+}
+
 static void test_furi_stream_buffer(TestFuriPrimitivesData* data) {
     FuriStreamBuffer* stream_buffer = data->stream_buffer;
 
@@ -92,12 +147,15 @@ void test_furi_primitives(void) {
     TestFuriPrimitivesData data = {
         .message_queue =
             furi_message_queue_alloc(MESSAGE_QUEUE_CAPACITY, MESSAGE_QUEUE_ELEMENT_SIZE),
+        .message_pool = furi_message_pool_alloc(MESSAGE_POOL_CAPACITY, MESSAGE_POOL_ELEMENT_SIZE),
         .stream_buffer = furi_stream_buffer_alloc(STREAM_BUFFER_SIZE, STREAM_BUFFER_TRG_LEVEL),
     };
 
     test_furi_message_queue(&data);
+    test_furi_message_pool(&data);
     test_furi_stream_buffer(&data);
 
     furi_message_queue_free(data.message_queue);
+    furi_message_pool_free(data.message_pool);
     furi_stream_buffer_free(data.stream_buffer);
 }
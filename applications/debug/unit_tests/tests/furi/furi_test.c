@@ -7,8 +7,15 @@ void test_furi_create_open(void);
 void test_furi_concurrent_access(void);
 void test_furi_pubsub(void);
 void test_furi_memmgr(void);
+void test_furi_memmgr_replay(void);
+void test_furi_memmgr_trace_bench(void);
+void test_furi_memmgr_report(void);
+void test_furi_memmgr_slab(void);
 void test_furi_event_loop(void);
 void test_furi_event_loop_self_unsubscribe(void);
+void test_furi_event_loop_timer_bench(void);
+void test_furi_event_loop_pending(void);
+void test_furi_event_loop_message_pool(void);
 void test_errno_saving(void);
 void test_furi_primitives(void);
 void test_stdin(void);
@@ -43,6 +50,24 @@ MU_TEST(mu_test_furi_memmgr) {
     test_furi_memmgr();
 }
 
+MU_TEST(mu_test_furi_memmgr_replay) {
+    // timings and fragmentation go to the log, compare them between heap builds
+    test_furi_memmgr_replay();
+}
+
+MU_TEST(mu_test_furi_memmgr_trace_bench) {
+    // overhead of per-thread heap accounting goes to the log
+    test_furi_memmgr_trace_bench();
+}
+
+MU_TEST(mu_test_furi_memmgr_report) {
+    test_furi_memmgr_report();
+}
+
+MU_TEST(mu_test_furi_memmgr_slab) {
+    test_furi_memmgr_slab();
+}
+
 MU_TEST(mu_test_furi_event_loop) {
     test_furi_event_loop();
 }
@@ -51,6 +76,19 @@ MU_TEST(mu_test_furi_event_loop_self_unsubscribe) {
     test_furi_event_loop_self_unsubscribe();
 }
 
+MU_TEST(mu_test_furi_event_loop_timer_bench) {
+    // timings go to the log
+    test_furi_event_loop_timer_bench();
+}
+
+MU_TEST(mu_test_furi_event_loop_pending) {
+    test_furi_event_loop_pending();
+}
+
+MU_TEST(mu_test_furi_event_loop_message_pool) {
+    test_furi_event_loop_message_pool();
+}
+
 MU_TEST(mu_test_errno_saving) {
     test_errno_saving();
 }
@@ -72,8 +110,15 @@ MU_TEST_SUITE(test_suite) {
     MU_RUN_TEST(mu_test_furi_create_open);
     MU_RUN_TEST(mu_test_furi_pubsub);
     MU_RUN_TEST(mu_test_furi_memmgr);
+    MU_RUN_TEST(mu_test_furi_memmgr_replay);
+    MU_RUN_TEST(mu_test_furi_memmgr_trace_bench);
+    MU_RUN_TEST(mu_test_furi_memmgr_report);
+    MU_RUN_TEST(mu_test_furi_memmgr_slab);
     MU_RUN_TEST(mu_test_furi_event_loop);
     MU_RUN_TEST(mu_test_furi_event_loop_self_unsubscribe);
+    MU_RUN_TEST(mu_test_furi_event_loop_timer_bench);
+    MU_RUN_TEST(mu_test_furi_event_loop_pending);
+    MU_RUN_TEST(mu_test_furi_event_loop_message_pool);
     MU_RUN_TEST(mu_test_stdio);
     MU_RUN_TEST(mu_test_errno_saving);
     MU_RUN_TEST(mu_test_furi_primitives);
@@ -0,0 +1,225 @@
+#include "../test.h" // IWYU pragma: keep
+
+#include <furi.h>
+#include <storage/storage.h>
+#include <furi/containerization/pod_manifest.h>
+
+#define UNIT_TESTS_RESOURCES_PATH(path) EXT_PATH("unit_tests/pod_manifest/" path)
+#define UNIT_TESTS_PATH(path)           EXT_PATH(".tmp/unit_tests/" path)
+
+#define POD_MANIFEST_TEST_FILE UNIT_TESTS_PATH("pod_manifest.json")
+
+// Fits the largest container object of the example manifests
+#define POD_MANIFEST_TEST_BUFFER_SIZE 320
+
+// Reader chunk size, padding shifts the manifest across every chunk boundary
+#define POD_MANIFEST_TEST_CHUNK_SIZE 64
+
+// Escapes in reader and json_scanf strings, skipped members with brackets in
+// strings, pod restartPolicy after the containers it applies to
+static const char* const pod_manifest_test_json =
+    "{\"apiVersion\": \"v1\", \"kind\": \"Pod\",\n"
+    " \"metadata\": {\"name\": \"esc\\\"pod\\\\1\", \"namespace\": \"t\\u0041\",\n"
+    "  \"annotations\": {\"note\": \"}] \\\" [{\"}},\n"
+    " \"spec\": {\"containers\": [\n"
+    "  {\"name\": \"a\", \"image\": \"apps/a\", \"args\": \"say \\\"hi\\\"\\n\\tnow\",\n"
+    "   \"restartPolicy\": \"Never\"},\n"
+    "  {\"name\": \"b\", \"image\": \"apps/b\", \"restartOnCrash\": true,\n"
+    "   \"resources\": {\"limits\": {\"memory\": \"2Ki\", \"cpu\": 5, \"threads\": 1}}},\n"
+    "  {\"name\": \"c\", \"image\": \"apps/c\", \"env\": [{\"name\": \"]\"}]}],\n"
+    "  \"restartPolicy\": \"OnFailure\"}}\n";
+
+static void pod_manifest_test_write(const char* path, const char* data, size_t padding) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+
+    furi_check(storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS));
+    for(size_t i = 0; i < padding; i++) {
+        furi_check(storage_file_write(file, " ", 1) == 1);
+    }
+    const size_t size = strlen(data);
+    furi_check(storage_file_write(file, data, size) == size);
+
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+}
+
+static char* pod_manifest_test_read(const char* path) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+
+    furi_check(storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING));
+    const size_t size = storage_file_size(file);
+    char* data = malloc(size + 1);
+    furi_check(storage_file_read(file, data, size) == size);
+    data[size] = '\0';
+
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return data;
+}
+
+static PodManifest* pod_manifest_test_load(const char* path, size_t buffer_size) {
+    char* buffer = malloc(buffer_size);
+    PodManifest* manifest = pod_manifest_load_from_file_buffered(path, buffer, buffer_size);
+    free(buffer);
+
+    return manifest;
+}
+
+// Expected contents of the test-pod.json example
+static void pod_manifest_test_check_test_pod(const PodManifest* manifest) {
+    mu_assert(manifest, "test-pod not loaded");
+    mu_assert_string_eq("test-pod", pod_manifest_get_name(manifest));
+    mu_assert_string_eq("default", pod_manifest_get_namespace(manifest));
+
+    const PodContainerSpec* containers;
+    mu_assert_int_eq(2, pod_manifest_get_containers(manifest, &containers));
+
+    mu_assert_string_eq("main", containers[0].name);
+    mu_assert_string_eq("apps/test_app", containers[0].image);
+    mu_assert_string_eq("hello from manifest", containers[0].args);
+    mu_assert_int_eq(4 * 1024, containers[0].resources.max_memory);
+    mu_assert_int_eq(10, containers[0].resources.cpu_time_share);
+    mu_assert_int_eq(false, containers[0].system_privileges);
+    mu_assert_int_eq(ContainerRestartPolicyOnFailure, containers[0].restart_policy);
+
+    mu_assert_string_eq("logger", containers[1].name);
+    mu_assert_string_eq("apps/logger_app", containers[1].image);
+    mu_assert(containers[1].args == NULL, "logger has no args");
+    mu_assert_int_eq(2 * 1024, containers[1].resources.max_memory);
+    mu_assert_int_eq(5, containers[1].resources.cpu_time_share);
+    mu_assert_int_eq(ContainerRestartPolicyOnFailure, containers[1].restart_policy);
+}
+
+// Expected contents of the minimal-pod.json example
+static void pod_manifest_test_check_minimal_pod(const PodManifest* manifest) {
+    mu_assert(manifest, "minimal-pod not loaded");
+    mu_assert_string_eq("minimal-pod", pod_manifest_get_name(manifest));
+
+    const PodContainerSpec* containers;
+    mu_assert_int_eq(1, pod_manifest_get_containers(manifest, &containers));
+    mu_assert_string_eq("main", containers[0].name);
+    mu_assert_string_eq("flipper/minimal:latest", containers[0].image);
+    mu_assert_int_eq(4 * 1024, containers[0].resources.max_memory);
+    mu_assert_int_eq(ContainerRestartPolicyOnFailure, containers[0].restart_policy);
+}
+
+static void pod_manifest_test_check_escapes(const PodManifest* manifest) {
+    mu_assert(manifest, "manifest not loaded");
+    mu_assert_string_eq("esc\"pod\\1", pod_manifest_get_name(manifest));
+    mu_assert_string_eq("tA", pod_manifest_get_namespace(manifest));
+
+    const PodContainerSpec* containers;
+    mu_assert_int_eq(3, pod_manifest_get_containers(manifest, &containers));
+
+    mu_assert_string_eq("a", containers[0].name);
+    mu_assert_string_eq("say \"hi\"\n\tnow", containers[0].args);
+    mu_assert_int_eq(ContainerRestartPolicyNever, containers[0].restart_policy);
+
+    mu_assert_string_eq("b", containers[1].name);
+    mu_assert_int_eq(2 * 1024, containers[1].resources.max_memory);
+    mu_assert_int_eq(5, containers[1].resources.cpu_time_share);
+    mu_assert_int_eq(1, containers[1].resources.max_threads);
+    mu_assert_int_eq(ContainerRestartPolicyAlways, containers[1].restart_policy);
+
+    // Defaults, and the pod restartPolicy read after the container
+    mu_assert_string_eq("apps/c", containers[2].image);
+    mu_assert_int_eq(32 * 1024, containers[2].resources.max_memory);
+    mu_assert_int_eq(ContainerRestartPolicyOnFailure, containers[2].restart_policy);
+}
+
+MU_TEST(pod_manifest_test_examples) {
+    const char* const paths[] = {
+        UNIT_TESTS_RESOURCES_PATH("test-pod.json"),
+        UNIT_TESTS_RESOURCES_PATH("minimal-pod.json"),
+    };
+    void (*const checks[])(const PodManifest*) = {
+        pod_manifest_test_check_test_pod,
+        pod_manifest_test_check_minimal_pod,
+    };
+
+    for(size_t i = 0; i < COUNT_OF(paths); i++) {
+        char* data = pod_manifest_test_read(paths[i]);
+        PodManifest* manifest = pod_manifest_create_from_json(data);
+        checks[i](manifest);
+        if(manifest) pod_manifest_free(manifest);
+        free(data);
+
+        manifest = pod_manifest_test_load(paths[i], POD_MANIFEST_TEST_BUFFER_SIZE);
+        checks[i](manifest);
+        if(manifest) pod_manifest_free(manifest);
+
+        // Format is detected from the contents
+        manifest = pod_manifest_load_from_file(paths[i]);
+        checks[i](manifest);
+        if(manifest) pod_manifest_free(manifest);
+    }
+}
+
+MU_TEST(pod_manifest_test_escapes) {
+    PodManifest* manifest = pod_manifest_create_from_json(pod_manifest_test_json);
+    pod_manifest_test_check_escapes(manifest);
+    if(manifest) pod_manifest_free(manifest);
+}
+
+MU_TEST(pod_manifest_test_chunk_boundaries) {
+    for(size_t padding = 0; padding <= POD_MANIFEST_TEST_CHUNK_SIZE; padding++) {
+        pod_manifest_test_write(POD_MANIFEST_TEST_FILE, pod_manifest_test_json, padding);
+        PodManifest* manifest =
+            pod_manifest_test_load(POD_MANIFEST_TEST_FILE, POD_MANIFEST_TEST_BUFFER_SIZE);
+        pod_manifest_test_check_escapes(manifest);
+        if(manifest) pod_manifest_free(manifest);
+    }
+}
+
+MU_TEST(pod_manifest_test_overflow) {
+    pod_manifest_test_write(POD_MANIFEST_TEST_FILE, pod_manifest_test_json, 0);
+
+    // Container "b" is the largest object
+    mu_assert(!pod_manifest_test_load(POD_MANIFEST_TEST_FILE, 64), "value overflowed buffer");
+
+    PodManifest* manifest = pod_manifest_test_load(POD_MANIFEST_TEST_FILE, 128);
+    pod_manifest_test_check_escapes(manifest);
+    if(manifest) pod_manifest_free(manifest);
+}
+
+MU_TEST(pod_manifest_test_invalid) {
+    const char* const manifests[] = {
+        "",
+        "{\"kind\": \"Pod\", \"metadata\": {\"name\": \"x\"}",
+        "{\"kind\": \"Pod\", \"metadata\": {\"name\": \"x\"}, \"spec\": {\"containers\": [",
+        "{\"kind\": \"Pod\", \"metadata\": {\"name\": \"x\"}, \"spec\": {\"containers\": []}}",
+        "{\"kind\": \"Deployment\", \"metadata\": {\"name\": \"x\"},"
+        " \"spec\": {\"containers\": [{\"name\": \"a\", \"image\": \"apps/a\"}]}}",
+        "{\"metadata\": {\"name\": \"x\"},"
+        " \"spec\": {\"containers\": [{\"name\": \"a\"}]}}",
+        "{\"metadata\": {\"name\": \"x\\q\"},"
+        " \"spec\": {\"containers\": [{\"name\": \"a\", \"image\": \"apps/a\"}]}}",
+    };
+
+    for(size_t i = 0; i < COUNT_OF(manifests); i++) {
+        PodManifest* manifest = pod_manifest_create_from_json(manifests[i]);
+        mu_assert(!manifest, "invalid manifest loaded");
+    }
+}
+
+MU_TEST_SUITE(test_pod_manifest) {
+    MU_RUN_TEST(pod_manifest_test_examples);
+    MU_RUN_TEST(pod_manifest_test_escapes);
+    MU_RUN_TEST(pod_manifest_test_chunk_boundaries);
+    MU_RUN_TEST(pod_manifest_test_overflow);
+    MU_RUN_TEST(pod_manifest_test_invalid);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove(storage, POD_MANIFEST_TEST_FILE);
+    furi_record_close(RECORD_STORAGE);
+}
+
+int run_minunit_test_pod_manifest(void) {
+    MU_RUN_SUITE(test_pod_manifest);
+    return MU_EXIT_CODE;
+}
+
+TEST_API_DEFINE(run_minunit_test_pod_manifest)
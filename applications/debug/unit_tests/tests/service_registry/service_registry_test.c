@@ -0,0 +1,202 @@
+#include "../test.h" // IWYU pragma: keep
+
+#include <furi.h>
+#include <furi/containerization/service_registry.h>
+
+#define TEST_NAMESPACE "test"
+
+// In TEST_NAMESPACE these share the home bucket of the last table slot, so their chain wraps
+static const char* const colliding_names[] = {"svc31", "svc80", "svc114"};
+// Home bucket is the first slot, right where the wrapped chain continues
+#define TEST_DISPLACED_NAME "svc34"
+
+static ServiceEndpoint*
+    service_registry_test_register(ServiceRegistry* registry, const char* name) {
+    const ServiceDescriptor descriptor = {
+        .name = name,
+        .namespace = TEST_NAMESPACE,
+        .type = ServiceTypeSystem,
+        .protocol = "rpc",
+        .name_persistent = true,
+        .namespace_persistent = true,
+        .protocol_persistent = true,
+    };
+
+    return service_registry_register(registry, &descriptor);
+}
+
+// Endpoint identity only, the reference is released right away
+static ServiceEndpoint*
+    service_registry_test_find(ServiceRegistry* registry, const char* name, const char* namespace) {
+    ServiceEndpoint* endpoint = service_registry_lookup(registry, name, namespace);
+    if(endpoint) service_endpoint_release(endpoint);
+    return endpoint;
+}
+
+MU_TEST(service_registry_test_lookup) {
+    ServiceRegistry* registry = service_registry_alloc();
+
+    const ServiceDescriptor descriptor = {
+        .name = "storage",
+        .type = ServiceTypeInternal,
+    };
+    ServiceEndpoint* endpoint = service_registry_register(registry, &descriptor);
+    mu_assert(endpoint, "register failed");
+    mu_assert(!service_registry_register(registry, &descriptor), "duplicate registered");
+
+    // Namespace defaults to "default" on both sides
+    mu_assert(service_registry_test_find(registry, "storage", NULL) == endpoint, "lookup failed");
+    mu_assert(
+        service_registry_test_find(registry, "storage", "default") == endpoint, "lookup failed");
+    mu_assert(!service_registry_test_find(registry, "storage", TEST_NAMESPACE), "wrong namespace");
+    mu_assert_string_eq("default", service_endpoint_get_descriptor(endpoint)->namespace);
+
+    service_registry_unregister(registry, endpoint);
+    mu_assert(!service_registry_test_find(registry, "storage", NULL), "unregistered found");
+
+    service_registry_free(registry);
+}
+
+MU_TEST(service_registry_test_collisions) {
+    ServiceRegistry* registry = service_registry_alloc();
+    ServiceEndpoint* endpoints[COUNT_OF(colliding_names)];
+
+    for(size_t i = 0; i < COUNT_OF(colliding_names); i++) {
+        endpoints[i] = service_registry_test_register(registry, colliding_names[i]);
+        mu_assert(endpoints[i], "register failed");
+    }
+    ServiceEndpoint* displaced = service_registry_test_register(registry, TEST_DISPLACED_NAME);
+    mu_assert(displaced, "register failed");
+
+    for(size_t i = 0; i < COUNT_OF(colliding_names); i++) {
+        ServiceEndpoint* found =
+            service_registry_test_find(registry, colliding_names[i], TEST_NAMESPACE);
+        mu_assert(found == endpoints[i], "lookup in chain failed");
+    }
+
+    // Remove from the middle of the chain: its tail and the displaced entry shift back
+    service_registry_unregister(registry, endpoints[1]);
+    mu_assert(
+        !service_registry_test_find(registry, colliding_names[1], TEST_NAMESPACE),
+        "unregistered found");
+    mu_assert(
+        service_registry_test_find(registry, colliding_names[0], TEST_NAMESPACE) == endpoints[0],
+        "chain head lost");
+    mu_assert(
+        service_registry_test_find(registry, colliding_names[2], TEST_NAMESPACE) == endpoints[2],
+        "chain tail lost");
+    mu_assert(
+        service_registry_test_find(registry, TEST_DISPLACED_NAME, TEST_NAMESPACE) == displaced,
+        "displaced entry lost");
+
+    // Reinsert at the end of the chain, then remove the head
+    endpoints[1] = service_registry_test_register(registry, colliding_names[1]);
+    mu_assert(endpoints[1], "register failed");
+    service_registry_unregister(registry, endpoints[0]);
+    mu_assert(
+        !service_registry_test_find(registry, colliding_names[0], TEST_NAMESPACE),
+        "unregistered found");
+
+    for(size_t i = 1; i < COUNT_OF(colliding_names); i++) {
+        ServiceEndpoint* found =
+            service_registry_test_find(registry, colliding_names[i], TEST_NAMESPACE);
+        mu_assert(found == endpoints[i], "lookup after head removal failed");
+    }
+    mu_assert(
+        service_registry_test_find(registry, TEST_DISPLACED_NAME, TEST_NAMESPACE) == displaced,
+        "displaced entry lost");
+
+    for(size_t i = 1; i < COUNT_OF(colliding_names); i++) {
+        service_registry_unregister(registry, endpoints[i]);
+    }
+    service_registry_unregister(registry, displaced);
+    mu_assert(
+        !service_registry_test_find(registry, TEST_DISPLACED_NAME, TEST_NAMESPACE),
+        "unregistered found");
+
+    service_registry_free(registry);
+}
+
+MU_TEST(service_registry_test_full) {
+    ServiceRegistry* registry = service_registry_alloc();
+    ServiceEndpoint* endpoints[16];
+    char name[8];
+
+    // Fill up, every name is interned
+    for(size_t i = 0; i < COUNT_OF(endpoints); i++) {
+        snprintf(name, sizeof(name), "svc%u", (unsigned)i);
+        const ServiceDescriptor descriptor = {
+            .name = name,
+            .namespace = TEST_NAMESPACE,
+            .type = ServiceTypeSystem,
+        };
+        endpoints[i] = service_registry_register(registry, &descriptor);
+        mu_assert(endpoints[i], "register failed");
+    }
+    mu_assert(!service_registry_test_register(registry, "overflow"), "registry overflow");
+
+    for(size_t i = 0; i < COUNT_OF(endpoints); i++) {
+        snprintf(name, sizeof(name), "svc%u", (unsigned)i);
+        mu_assert(
+            service_registry_test_find(registry, name, TEST_NAMESPACE) == endpoints[i],
+            "lookup in full registry failed");
+    }
+
+    // Every other slot is freed and reused
+    for(size_t i = 0; i < COUNT_OF(endpoints); i += 2) {
+        service_registry_unregister(registry, endpoints[i]);
+    }
+    for(size_t i = 1; i < COUNT_OF(endpoints); i += 2) {
+        snprintf(name, sizeof(name), "svc%u", (unsigned)i);
+        mu_assert(
+            service_registry_test_find(registry, name, TEST_NAMESPACE) == endpoints[i],
+            "lookup after removal failed");
+    }
+    mu_assert(service_registry_test_register(registry, "overflow"), "freed slot not reused");
+
+    service_registry_free(registry);
+}
+
+MU_TEST(service_registry_test_held_endpoint) {
+    ServiceRegistry* registry = service_registry_alloc();
+
+    ServiceEndpoint* endpoint = service_registry_test_register(registry, colliding_names[0]);
+    mu_assert(endpoint, "register failed");
+    ServiceEndpoint* held = service_registry_lookup(registry, colliding_names[0], TEST_NAMESPACE);
+    mu_assert(held == endpoint, "lookup failed");
+
+    // Gone from the table, but the held endpoint stays valid and keeps its slot
+    service_registry_unregister(registry, endpoint);
+    mu_assert(
+        !service_registry_test_find(registry, colliding_names[0], TEST_NAMESPACE),
+        "unregistered found");
+    mu_assert_string_eq(colliding_names[0], service_endpoint_get_descriptor(held)->name);
+    mu_assert(!service_endpoint_connect(held), "connected to unregistered service");
+    mu_assert(!service_endpoint_probe(held, ""), "probed unregistered service");
+
+    ServiceEndpoint* endpoint_new = service_registry_test_register(registry, colliding_names[0]);
+    mu_assert(endpoint_new && endpoint_new != held, "held slot reused");
+
+    // Last reference frees the slot
+    service_endpoint_release(held);
+    service_registry_unregister(registry, endpoint_new);
+    mu_assert(
+        service_registry_test_register(registry, colliding_names[1]) == held,
+        "released slot not reused");
+
+    service_registry_free(registry);
+}
+
+MU_TEST_SUITE(test_service_registry) {
+    MU_RUN_TEST(service_registry_test_lookup);
+    MU_RUN_TEST(service_registry_test_collisions);
+    MU_RUN_TEST(service_registry_test_full);
+    MU_RUN_TEST(service_registry_test_held_endpoint);
+}
+
+int run_minunit_test_service_registry(void) {
+    MU_RUN_SUITE(test_service_registry);
+    return MU_EXIT_CODE;
+}
+
+TEST_API_DEFINE(run_minunit_test_service_registry)
@@ -738,9 +738,93 @@ MU_TEST(test_md5_calc) {
     furi_record_close(RECORD_STORAGE);
 }
 
+#define STORAGE_MOUNT_TEST_OWNER_TAG 0x4d4e54
+#define STORAGE_MOUNT_TEST_PODS      UNIT_TESTS_PATH("pods")
+#define STORAGE_MOUNT_TEST_POD       STORAGE_MOUNT_TEST_PODS "/unit_test_pod"
+#define STORAGE_MOUNT_TEST_DATA      STORAGE_MOUNT_TEST_POD "/data"
+#define STORAGE_MOUNT_TEST_CONFIG    STORAGE_MOUNT_TEST_POD "/config"
+
+typedef struct {
+    bool data_created;
+    FuriString* data_resolved;
+    bool config_read;
+    bool config_written;
+    FS_Error config_write_error;
+    FS_Error config_remove_error;
+    FS_Error config_mkdir_error;
+} StorageMountTestResult;
+
+// Runs with the owner tag, so every path below goes through its mounts
+static int32_t storage_mount_test_owner(void* context) {
+    StorageMountTestResult* result = context;
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    result->data_created = storage_file_create(storage, "/data/x", "data");
+    furi_string_set(result->data_resolved, "/data/x");
+    storage_common_resolve_path_and_ensure_app_directory(storage, result->data_resolved);
+
+    File* file = storage_file_alloc(storage);
+    result->config_read = storage_file_open(file, "/config/x", FSAM_READ, FSOM_OPEN_EXISTING);
+    storage_file_close(file);
+    result->config_written = storage_file_open(file, "/config/x", FSAM_WRITE, FSOM_OPEN_ALWAYS);
+    result->config_write_error = storage_file_get_error(file);
+    storage_file_free(file);
+
+    result->config_remove_error = storage_common_remove(storage, "/config/x");
+    result->config_mkdir_error = storage_common_mkdir(storage, "/config/dir");
+
+    furi_record_close(RECORD_STORAGE);
+    return 0;
+}
+
+MU_TEST(test_storage_mounts) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_remove_recursive(storage, STORAGE_MOUNT_TEST_PODS);
+    mu_check(storage_simply_mkdir(storage, STORAGE_MOUNT_TEST_PODS));
+    mu_check(storage_simply_mkdir(storage, STORAGE_MOUNT_TEST_POD));
+    mu_check(storage_simply_mkdir(storage, STORAGE_MOUNT_TEST_DATA));
+    mu_check(storage_simply_mkdir(storage, STORAGE_MOUNT_TEST_CONFIG));
+    mu_check(storage_file_create(storage, STORAGE_MOUNT_TEST_CONFIG "/x", "config"));
+
+    const StorageMount mounts[] = {
+        {.path = "/data", .target = STORAGE_MOUNT_TEST_DATA},
+        {.path = "/config", .target = STORAGE_MOUNT_TEST_CONFIG, .read_only = true},
+    };
+    mu_check(storage_mounts_set(storage, STORAGE_MOUNT_TEST_OWNER_TAG, mounts, COUNT_OF(mounts)));
+
+    StorageMountTestResult result = {.data_resolved = furi_string_alloc()};
+    FuriThread* thread =
+        furi_thread_alloc_ex("StorageMountOwner", 2048, storage_mount_test_owner, &result);
+    furi_thread_set_owner_tag(thread, STORAGE_MOUNT_TEST_OWNER_TAG);
+    furi_thread_start(thread);
+    furi_thread_join(thread);
+    furi_thread_free(thread);
+
+    storage_mounts_remove(storage, STORAGE_MOUNT_TEST_OWNER_TAG);
+
+    // Writable mount: the first component is replaced by the target
+    mu_check(result.data_created);
+    mu_assert_string_eq(STORAGE_MOUNT_TEST_DATA "/x", furi_string_get_cstr(result.data_resolved));
+    mu_check(storage_file_exists(storage, STORAGE_MOUNT_TEST_DATA "/x"));
+
+    // Read-only mount: reading works, every modification is denied
+    mu_check(result.config_read);
+    mu_check(!result.config_written);
+    mu_assert_int_eq(FSE_DENIED, result.config_write_error);
+    mu_assert_int_eq(FSE_DENIED, result.config_remove_error);
+    mu_assert_int_eq(FSE_DENIED, result.config_mkdir_error);
+    mu_check(storage_file_exists(storage, STORAGE_MOUNT_TEST_CONFIG "/x"));
+    mu_check(!storage_dir_exists(storage, STORAGE_MOUNT_TEST_CONFIG "/dir"));
+
+    furi_string_free(result.data_resolved);
+    storage_simply_remove_recursive(storage, STORAGE_MOUNT_TEST_PODS);
+    furi_record_close(RECORD_STORAGE);
+}
+
 MU_TEST_SUITE(test_data_path) {
     MU_RUN_TEST(test_storage_data_path);
     MU_RUN_TEST(test_storage_data_path_apps);
+    MU_RUN_TEST(test_storage_mounts);
 }
 
 MU_TEST_SUITE(test_storage_common) {
@@ -8,6 +8,8 @@
 #include <rpc/rpc_i.h>
 #include <flipper.pb.h>
 #include <applications/system/js_app/js_thread.h>
+#include <furi/containerization/containerization.h>
+#include <furi/containerization/container_runtime_i.h>
 
 static constexpr auto unit_tests_api_table = sort(create_array_t<sym_entry>(
     API_METHOD(resource_manifest_reader_alloc, ResourceManifestReader*, (Storage*)),
@@ -38,4 +40,29 @@ static constexpr auto unit_tests_api_table = sort(create_array_t<sym_entry>(
         JsThread*,
         (const char* script_path, JsThreadCallback callback, void* context)),
     API_METHOD(js_thread_stop, void, (JsThread * worker)),
+    API_METHOD(pod_manifest_load_from_file, PodManifest*, (const char*)),
+    API_METHOD(pod_manifest_load_from_file_buffered, PodManifest*, (const char*, char*, size_t)),
+    API_METHOD(pod_manifest_create_from_json, PodManifest*, (const char*)),
+    API_METHOD(pod_manifest_free, void, (PodManifest*)),
+    API_METHOD(pod_manifest_get_name, const char*, (const PodManifest*)),
+    API_METHOD(pod_manifest_get_namespace, const char*, (const PodManifest*)),
+    API_METHOD(
+        pod_manifest_get_containers,
+        uint32_t,
+        (const PodManifest*, const PodContainerSpec**)),
+    API_METHOD(furi_get_container_runtime, ContainerRuntime*, ()),
+    API_METHOD(container_create, Container*, (ContainerRuntime*, const ContainerConfig*)),
+    API_METHOD(container_delete, bool, (Container*)),
+    API_METHOD(container_get_id, ContainerId, (const Container*)),
+    API_METHOD(container_runtime_get, Container*, (ContainerRuntime*, ContainerId)),
+    API_METHOD(container_runtime_find, Container*, (ContainerRuntime*, const char*)),
+    API_METHOD(container_start, bool, (Container*)),
+    API_METHOD(container_get_status, void, (Container*, ContainerStatus*)),
+    API_METHOD(container_runtime_get_trace, ContainerTrace*, (ContainerRuntime*)),
+    API_METHOD(
+        container_trace_read,
+        size_t,
+        (ContainerTrace*, uint32_t*, ContainerTraceEvent*, size_t)),
+    API_METHOD(container_restart_backoff_next, uint32_t, (uint32_t, uint32_t)),
+    API_METHOD(container_restart_delay, uint32_t, (uint32_t, uint32_t)),
     API_VARIABLE(PB_Main_msg, PB_Main_msg_t)));
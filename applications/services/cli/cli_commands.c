@@ -267,14 +267,12 @@ void cli_command_sysctl_heap_track(Cli* cli, FuriString* args, void* context) {
     } else if(!furi_string_cmp(args, "main")) {
         furi_hal_rtc_set_heap_track_mode(FuriHalRtcHeapTrackModeMain);
         printf("Heap tracking enabled for application main thread");
-#ifdef FURI_DEBUG
     } else if(!furi_string_cmp(args, "tree")) {
         furi_hal_rtc_set_heap_track_mode(FuriHalRtcHeapTrackModeTree);
         printf("Heap tracking enabled for application main and child threads");
     } else if(!furi_string_cmp(args, "all")) {
         furi_hal_rtc_set_heap_track_mode(FuriHalRtcHeapTrackModeAll);
         printf("Heap tracking enabled for all threads");
-#endif
     } else {
         cli_print_usage("sysctl heap_track", "<none|main|tree|all>", furi_string_get_cstr(args));
     }
@@ -286,11 +284,7 @@ void cli_command_sysctl_print_usage(void) {
     printf("Cmd list:\r\n");
 
     printf("\tdebug <0|1>\t - Enable or disable system debug\r\n");
-#ifdef FURI_DEBUG
     printf("\theap_track <none|main|tree|all>\t - Set heap allocation tracking mode\r\n");
-#else
-    printf("\theap_track <none|main>\t - Set heap allocation tracking mode\r\n");
-#endif
 }
 
 void cli_command_sysctl(Cli* cli, FuriString* args, void* context) {
@@ -477,16 +471,79 @@ void cli_command_free(Cli* cli, FuriString* args, void* context) {
     printf("Minimum heap size: %zu\r\n", memmgr_get_minimum_free_heap());
     printf("Maximum heap block: %zu\r\n", memmgr_heap_get_max_free_block());
 
+    for(size_t i = 0; i < memmgr_heap_get_slab_count(); i++) {
+        MemmgrHeapSlabStats stats;
+        memmgr_heap_get_slab_stats(i, &stats);
+        printf(
+            "Slab %zu: used %zu, peak %zu, pages %zu, heap fallbacks %zu\r\n",
+            stats.object_size,
+            stats.used,
+            stats.peak,
+            stats.pages,
+            stats.fallbacks);
+    }
+    if(memmgr_heap_get_slab_count()) {
+        printf(
+            "Slab free pages: %zu of %d bytes\r\n",
+            memmgr_heap_get_slab_free_pages(),
+            MEMMGR_HEAP_SLAB_PAGE_SIZE);
+    }
+
     printf("Pool free: %zu\r\n", memmgr_pool_get_free());
     printf("Maximum pool block: %zu\r\n", memmgr_pool_get_max_block());
 }
 
+static void cli_command_free_blocks_histogram(const uint16_t* histogram) {
+    for(size_t bin = 0; bin < MEMMGR_HEAP_REPORT_BINS; bin++) {
+        if(histogram[bin]) printf(" %lu:%u", 1UL << bin, histogram[bin]);
+    }
+    printf("\r\n");
+}
+
+static void cli_command_free_blocks_report(void) {
+    MemmgrHeapReport* report = malloc(sizeof(MemmgrHeapReport));
+    memmgr_heap_get_report(report);
+
+    printf(
+        "Free: %lu in %u blocks, largest %lu, minimum %lu\r\n",
+        report->free_size,
+        report->free_blocks,
+        report->largest_free_block,
+        report->min_free_size);
+    printf(
+        "Fragmentation: %u.%u%%\r\n", report->fragmentation / 10, report->fragmentation % 10);
+    printf("Free blocks by size:");
+    cli_command_free_blocks_histogram(report->free_histogram);
+
+    for(size_t i = 0; i < report->owner_count; i++) {
+        const MemmgrHeapReportOwner* owner = &report->owners[i];
+        const char* name = owner->thread_id ?
+                               furi_thread_get_name((FuriThreadId)owner->thread_id) :
+                               "untraced and others";
+        printf(
+            "%s (0x%08lX): %lu in %u blocks\r\n",
+            name ? name : "unnamed",
+            owner->thread_id,
+            owner->size,
+            owner->blocks);
+        printf("  by size:");
+        cli_command_free_blocks_histogram(owner->histogram);
+    }
+
+    free(report);
+}
+
 void cli_command_free_blocks(Cli* cli, FuriString* args, void* context) {
     UNUSED(cli);
-    UNUSED(args);
     UNUSED(context);
 
-    memmgr_heap_printf_free_blocks();
+    if(furi_string_empty(args)) {
+        memmgr_heap_printf_free_blocks();
+    } else if(!furi_string_cmp(args, "--hist")) {
+        cli_command_free_blocks_report();
+    } else {
+        cli_print_usage("free_blocks", "[--hist]", furi_string_get_cstr(args));
+    }
 }
 
 void cli_command_i2c(Cli* cli, FuriString* args, void* context) {
@@ -1,4 +1,5 @@
 #include <furi.h>
+#include <furi_hal.h>
 #include <cli/cli.h>
 #include <furi/core/string.h>
 #include <furi/core/log.h>
@@ -10,36 +11,99 @@
 
 #define TAG "CliContainer"
 
+// Synthetic containers started by kubectl bench
+#define CLI_KUBECTL_BENCH_DEFAULT   64
+#define CLI_KUBECTL_BENCH_MAX       512
+#define CLI_KUBECTL_BENCH_MEMORY    1024
+#define CLI_KUBECTL_BENCH_READY_MS  1000
+#define CLI_KUBECTL_BENCH_PASSES    3 // Scheduler passes sampled while they run
+#define CLI_KUBECTL_BENCH_FLAG_EXIT (1UL << 0)
+
 // Global container runtime for CLI access - lazy initialization
 static ContainerRuntime* container_runtime = NULL;
 
+static const char* cli_container_state_name(ContainerState state) {
+    switch(state) {
+    case ContainerStatePending:
+        return "Pending";
+    case ContainerStateRunning:
+        return "Running";
+    case ContainerStatePaused:
+        return "Paused";
+    case ContainerStateTerminated:
+        return "Terminated";
+    }
+
+    return "Unknown";
+}
+
+static const char* cli_container_priority_class_name(ContainerPriorityClass priority_class) {
+    switch(priority_class) {
+    case ContainerPriorityClassBestEffort:
+        return "BestEffort";
+    case ContainerPriorityClassNormal:
+        return "Normal";
+    case ContainerPriorityClassHigh:
+        return "High";
+    case ContainerPriorityClassSystem:
+        return "System";
+    }
+
+    return "Unknown";
+}
+
+static const char* cli_container_restart_policy_name(ContainerRestartPolicy policy) {
+    switch(policy) {
+    case ContainerRestartPolicyNever:
+        return "Never";
+    case ContainerRestartPolicyOnFailure:
+        return "OnFailure";
+    case ContainerRestartPolicyAlways:
+        return "Always";
+    }
+
+    return "Unknown";
+}
+
+static const char* cli_container_exit_reason_name(ContainerExitReason reason) {
+    switch(reason) {
+    case ContainerExitReasonNone:
+        return "None";
+    case ContainerExitReasonCompleted:
+        return "Completed";
+    case ContainerExitReasonError:
+        return "Error";
+    case ContainerExitReasonUnhealthy:
+        return "Unhealthy";
+    case ContainerExitReasonOOMKilled:
+        return "OOMKilled";
+    case ContainerExitReasonStartFailed:
+        return "StartFailed";
+    case ContainerExitReasonUntraced:
+        return "Untraced";
+    }
+
+    return "Unknown";
+}
+
 static void cli_command_kubectl_help(Cli* cli) {
     UNUSED(cli);
     printf("Kubernetes-inspired Container Management\r\n");
     printf("Usage:\r\n");
     printf("  kubectl start <name> <image> [args] - Start container\r\n");
     printf("  kubectl stop <name> - Stop container\r\n");
+    printf("  kubectl delete <name> - Stop container and remove it\r\n");
+    printf("  kubectl pause <name> [checkpoint] - Pause container, checkpoint frees its RAM\r\n");
+    printf("  kubectl resume <name> - Resume paused container\r\n");
     printf("  kubectl list - List containers\r\n");
+    printf("  kubectl top - Storage I/O per container\r\n");
     printf("  kubectl apply <manifest> - Apply manifest\r\n");
     printf("  kubectl health - Check container runtime health\r\n");
     printf("  kubectl debug <name> - Debug container\r\n");
-}
-
-// Memory-efficient container lookup by name
-static Container* find_container_by_name(ContainerRuntime* runtime, const char* name) {
-    if(!runtime || !name) return NULL;
-    
-    // This implementation assumes container_runtime has containers in an array 
-    // that can be accessed directly. We iterate through all containers to find a match.
-    
-    for(uint8_t i = 0; i < 8; i++) { // Use the constant directly to save memory
-        Container* container = &runtime->containers[i];
-        if(container->config.name != NULL && strcmp(container->config.name, name) == 0) {
-            return container;
-        }
-    }
-    
-    return NULL;
+    printf("  kubectl throttle <off|priority> - CPU share enforcement\r\n");
+    printf("  kubectl trace [name] - Lifecycle events\r\n");
+    printf("  kubectl stats [reset] - Start-up latency per image\r\n");
+    printf("  kubectl bench [count] - Lifecycle throughput of synthetic containers\r\n");
 }
 
 static void cli_command_kubectl_start(Cli* cli, FuriString* args, void* context) {
@@ -73,7 +137,7 @@ static void cli_command_kubectl_start(Cli* cli, FuriString* args, void* context)
     }
     
     // Check if container with this name already exists
-    Container* existing = find_container_by_name(container_runtime, furi_string_get_cstr(name));
+    Container* existing = container_runtime_find(container_runtime, furi_string_get_cstr(name));
     if(existing) {
         printf("Container '%s' already exists\r\n", furi_string_get_cstr(name));
         furi_string_free(name);
@@ -100,8 +164,9 @@ static void cli_command_kubectl_start(Cli* cli, FuriString* args, void* context)
         .name = furi_string_get_cstr(name),
         .image = furi_string_get_cstr(image),
         .args = (void*)furi_string_get_cstr(args), // Pass remaining args
-        .restart_on_crash = true,
+        .restart_policy = ContainerRestartPolicyAlways,
         .system_container = false,
+        .priority_class = ContainerPriorityClassNormal,
         .resource_limits = {
             .max_memory = 4 * 1024,  // 4KB - absolute minimum to function
             .cpu_time_share = 5,     // 5% CPU share - extremely minimal
@@ -121,7 +186,13 @@ static void cli_command_kubectl_start(Cli* cli, FuriString* args, void* context)
     if(container_start(container)) {
         printf("Container '%s' started successfully\r\n", config.name);
     } else {
-        printf("Failed to start container '%s'\r\n", config.name);
+        ContainerStatus status;
+        container_get_status(container, &status);
+        if(status.admission_pending) {
+            printf("Container '%s' is waiting for preempted containers to exit\r\n", config.name);
+        } else {
+            printf("Failed to start container '%s'\r\n", config.name);
+        }
     }
     
     furi_string_free(name);
@@ -145,7 +216,7 @@ static void cli_command_kubectl_stop(Cli* cli, FuriString* args) {
     }
     
     const char* container_name = furi_string_get_cstr(args);
-    Container* container = find_container_by_name(container_runtime, container_name);
+    Container* container = container_runtime_find(container_runtime, container_name);
     
     if(!container) {
         printf("Container '%s' not found\r\n", container_name);
@@ -157,6 +228,115 @@ static void cli_command_kubectl_stop(Cli* cli, FuriString* args) {
     printf("Container stopped\r\n");
 }
 
+static void cli_command_kubectl_pause(Cli* cli, FuriString* args) {
+    UNUSED(cli);
+
+    if(!container_runtime) {
+        container_runtime = furi_get_container_runtime();
+        if(!container_runtime) {
+            printf("Runtime not initialized\r\n");
+            return;
+        }
+    }
+
+    FuriString* name = furi_string_alloc();
+    do {
+        if(!cli_args_read_string_and_trim(args, name)) {
+            printf("Usage: kubectl pause <name> [checkpoint]\r\n");
+            break;
+        }
+
+        Container* container =
+            container_runtime_find(container_runtime, furi_string_get_cstr(name));
+        if(!container) {
+            printf("Container '%s' not found\r\n", furi_string_get_cstr(name));
+            break;
+        }
+
+        if(furi_string_cmp_str(args, "checkpoint") == 0) {
+            if(!container_checkpoint(container)) {
+                printf("Checkpoint failed, see logs\r\n");
+                break;
+            }
+
+            ContainerStatus status;
+            container_get_status(container, &status);
+            printf(
+                "Checkpointed: %lu bytes saved, %lu bytes reclaimed, %lums\r\n",
+                (unsigned long)status.checkpoint_size,
+                (unsigned long)status.reclaimed,
+                (unsigned long)status.pause_time);
+        } else {
+            if(!container_pause(container)) {
+                printf("Pause failed, see logs\r\n");
+                break;
+            }
+            printf("Container paused\r\n");
+        }
+    } while(false);
+
+    furi_string_free(name);
+}
+
+static void cli_command_kubectl_resume(Cli* cli, FuriString* args) {
+    UNUSED(cli);
+
+    if(!container_runtime) {
+        container_runtime = furi_get_container_runtime();
+        if(!container_runtime) {
+            printf("Runtime not initialized\r\n");
+            return;
+        }
+    }
+
+    if(furi_string_empty(args)) {
+        printf("Usage: kubectl resume <name>\r\n");
+        return;
+    }
+
+    const char* container_name = furi_string_get_cstr(args);
+    Container* container = container_runtime_find(container_runtime, container_name);
+
+    if(!container) {
+        printf("Container '%s' not found\r\n", container_name);
+        return;
+    }
+
+    container_resume(container);
+    printf("Container resumed\r\n");
+}
+
+static void cli_command_kubectl_delete(Cli* cli, FuriString* args) {
+    UNUSED(cli);
+
+    if(!container_runtime) {
+        container_runtime = furi_get_container_runtime();
+        if(!container_runtime) {
+            printf("Runtime not initialized\r\n");
+            return;
+        }
+    }
+
+    if(furi_string_empty(args)) {
+        printf("Usage: kubectl delete <name>\r\n");
+        return;
+    }
+
+    const char* container_name = furi_string_get_cstr(args);
+    Container* container = container_runtime_find(container_runtime, container_name);
+
+    if(!container) {
+        printf("Container '%s' not found\r\n", container_name);
+        return;
+    }
+
+    if(container_delete(container)) {
+        printf("Container deleted\r\n");
+    } else {
+        printf("Container is still exiting, try again\r\n");
+    }
+}
+
 // Ultra-minimal list implementation - just show count to save memory
 static void cli_command_kubectl_list(Cli* cli) {
     UNUSED(cli);
@@ -169,20 +349,111 @@ static void cli_command_kubectl_list(Cli* cli) {
         }
     }
     
-    uint8_t count = container_runtime_get_count(container_runtime);
-    printf("CONTAINERS: %u/8\r\n", count);
+    size_t count = container_runtime_get_count(container_runtime);
+    printf("CONTAINERS: %zu\r\n", count);
     
     if(count == 0) {
         printf("No containers running\r\n");
         return;
     }
     
-    // Ultra-minimal implementation to save memory
-    printf("%u container(s) running\r\n", count);
-    printf("Use kubectl health for status\r\n");
+    printf(
+        "%-16s %-10s %5s %5s %8s %8s %8s\r\n",
+        "NAME",
+        "STATE",
+        "CPU%",
+        "SHARE",
+        "MEM",
+        "PEAK",
+        "LIMIT");
+    for(ContainerId id = container_runtime_get_next(container_runtime, CONTAINER_ID_INVALID);
+        id != CONTAINER_ID_INVALID;
+        id = container_runtime_get_next(container_runtime, id)) {
+        Container* container = container_runtime_get(container_runtime, id);
+        if(!container) continue;
+
+        const ContainerConfig* config = container_get_config(container);
+        ContainerStatus status;
+        container_get_status(container, &status);
+        const char* state = cli_container_state_name(status.state);
+        if(status.oom_killed) {
+            state = "OOMKilled";
+        } else if(status.restart_pending) {
+            state = "BackOff";
+        } else if(status.unhealthy && status.state == ContainerStateTerminated) {
+            state = "Unhealthy";
+        } else if(status.admission_pending) {
+            state = status.preempted ? "Preempted" : "Waiting";
+        } else if(status.checkpointed && status.state == ContainerStatePaused) {
+            state = "SwappedOut";
+        }
+        printf(
+            "%-16s %-10s %4lu%c %5lu %8lu %8lu %8lu\r\n",
+            config->name,
+            state,
+            (unsigned long)status.cpu_usage,
+            status.throttled ? '*' : ' ',
+            (unsigned long)config->resource_limits.cpu_time_share,
+            (unsigned long)status.memory_used,
+            (unsigned long)status.memory_peak,
+            (unsigned long)config->resource_limits.max_memory);
+    }
 }
 
 // Apply a pod manifest
+// Storage use, per container since it was created
+static void cli_command_kubectl_top(Cli* cli) {
+    UNUSED(cli);
+
+    if(!container_runtime) {
+        container_runtime = furi_get_container_runtime();
+        if(!container_runtime) {
+            printf("Runtime not available\r\n");
+            return;
+        }
+    }
+
+    printf(
+        "%-16s %4s %8s %10s %10s %8s %9s %8s\r\n",
+        "NAME",
+        "CPU%",
+        "MEM",
+        "READ",
+        "WRITTEN",
+        "OPS",
+        "THROTTLED",
+        "IO LIMIT");
+    for(ContainerId id = container_runtime_get_next(container_runtime, CONTAINER_ID_INVALID);
+        id != CONTAINER_ID_INVALID;
+        id = container_runtime_get_next(container_runtime, id)) {
+        Container* container = container_runtime_get(container_runtime, id);
+        if(!container) continue;
+
+        const ContainerConfig* config = container_get_config(container);
+        ContainerStatus status;
+        container_get_status(container, &status);
+
+        char limit[12] = "-";
+        if(config->resource_limits.io_bytes_per_second) {
+            snprintf(
+                limit,
+                sizeof(limit),
+                "%lu",
+                (unsigned long)config->resource_limits.io_bytes_per_second);
+        }
+        printf(
+            "%-16s %4lu %8lu %10lu %10lu %8lu %7lums %8s\r\n",
+            config->name,
+            (unsigned long)status.cpu_usage,
+            (unsigned long)status.memory_used,
+            (unsigned long)status.io.bytes_read,
+            (unsigned long)status.io.bytes_written,
+            (unsigned long)status.io.operations,
+            (unsigned long)status.io.throttled_ms,
+            limit);
+    }
+}
+
 static void cli_command_kubectl_apply(Cli* cli, FuriString* args) {
     UNUSED(cli);
     
@@ -221,23 +492,21 @@ static void cli_command_kubectl_apply(Cli* cli, FuriString* args) {
         return;
     }
     
-    // Instantiate containers from manifest
-    printf("Validating...\r\n");
-    Container** containers = pod_manifest_instantiate(container_runtime, manifest);
-    
-    if(!containers) {
+    // Images are validated by preloading them ahead of instantiation
+    PodManifestApplyStats stats;
+    if(!pod_manifest_batch_apply_ex(container_runtime, &manifest, 1, &stats)) {
         printf("Failed: verify FAP files exist\r\n");
     } else {
         printf("Applied manifest: %s\r\n", furi_string_get_cstr(manifest_path));
-        
-        // Get more info about what was created
-        const PodContainerSpec* specs;
-        uint32_t count = pod_manifest_get_containers(manifest, &specs);
-        printf("Created %lu container(s)\r\n", (unsigned long)count);
-        
-        // Free container array
-        free(containers);
+        printf("Created %lu container(s)\r\n", stats.containers);
     }
+    printf(
+        "Timings: prepare %lums, wait %lums, create %lums, start %lums, total %lums\r\n",
+        stats.prepare_ms,
+        stats.wait_ms,
+        stats.create_ms,
+        stats.start_ms,
+        stats.total_ms);
     
     pod_manifest_free(manifest);
     furi_string_free(manifest_path);
@@ -258,20 +527,21 @@ static void cli_command_kubectl_health(Cli* cli, FuriString* args, void* context
     }
     
     // Get basic stats
-    uint8_t count = container_runtime_get_count(container_runtime);
+    size_t count = container_runtime_get_count(container_runtime);
+    size_t capacity = container_runtime_get_capacity(container_runtime);
     uint32_t free = memmgr_get_free_heap();
     uint32_t max_block = memmgr_heap_get_max_free_block();
     uint32_t total = memmgr_get_total_heap();
     uint32_t used = total - free;
     
     // Ultra-compact format that uses very few bytes
-    printf("Containers: %u/8\r\n", count);
+    printf("Containers: %zu/%zu\r\n", count, capacity);
     printf("Memory: %lu KB used, %lu KB free (total: %lu KB)\r\n", 
            used / 1024, free / 1024, total / 1024);
     printf("Largest block: %lu KB\r\n", max_block / 1024);
     
     // Simple status indicator
-    if(count >= 8) printf("Status: MAX CONTAINERS REACHED\r\n");
+    if(count >= capacity) printf("Status: MAX CONTAINERS REACHED\r\n");
     else if(free < 4096) printf("Status: CRITICAL - Low memory\r\n");
     else if(free < 8192) printf("Status: WARNING - Memory pressure\r\n");
     else printf("Status: OK - Healthy\r\n");
@@ -300,7 +570,7 @@ static void cli_command_kubectl_debug(Cli* cli, FuriString* args) {
     }
     
     const char* container_name = furi_string_get_cstr(args);
-    Container* container = find_container_by_name(container_runtime, container_name);
+    Container* container = container_runtime_find(container_runtime, container_name);
     
     if(!container) {
         printf("Container '%s' not found\r\n", container_name);
@@ -308,30 +578,364 @@ static void cli_command_kubectl_debug(Cli* cli, FuriString* args) {
     }
     
     // Get container status
+    const ContainerConfig* config = container_get_config(container);
     ContainerStatus status;
     container_get_status(container, &status);
     
     // Print detailed container info
-    printf("Container Debug: %s\r\n", container->config.name);
+    printf("Container Debug: %s\r\n", config->name);
     printf("-------------------\r\n");
-    printf("Image: %s\r\n", container->config.image);
-    
-    const char* state_str = "Unknown";
-    switch(status.state) {
-        case ContainerStatePending: state_str = "Pending"; break;
-        case ContainerStateRunning: state_str = "Running"; break;
-        case ContainerStatePaused: state_str = "Paused"; break;
-        case ContainerStateTerminated: state_str = "Terminated"; break;
+    printf("Image: %s\r\n", config->image);
+    
+    printf("State: %s\r\n", cli_container_state_name(status.state));
+    if(status.oom_killed) printf("Killed: exceeded memory limit\r\n");
+    if(status.exit_reason != ContainerExitReasonNone) {
+        printf(
+            "Last exit: %s, code %ld\r\n",
+            cli_container_exit_reason_name(status.exit_reason),
+            (long)status.exit_code);
     }
-    
-    printf("State: %s\r\n", state_str);
     printf("Uptime: %lus\r\n", (unsigned long)status.uptime);
     printf("Restarts: %lu\r\n", (unsigned long)status.restart_count);
-    printf("Memory limit: %lu bytes\r\n", (unsigned long)container->config.resource_limits.max_memory);
-    printf("CPU share: %lu%%\r\n", (unsigned long)container->config.resource_limits.cpu_time_share);
-    printf("Max threads: %lu\r\n", (unsigned long)container->config.resource_limits.max_threads);
-    printf("Restart policy: %s\r\n", container->config.restart_on_crash ? "Yes" : "No");
-    printf("System privileges: %s\r\n", container->config.system_container ? "Yes" : "No");
+    printf("Memory used: %lu bytes\r\n", (unsigned long)status.memory_used);
+    printf("Memory peak: %lu bytes\r\n", (unsigned long)status.memory_peak);
+    printf("Memory limit: %lu bytes\r\n", (unsigned long)config->resource_limits.max_memory);
+    printf(
+        "CPU usage: %lu%%%s\r\n",
+        (unsigned long)status.cpu_usage,
+        status.throttled ? " (throttled)" : "");
+    printf("CPU share: %lu%%\r\n", (unsigned long)config->resource_limits.cpu_time_share);
+    printf("Max threads: %lu\r\n", (unsigned long)config->resource_limits.max_threads);
+    if(config->resource_limits.io_bytes_per_second) {
+        printf(
+            "Storage I/O limit: %lu bytes/s\r\n",
+            (unsigned long)config->resource_limits.io_bytes_per_second);
+    }
+    if(status.checkpointed || status.resume_time) {
+        printf(
+            "Checkpoint: %lu bytes, reclaimed %lu bytes, pause %lums, resume %lums\r\n",
+            (unsigned long)status.checkpoint_size,
+            (unsigned long)status.reclaimed,
+            (unsigned long)status.pause_time,
+            (unsigned long)status.resume_time);
+    }
+    printf("Priority class: %s\r\n", cli_container_priority_class_name(config->priority_class));
+    if(status.admission_pending) {
+        printf("Admission: waiting for memory%s\r\n", status.preempted ? ", preempted" : "");
+    }
+    printf("Restart policy: %s\r\n", cli_container_restart_policy_name(config->restart_policy));
+    if(status.restart_pending) {
+        printf("Restart back-off: %lums left\r\n", (unsigned long)status.restart_delay);
+    }
+    if(config->health_check.type == HealthCheckTypeCommand) {
+        printf(
+            "Health check: %s, every %lums\r\n",
+            config->health_check.command,
+            (unsigned long)config->health_check.period_ms);
+    }
+    for(uint32_t i = 0; i < config->volume_mount_count; i++) {
+        const VolumeMountSpec* volume = &config->volume_mounts[i];
+        printf(
+            "Volume: %s at %s%s\r\n",
+            volume->name,
+            volume->mount_path,
+            volume->read_only ? ", read only" : "");
+    }
+    printf("System privileges: %s\r\n", config->system_container ? "Yes" : "No");
+}
+
+static void cli_command_kubectl_throttle(Cli* cli, FuriString* args) {
+    UNUSED(cli);
+
+    if(!container_runtime) {
+        container_runtime = furi_get_container_runtime();
+        if(!container_runtime) {
+            printf("Runtime not initialized\r\n");
+            return;
+        }
+    }
+
+    if(furi_string_cmp_str(args, "off") == 0) {
+        container_runtime_set_throttle_mode(container_runtime, ContainerThrottleModeNone);
+    } else if(furi_string_cmp_str(args, "priority") == 0) {
+        container_runtime_set_throttle_mode(container_runtime, ContainerThrottleModePriority);
+    } else {
+        printf("Usage: kubectl throttle <off|priority>\r\n");
+        return;
+    }
+
+    printf("Throttle mode: %s\r\n", furi_string_get_cstr(args));
+}
+
+static void cli_command_kubectl_trace(Cli* cli, FuriString* args) {
+    UNUSED(cli);
+
+    if(!container_runtime) {
+        container_runtime = furi_get_container_runtime();
+        if(!container_runtime) {
+            printf("Runtime not initialized\r\n");
+            return;
+        }
+    }
+
+    ContainerId filter = CONTAINER_ID_INVALID;
+    if(!furi_string_empty(args)) {
+        const char* container_name = furi_string_get_cstr(args);
+        Container* container = container_runtime_find(container_runtime, container_name);
+        if(!container) {
+            printf("Container '%s' not found\r\n", container_name);
+            return;
+        }
+        filter = container_get_id(container);
+    }
+
+    ContainerTrace* trace = container_runtime_get_trace(container_runtime);
+    ContainerTraceEvent events[8];
+    uint32_t sequence = 0;
+    size_t count;
+
+    printf("%10s %-16s %-12s %s\r\n", "TICK", "CONTAINER", "EVENT", "VALUE");
+    while((count = container_trace_read(trace, &sequence, events, COUNT_OF(events)))) {
+        for(size_t i = 0; i < count; i++) {
+            const ContainerTraceEvent* event = &events[i];
+            if(filter != CONTAINER_ID_INVALID && event->container != filter) continue;
+
+            Container* container = container_runtime_get(container_runtime, event->container);
+            printf("%10lu ", event->timestamp);
+            if(container) {
+                printf("%-16s ", container_get_config(container)->name);
+            } else {
+                printf("%-16lX ", event->container);
+            }
+            printf(
+                "%-12s %ld%s\r\n",
+                container_trace_event_name(event->type),
+                event->value,
+                event->type == ContainerTraceEventCrash ? "" : "ms");
+        }
+    }
+}
+
+static void cli_command_kubectl_stats(Cli* cli, FuriString* args) {
+    UNUSED(cli);
+
+    if(!container_runtime) {
+        container_runtime = furi_get_container_runtime();
+        if(!container_runtime) {
+            printf("Runtime not initialized\r\n");
+            return;
+        }
+    }
+
+    ContainerTrace* trace = container_runtime_get_trace(container_runtime);
+
+    if(furi_string_cmp_str(args, "reset") == 0) {
+        container_trace_reset(trace);
+        printf("Trace cleared\r\n");
+        return;
+    }
+
+    FuriString* image = furi_string_alloc();
+    ContainerTraceHistogram phases[CONTAINER_TRACE_PHASE_COUNT];
+
+    size_t index = 0;
+    for(; container_trace_get_image(trace, index, image, phases); index++) {
+        printf("%s\r\n", furi_string_get_cstr(image));
+        printf(
+            "  %-12s %6s %6s %6s %6s %6s\r\n", "PHASE", "COUNT", "MEAN", "P50", "P90", "MAX");
+        for(size_t phase = 0; phase < CONTAINER_TRACE_PHASE_COUNT; phase++) {
+            const ContainerTraceHistogram* histogram = &phases[phase];
+            if(!histogram->count) continue;
+
+            printf(
+                "  %-12s %6u %6lu %6lu %6lu %6lu\r\n",
+                container_trace_event_name(phase),
+                histogram->count,
+                histogram->total_ms / histogram->count,
+                container_trace_histogram_percentile(histogram, 50),
+                container_trace_histogram_percentile(histogram, 90),
+                histogram->max_ms);
+        }
+    }
+
+    if(!index) {
+        printf("No containers started yet\r\n");
+    }
+
+    ContainerSchedulerStats scheduler;
+    container_runtime_get_scheduler_stats(container_runtime, &scheduler);
+    if(scheduler.runs) {
+        printf(
+            "Scheduler: %lu passes, mean %luus, max %luus\r\n",
+            (unsigned long)scheduler.runs,
+            (unsigned long)(scheduler.total_us / scheduler.runs),
+            (unsigned long)scheduler.max_us);
+    }
+
+    furi_string_free(image);
+}
+
+static bool cli_kubectl_bench_signal(uint32_t signal, void* arg, void* context) {
+    UNUSED(arg);
+    if(signal != FuriSignalExit) return false;
+
+    furi_thread_flags_set((FuriThreadId)context, CLI_KUBECTL_BENCH_FLAG_EXIT);
+    return true;
+}
+
+// Synthetic container, idles until asked to exit
+static int32_t cli_kubectl_bench_container(void* context) {
+    FuriSemaphore* ready = context;
+
+    furi_thread_set_signal_callback(
+        furi_thread_get_current(), cli_kubectl_bench_signal, furi_thread_get_current_id());
+    furi_semaphore_release(ready);
+    furi_thread_flags_wait(CLI_KUBECTL_BENCH_FLAG_EXIT, FuriFlagWaitAny, FuriWaitForever);
+
+    return 0;
+}
+
+static uint32_t cli_kubectl_bench_elapsed_us(uint32_t start) {
+    return (DWT->CYCCNT - start) / furi_hal_cortex_instructions_per_microsecond();
+}
+
+static void cli_kubectl_bench_print(const char* phase, uint32_t ops, uint32_t total_us) {
+    printf(
+        "%-8s %5lu %10lu %8lu\r\n",
+        phase,
+        (unsigned long)ops,
+        (unsigned long)total_us,
+        (unsigned long)(ops ? total_us / ops : 0));
+}
+
+// Stop signals are lost until the container installed its callback
+static uint32_t cli_kubectl_bench_wait_ready(FuriSemaphore* ready, uint32_t count) {
+    uint32_t ready_count = 0;
+    while(ready_count < count &&
+          furi_semaphore_acquire(ready, CLI_KUBECTL_BENCH_READY_MS) == FuriStatusOk) {
+        ready_count++;
+    }
+    return ready_count;
+}
+
+// Lifecycle throughput next to the running containers, container ids tag
+// storage accounts so a second runtime would collide with the shared one
+static void cli_command_kubectl_bench(Cli* cli, FuriString* args) {
+    UNUSED(cli);
+
+    uint32_t count = CLI_KUBECTL_BENCH_DEFAULT;
+    if(!furi_string_empty(args) &&
+       (sscanf(furi_string_get_cstr(args), "%lu", &count) != 1 || count == 0 ||
+        count > CLI_KUBECTL_BENCH_MAX)) {
+        printf("Usage: kubectl bench [1-%u]\r\n", CLI_KUBECTL_BENCH_MAX);
+        return;
+    }
+
+    if(!container_runtime) {
+        container_runtime = furi_get_container_runtime();
+        if(!container_runtime) {
+            printf("Runtime not initialized\r\n");
+            return;
+        }
+    }
+    ContainerRuntime* runtime = container_runtime;
+
+    Container** containers = malloc(sizeof(Container*) * count);
+    FuriSemaphore* ready = furi_semaphore_alloc(count, 0);
+    ContainerConfig config = {
+        .image = "bench",
+        .args = ready,
+        .restart_policy = ContainerRestartPolicyNever,
+        .priority_class = ContainerPriorityClassBestEffort,
+        .resource_limits = {.max_memory = CLI_KUBECTL_BENCH_MEMORY, .max_threads = 1},
+        .entry_point = cli_kubectl_bench_container,
+    };
+    char name[16];
+    config.name = name;
+    uint32_t start;
+
+    printf("%-8s %5s %10s %8s\r\n", "PHASE", "OPS", "TOTAL_US", "US/OP");
+
+    uint32_t created = 0;
+    start = DWT->CYCCNT;
+    for(; created < count; created++) {
+        snprintf(name, sizeof(name), "bench%lu", (unsigned long)created);
+        containers[created] = container_create(runtime, &config);
+        if(!containers[created]) break;
+    }
+    cli_kubectl_bench_print("create", created, cli_kubectl_bench_elapsed_us(start));
+
+    start = DWT->CYCCNT;
+    for(uint32_t i = 0; i < created; i++) {
+        snprintf(name, sizeof(name), "bench%lu", (unsigned long)i);
+        container_runtime_find(runtime, name);
+    }
+    cli_kubectl_bench_print("find", created, cli_kubectl_bench_elapsed_us(start));
+
+    // Started ones are moved to the front, the rest ran out of memory
+    uint32_t started = 0;
+    start = DWT->CYCCNT;
+    for(uint32_t i = 0; i < created; i++) {
+        if(!container_start(containers[i])) continue;
+        Container* container = containers[started];
+        containers[started++] = containers[i];
+        containers[i] = container;
+    }
+    cli_kubectl_bench_print("start", started, cli_kubectl_bench_elapsed_us(start));
+    for(uint32_t i = started; i < created; i++) {
+        // Drops the pending admission
+        container_stop(containers[i], true);
+    }
+    started = cli_kubectl_bench_wait_ready(ready, started);
+
+    ContainerSchedulerStats before;
+    ContainerSchedulerStats scheduler;
+    container_runtime_get_scheduler_stats(runtime, &before);
+    furi_delay_ms((CLI_KUBECTL_BENCH_PASSES + 1) * 1000);
+    container_runtime_get_scheduler_stats(runtime, &scheduler);
+    scheduler.runs -= before.runs;
+    scheduler.total_us -= before.total_us;
+
+    start = DWT->CYCCNT;
+    for(uint32_t i = 0; i < started; i++) {
+        container_stop(containers[i], true);
+    }
+    cli_kubectl_bench_print("stop", started, cli_kubectl_bench_elapsed_us(start));
+
+    // Whole cycle of one container at a time, as the scheduler restarts them
+    uint32_t restarted = 0;
+    start = DWT->CYCCNT;
+    for(uint32_t i = 0; i < started; i++) {
+        if(!container_start(containers[i])) continue;
+        cli_kubectl_bench_wait_ready(ready, 1);
+        container_stop(containers[i], true);
+        restarted++;
+    }
+    cli_kubectl_bench_print("restart", restarted, cli_kubectl_bench_elapsed_us(start));
+
+    uint32_t deleted = 0;
+    start = DWT->CYCCNT;
+    for(uint32_t i = 0; i < created; i++) {
+        if(container_delete(containers[i])) deleted++;
+    }
+    cli_kubectl_bench_print("delete", deleted, cli_kubectl_bench_elapsed_us(start));
+
+    printf("Started %lu of %lu containers\r\n", (unsigned long)started, (unsigned long)count);
+    if(scheduler.runs) {
+        printf(
+            "Scheduler: %lu passes, mean %luus",
+            (unsigned long)scheduler.runs,
+            (unsigned long)(scheduler.total_us / scheduler.runs));
+        if(started) {
+            printf(
+                ", %luus per container",
+                (unsigned long)(scheduler.total_us / scheduler.runs / started));
+        }
+        printf("\r\n");
+    }
+
+    free(containers);
+    furi_semaphore_free(ready);
 }
 
 // Main command handler
@@ -350,6 +954,14 @@ static void cli_command_kubectl_callback(Cli* cli, FuriString* args, void* conte
         cli_command_kubectl_start(cli, args, context);
     } else if(furi_string_cmp_str(cmd, "stop") == 0) {
         cli_command_kubectl_stop(cli, args);
+    } else if(furi_string_cmp_str(cmd, "delete") == 0) {
+        cli_command_kubectl_delete(cli, args);
+    } else if(furi_string_cmp_str(cmd, "pause") == 0) {
+        cli_command_kubectl_pause(cli, args);
+    } else if(furi_string_cmp_str(cmd, "resume") == 0) {
+        cli_command_kubectl_resume(cli, args);
+    } else if(furi_string_cmp_str(cmd, "top") == 0) {
+        cli_command_kubectl_top(cli);
     } else if(furi_string_cmp_str(cmd, "list") == 0) {
         cli_command_kubectl_list(cli);
     } else if(furi_string_cmp_str(cmd, "apply") == 0) {
@@ -358,6 +970,14 @@ static void cli_command_kubectl_callback(Cli* cli, FuriString* args, void* conte
         cli_command_kubectl_health(cli, args, context);
     } else if(furi_string_cmp_str(cmd, "debug") == 0) {
         cli_command_kubectl_debug(cli, args);
+    } else if(furi_string_cmp_str(cmd, "throttle") == 0) {
+        cli_command_kubectl_throttle(cli, args);
+    } else if(furi_string_cmp_str(cmd, "trace") == 0) {
+        cli_command_kubectl_trace(cli, args);
+    } else if(furi_string_cmp_str(cmd, "stats") == 0) {
+        cli_command_kubectl_stats(cli, args);
+    } else if(furi_string_cmp_str(cmd, "bench") == 0) {
+        cli_command_kubectl_bench(cli, args);
     } else {
         printf("Unknown command: %s\r\n", furi_string_get_cstr(cmd));
         cli_command_kubectl_help(cli);
@@ -35,12 +35,14 @@ int32_t container_test_app(void* p) {
     container_runtime_start(runtime);
     
     // Create a simple container config
-    ContainerConfig config;
+    ContainerConfig config = {0};
     config.name = "test_container";
     config.image = "test_app";
     config.args = "test arguments";
-    config.restart_on_crash = true;
+    config.restart_policy = ContainerRestartPolicyAlways;
     config.system_container = false;
+    config.warm_restart = false;
+    config.priority_class = ContainerPriorityClassNormal;
     
     // Set resource limits
     config.resource_limits.max_memory = 4 * 1024; // 4KB
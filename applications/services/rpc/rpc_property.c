@@ -3,6 +3,8 @@
 #include <furi_hal_info.h>
 #include <furi_hal_power.h>
 #include <core/core_defines.h>
+#include <toolbox/property.h>
+#include <furi/containerization/containerization.h>
 
 #include "rpc_i.h"
 
@@ -11,6 +13,8 @@
 #define PROPERTY_CATEGORY_DEVICE_INFO "devinfo"
 #define PROPERTY_CATEGORY_POWER_INFO  "pwrinfo"
 #define PROPERTY_CATEGORY_POWER_DEBUG "pwrdebug"
+#define PROPERTY_CATEGORY_CONTAINERS  "containers"
+#define PROPERTY_CATEGORY_HEAP        "heap"
 
 typedef struct {
     RpcSession* session;
@@ -41,6 +45,73 @@ static void
     }
 }
 
+static void rpc_system_property_heap_histogram(FuriString* value, const uint16_t* histogram) {
+    furi_string_reset(value);
+    for(size_t bin = 0; bin < MEMMGR_HEAP_REPORT_BINS; bin++) {
+        furi_string_cat_printf(value, bin ? " %u" : "%u", histogram[bin]);
+    }
+}
+
+static void rpc_system_property_heap_get(PropertyValueCallback out, void* context) {
+    FuriString* key = furi_string_alloc();
+    FuriString* value = furi_string_alloc();
+    FuriString* text = furi_string_alloc();
+    PropertyValueContext property_context = {
+        .key = key, .value = value, .out = out, .sep = '.', .last = false, .context = context};
+
+    MemmgrHeapReport* report = malloc(sizeof(MemmgrHeapReport));
+    memmgr_heap_get_report(report);
+
+    // Raw report for tools that keep history, the keys below are the same data
+    const uint8_t* raw = (const uint8_t*)report;
+    furi_string_reset(text);
+    for(size_t i = 0; i < sizeof(MemmgrHeapReport); i++) {
+        furi_string_cat_printf(text, "%02X", raw[i]);
+    }
+    property_value_out(
+        &property_context, NULL, 2, "heap", "report", furi_string_get_cstr(text));
+
+    property_value_out(&property_context, "%u", 2, "heap", "version", report->version);
+    property_value_out(&property_context, "%lu", 2, "heap", "tick", report->tick);
+    property_value_out(&property_context, "%lu", 2, "heap", "free", report->free_size);
+    property_value_out(&property_context, "%lu", 2, "heap", "minimum", report->min_free_size);
+    property_value_out(&property_context, "%lu", 2, "heap", "largest", report->largest_free_block);
+    property_value_out(&property_context, "%u", 2, "heap", "fragmentation", report->fragmentation);
+    property_value_out(&property_context, "%u", 2, "heap", "blocks", report->free_blocks);
+    rpc_system_property_heap_histogram(text, report->free_histogram);
+    property_value_out(&property_context, NULL, 2, "heap", "hist", furi_string_get_cstr(text));
+
+    char index[4];
+    for(size_t i = 0; i < report->owner_count; i++) {
+        const MemmgrHeapReportOwner* owner = &report->owners[i];
+        snprintf(index, sizeof(index), "%u", i);
+        property_value_out(
+            &property_context, "0x%08lX", 4, "heap", "owner", index, "thread", owner->thread_id);
+        property_value_out(
+            &property_context, "%lu", 4, "heap", "owner", index, "size", owner->size);
+        property_value_out(
+            &property_context, "%u", 4, "heap", "owner", index, "blocks", owner->blocks);
+        rpc_system_property_heap_histogram(text, owner->histogram);
+        property_value_out(
+            &property_context,
+            NULL,
+            4,
+            "heap",
+            "owner",
+            index,
+            "hist",
+            furi_string_get_cstr(text));
+    }
+
+    property_context.last = true;
+    property_value_out(&property_context, "%u", 2, "heap", "owners", report->owner_count);
+
+    free(report);
+    furi_string_free(text);
+    furi_string_free(key);
+    furi_string_free(value);
+}
+
 static void rpc_system_property_get_process(const PB_Main* request, void* context) {
     furi_assert(request);
     furi_assert(request->which_content == PB_Main_property_get_request_tag);
@@ -81,6 +152,15 @@ static void rpc_system_property_get_process(const PB_Main* request, void* contex
         furi_hal_power_info_get(rpc_system_property_get_callback, '.', &property_context);
     } else if(!furi_string_cmp(topkey, PROPERTY_CATEGORY_POWER_DEBUG)) {
         furi_hal_power_debug_get(rpc_system_property_get_callback, &property_context);
+    } else if(
+        !furi_string_cmp(topkey, PROPERTY_CATEGORY_CONTAINERS) && furi_get_container_runtime()) {
+        container_trace_property_get(
+            container_runtime_get_trace(furi_get_container_runtime()),
+            rpc_system_property_get_callback,
+            '.',
+            &property_context);
+    } else if(!furi_string_cmp(topkey, PROPERTY_CATEGORY_HEAP)) {
+        rpc_system_property_heap_get(rpc_system_property_get_callback, &property_context);
     } else {
         rpc_send_and_release_empty(
             session, request->command_id, PB_CommandStatus_ERROR_INVALID_PARAMETERS);
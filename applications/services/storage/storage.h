@@ -509,6 +509,92 @@ FS_Error storage_sd_info(Storage* storage, SDInfo* info);
  */
 FS_Error storage_sd_status(Storage* storage);
 
+/******************* I/O Accounting *******************/
+
+/**
+ * @brief Storage use of the threads sharing an owner tag.
+ */
+typedef struct {
+    uint32_t bytes_read; /**< Bytes returned by file reads. */
+    uint32_t bytes_written; /**< Bytes accepted by file writes. */
+    uint32_t operations; /**< Calls of any kind. */
+    uint32_t throttled_ms; /**< Time the callers were held back by the limit. */
+} StorageIoStats;
+
+/**
+ * @brief Account storage use of an owner tag and optionally limit its throughput.
+ *
+ * Calls made from threads with the owner tag (see furi_thread_set_owner_tag())
+ * are counted from then on. Every call costs 512 bytes on top of the data it
+ * moves, and a caller over the limit is delayed after its call returns, so it
+ * never holds up the storage thread for other callers. The limit allows a burst
+ * of one second worth of data. Setting the limit again keeps the counters.
+ *
+ * @param storage pointer to a storage API instance.
+ * @param owner_tag non-zero owner tag.
+ * @param bytes_per_second throughput limit, 0 for unlimited.
+ */
+void storage_io_account_set(Storage* storage, uint32_t owner_tag, uint32_t bytes_per_second);
+
+/**
+ * @brief Stop accounting storage use of an owner tag.
+ *
+ * @param storage pointer to a storage API instance.
+ * @param owner_tag owner tag passed to storage_io_account_set().
+ */
+void storage_io_account_remove(Storage* storage, uint32_t owner_tag);
+
+/**
+ * @brief Get the storage use of an owner tag.
+ *
+ * @param storage pointer to a storage API instance.
+ * @param owner_tag owner tag passed to storage_io_account_set().
+ * @param stats pointer to the counters to be filled.
+ * @return true if the owner tag is accounted, false otherwise.
+ */
+bool storage_io_account_get(Storage* storage, uint32_t owner_tag, StorageIoStats* stats);
+
+/******************* Path Mounts *******************/
+
+/**
+ * @brief Directory mapped into the paths seen by an owner tag.
+ */
+typedef struct {
+    const char* path; /**< Top level path seen by the owner, such as "/data". */
+    const char* target; /**< Directory the path and everything below it maps to. */
+    bool read_only; /**< Deny opening for writing, removal and mkdir below the path. */
+} StorageMount;
+
+/**
+ * @brief Replace the mounts of an owner tag.
+ *
+ * Paths used by threads with the owner tag (see furi_thread_set_owner_tag())
+ * that start with a mount path are rewritten to its target before any other
+ * alias, so a mount at "/data" replaces the application data directory.
+ * Targets are not created. Lookup only looks at the first path component, so
+ * it costs the same for every path.
+ *
+ * @param storage pointer to a storage API instance.
+ * @param owner_tag non-zero owner tag.
+ * @param mounts pointer to the mounts, copied.
+ * @param count number of mounts, 0 removes all of them.
+ * @return true on success, false if a mount path isn't a single component
+ *         below the root or shadows a storage.
+ */
+bool storage_mounts_set(
+    Storage* storage,
+    uint32_t owner_tag,
+    const StorageMount* mounts,
+    size_t count);
+
+/**
+ * @brief Remove all mounts of an owner tag.
+ *
+ * @param storage pointer to a storage API instance.
+ * @param owner_tag owner tag passed to storage_mounts_set().
+ */
+void storage_mounts_remove(Storage* storage, uint32_t owner_tag);
+
 /************ Internal Storage Backup/Restore ************/
 
 typedef void (*StorageNameConverter)(FuriString*);
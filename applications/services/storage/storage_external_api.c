@@ -20,19 +20,24 @@
     Storage* storage = file->storage; \
     furi_check(storage);
 
+// Callers over their I/O limit wait here, not in the storage thread
 #define S_API_EPILOGUE                                                               \
     furi_check(                                                                      \
         furi_message_queue_put(storage->message_queue, &message, FuriWaitForever) == \
         FuriStatusOk);                                                               \
-    api_lock_wait_unlock_and_free(lock)
-
-#define S_API_MESSAGE(_command)      \
-    SAReturn return_data;            \
-    StorageMessage message = {       \
-        .lock = lock,                \
-        .command = _command,         \
-        .data = &data,               \
-        .return_data = &return_data, \
+    api_lock_wait_unlock_and_free(lock);                                             \
+    if(io_delay) furi_delay_ms(io_delay)
+
+#define S_API_MESSAGE(_command)                                                 \
+    SAReturn return_data;                                                       \
+    uint32_t io_delay = 0;                                                      \
+    StorageMessage message = {                                                  \
+        .lock = lock,                                                           \
+        .command = _command,                                                    \
+        .data = &data,                                                          \
+        .return_data = &return_data,                                            \
+        .owner_tag = furi_thread_get_owner_tag(furi_thread_get_current_id()),   \
+        .io_delay = &io_delay,                                                  \
     };
 
 #define S_API_DATA_FILE   \
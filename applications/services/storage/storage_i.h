@@ -5,6 +5,8 @@
 #include "storage_glue.h"
 #include "storage_sd_api.h"
 #include "filesystem_api_internal.h"
+#include "storage_io_i.h"
+#include "storage_mount_i.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -25,6 +27,8 @@ struct Storage {
     StorageData storage[STORAGE_COUNT];
     StorageSDGui sd_gui;
     FuriPubSub* pubsub;
+    StorageIo* io; // Per owner tag I/O accounting
+    StorageMounts* mounts; // Per owner tag path remapping
 };
 
 #ifdef __cplusplus
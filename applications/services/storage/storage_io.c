@@ -0,0 +1,137 @@
+#include "storage.h"
+#include "storage_i.h"
+#include "storage_io_i.h"
+
+#include <m-array.h>
+
+// Bytes charged for every operation on top of the data it moves, about the
+// card time of a sector
+#define STORAGE_IO_OPERATION_COST 512
+
+typedef struct {
+    uint32_t owner_tag;
+    uint32_t bytes_per_second; // 0 for unlimited
+    int64_t credit; // Bytes times 1000, up to a second worth of burst, negative is debt
+    uint32_t refilled; // Tick the credit was last refilled at
+    StorageIoStats stats;
+} StorageIoAccount;
+
+ARRAY_DEF(StorageIoAccountArray, StorageIoAccount, M_POD_OPLIST) // NOLINT
+
+struct StorageIo {
+    FuriMutex* mutex;
+    StorageIoAccountArray_t accounts; // A handful of containers, searched linearly
+};
+
+StorageIo* storage_io_alloc(void) {
+    StorageIo* io = malloc(sizeof(StorageIo));
+    io->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    StorageIoAccountArray_init(io->accounts);
+    return io;
+}
+
+static StorageIoAccount* storage_io_find(StorageIo* io, uint32_t owner_tag) {
+    for(size_t i = 0; i < StorageIoAccountArray_size(io->accounts); i++) {
+        StorageIoAccount* account = StorageIoAccountArray_get(io->accounts, i);
+        if(account->owner_tag == owner_tag) return account;
+    }
+
+    return NULL;
+}
+
+// Returns milliseconds the caller has to wait to pay off its debt
+static uint32_t storage_io_charge(StorageIoAccount* account, uint32_t bytes) {
+    const uint32_t now = furi_get_tick();
+    const int64_t rate = account->bytes_per_second;
+
+    account->credit += (int64_t)(now - account->refilled) * rate;
+    account->credit = MIN(account->credit, rate * 1000);
+    account->refilled = now;
+
+    account->credit -= (int64_t)(bytes + STORAGE_IO_OPERATION_COST) * 1000;
+    if(account->credit >= 0) return 0;
+
+    // Credit refills by rate every millisecond
+    return (-account->credit + rate - 1) / rate;
+}
+
+void storage_io_account(StorageIo* io, const StorageMessage* message) {
+    if(!message->owner_tag) return;
+
+    uint32_t bytes_read = 0;
+    uint32_t bytes_written = 0;
+    if(message->command == StorageCommandFileRead) {
+        bytes_read = message->return_data->uint16_value;
+    } else if(message->command == StorageCommandFileWrite) {
+        bytes_written = message->return_data->uint16_value;
+    }
+
+    furi_check(furi_mutex_acquire(io->mutex, FuriWaitForever) == FuriStatusOk);
+
+    StorageIoAccount* account = storage_io_find(io, message->owner_tag);
+    if(account) {
+        account->stats.bytes_read += bytes_read;
+        account->stats.bytes_written += bytes_written;
+        account->stats.operations++;
+
+        if(account->bytes_per_second) {
+            const uint32_t delay = storage_io_charge(account, bytes_read + bytes_written);
+            account->stats.throttled_ms += delay;
+            *message->io_delay = delay;
+        }
+    }
+
+    furi_mutex_release(io->mutex);
+}
+
+void storage_io_account_set(Storage* storage, uint32_t owner_tag, uint32_t bytes_per_second) {
+    furi_check(storage);
+    furi_check(owner_tag);
+    StorageIo* io = storage->io;
+
+    furi_check(furi_mutex_acquire(io->mutex, FuriWaitForever) == FuriStatusOk);
+
+    StorageIoAccount* account = storage_io_find(io, owner_tag);
+    if(!account) {
+        account = StorageIoAccountArray_push_new(io->accounts);
+        memset(account, 0, sizeof(StorageIoAccount));
+        account->owner_tag = owner_tag;
+    }
+
+    // Start with a full second of burst
+    account->bytes_per_second = bytes_per_second;
+    account->credit = (int64_t)bytes_per_second * 1000;
+    account->refilled = furi_get_tick();
+
+    furi_mutex_release(io->mutex);
+}
+
+void storage_io_account_remove(Storage* storage, uint32_t owner_tag) {
+    furi_check(storage);
+    StorageIo* io = storage->io;
+
+    furi_check(furi_mutex_acquire(io->mutex, FuriWaitForever) == FuriStatusOk);
+
+    for(size_t i = 0; i < StorageIoAccountArray_size(io->accounts); i++) {
+        if(StorageIoAccountArray_get(io->accounts, i)->owner_tag == owner_tag) {
+            StorageIoAccountArray_erase(io->accounts, i);
+            break;
+        }
+    }
+
+    furi_mutex_release(io->mutex);
+}
+
+bool storage_io_account_get(Storage* storage, uint32_t owner_tag, StorageIoStats* stats) {
+    furi_check(storage);
+    furi_check(stats);
+    StorageIo* io = storage->io;
+
+    furi_check(furi_mutex_acquire(io->mutex, FuriWaitForever) == FuriStatusOk);
+
+    const StorageIoAccount* account = storage_io_find(io, owner_tag);
+    if(account) *stats = account->stats;
+
+    furi_mutex_release(io->mutex);
+    return account != NULL;
+}
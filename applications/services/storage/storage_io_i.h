@@ -0,0 +1,18 @@
+#pragma once
+#include <furi.h>
+#include "storage_message.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct StorageIo StorageIo;
+
+StorageIo* storage_io_alloc(void);
+
+/** Charge a processed message to the owner tag of its caller, runs in the storage thread */
+void storage_io_account(StorageIo* io, const StorageMessage* message);
+
+#ifdef __cplusplus
+}
+#endif
@@ -158,6 +158,8 @@ typedef struct {
     StorageCommand command;
     SAData* data;
     SAReturn* return_data;
+    uint32_t owner_tag; // Owner tag of the calling thread, its I/O is accounted to the tag
+    uint32_t* io_delay; // Milliseconds the caller waits after the call, over its I/O limit
 } StorageMessage;
 
 #ifdef __cplusplus
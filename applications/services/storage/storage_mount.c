@@ -0,0 +1,173 @@
+#include "storage.h"
+#include "storage_i.h"
+#include "storage_mount_i.h"
+
+#include <m-array.h>
+
+#define TAG "StorageMount"
+
+typedef struct {
+    uint32_t hash; // Of the mount path without the leading slash
+    size_t path_length; // Including the leading slash
+    char* path;
+    char* target;
+    bool read_only;
+} StorageMountEntry;
+
+typedef struct {
+    uint32_t owner_tag;
+    StorageMountEntry* entries;
+    size_t count;
+} StorageMountTable;
+
+ARRAY_DEF(StorageMountTableArray, StorageMountTable, M_POD_OPLIST) // NOLINT
+
+struct StorageMounts {
+    FuriMutex* mutex;
+    StorageMountTableArray_t tables; // One per owner tag with mounts
+};
+
+StorageMounts* storage_mounts_alloc(void) {
+    StorageMounts* mounts = malloc(sizeof(StorageMounts));
+    mounts->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    StorageMountTableArray_init(mounts->tables);
+    return mounts;
+}
+
+// FNV-1a of the first path component, stops at the separator
+static uint32_t storage_mounts_hash(const char* component, size_t* length) {
+    uint32_t hash = 2166136261UL;
+    size_t i = 0;
+    for(; component[i] && component[i] != '/'; i++) {
+        hash = (hash ^ (uint8_t)component[i]) * 16777619UL;
+    }
+    *length = i;
+    return hash;
+}
+
+static bool storage_mounts_path_valid(const char* path) {
+    if(!path || path[0] != '/') return false;
+
+    size_t length;
+    storage_mounts_hash(path + 1, &length);
+
+    // One level below the root, not shadowing the storages themselves
+    const char* reserved[] = {
+        STORAGE_EXT_PATH_PREFIX, STORAGE_INT_PATH_PREFIX, STORAGE_ANY_PATH_PREFIX};
+    for(size_t i = 0; i < COUNT_OF(reserved); i++) {
+        if(strcmp(path, reserved[i]) == 0) return false;
+    }
+
+    return length > 0 && path[length + 1] == '\0';
+}
+
+static void storage_mounts_table_clear(StorageMountTable* table) {
+    for(size_t i = 0; i < table->count; i++) {
+        free(table->entries[i].path);
+        free(table->entries[i].target);
+    }
+    free(table->entries);
+}
+
+static size_t storage_mounts_find(StorageMounts* mounts, uint32_t owner_tag) {
+    for(size_t i = 0; i < StorageMountTableArray_size(mounts->tables); i++) {
+        if(StorageMountTableArray_get(mounts->tables, i)->owner_tag == owner_tag) return i;
+    }
+
+    return StorageMountTableArray_size(mounts->tables);
+}
+
+static void storage_mounts_remove_locked(StorageMounts* mounts, uint32_t owner_tag) {
+    const size_t index = storage_mounts_find(mounts, owner_tag);
+    if(index == StorageMountTableArray_size(mounts->tables)) return;
+
+    storage_mounts_table_clear(StorageMountTableArray_get(mounts->tables, index));
+    StorageMountTableArray_erase(mounts->tables, index);
+}
+
+bool storage_mounts_set(
+    Storage* storage,
+    uint32_t owner_tag,
+    const StorageMount* mount_list,
+    size_t count) {
+    furi_check(storage);
+    furi_check(owner_tag);
+    furi_check(mount_list || !count);
+    StorageMounts* mounts = storage->mounts;
+
+    for(size_t i = 0; i < count; i++) {
+        if(!storage_mounts_path_valid(mount_list[i].path) || !mount_list[i].target) {
+            FURI_LOG_E(TAG, "Invalid mount path %s", mount_list[i].path);
+            return false;
+        }
+    }
+
+    // Compiled outside the lock, the storage thread only waits for the swap
+    StorageMountTable table = {
+        .owner_tag = owner_tag,
+        .entries = count ? malloc(sizeof(StorageMountEntry) * count) : NULL,
+        .count = count,
+    };
+    for(size_t i = 0; i < count; i++) {
+        StorageMountEntry* entry = &table.entries[i];
+        entry->hash = storage_mounts_hash(mount_list[i].path + 1, &entry->path_length);
+        entry->path_length++;
+        entry->path = strdup(mount_list[i].path);
+        entry->target = strdup(mount_list[i].target);
+        entry->read_only = mount_list[i].read_only;
+    }
+
+    furi_check(furi_mutex_acquire(mounts->mutex, FuriWaitForever) == FuriStatusOk);
+    storage_mounts_remove_locked(mounts, owner_tag);
+    if(count) StorageMountTableArray_push_back(mounts->tables, table);
+    furi_mutex_release(mounts->mutex);
+
+    return true;
+}
+
+void storage_mounts_remove(Storage* storage, uint32_t owner_tag) {
+    furi_check(storage);
+    StorageMounts* mounts = storage->mounts;
+
+    furi_check(furi_mutex_acquire(mounts->mutex, FuriWaitForever) == FuriStatusOk);
+    storage_mounts_remove_locked(mounts, owner_tag);
+    furi_mutex_release(mounts->mutex);
+}
+
+FS_Error storage_mounts_resolve(
+    StorageMounts* mounts,
+    uint32_t owner_tag,
+    FuriString* path,
+    bool write) {
+    const char* path_cstr = furi_string_get_cstr(path);
+    if(!owner_tag || path_cstr[0] != '/') return FSE_OK;
+
+    // Only the first component is looked at, however deep the path is
+    size_t length;
+    const uint32_t hash = storage_mounts_hash(path_cstr + 1, &length);
+    FS_Error error = FSE_OK;
+
+    furi_check(furi_mutex_acquire(mounts->mutex, FuriWaitForever) == FuriStatusOk);
+
+    const size_t index = storage_mounts_find(mounts, owner_tag);
+    if(index < StorageMountTableArray_size(mounts->tables)) {
+        const StorageMountTable* table = StorageMountTableArray_get(mounts->tables, index);
+        for(size_t i = 0; i < table->count; i++) {
+            const StorageMountEntry* entry = &table->entries[i];
+            if(entry->hash != hash || entry->path_length != length + 1 ||
+               memcmp(entry->path, path_cstr, entry->path_length) != 0) {
+                continue;
+            }
+
+            if(write && entry->read_only) {
+                error = FSE_DENIED;
+            } else {
+                furi_string_replace_at(path, 0, entry->path_length, entry->target);
+            }
+            break;
+        }
+    }
+
+    furi_mutex_release(mounts->mutex);
+    return error;
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include <furi.h>
+#include "filesystem_api_defines.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct StorageMounts StorageMounts;
+
+StorageMounts* storage_mounts_alloc(void);
+
+/**
+ * Rewrite a path under a mount of the owner tag to its target, runs in the
+ * storage thread. Returns FSE_DENIED for writes below read-only mounts and
+ * leaves paths outside of the mounts as they are.
+ */
+FS_Error
+    storage_mounts_resolve(StorageMounts* mounts, uint32_t owner_tag, FuriString* path, bool write);
+
+#ifdef __cplusplus
+}
+#endif
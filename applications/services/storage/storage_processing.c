@@ -571,11 +571,21 @@ void storage_process_alias(
 
 void storage_process_message_internal(Storage* app, StorageMessage* message) {
     FuriString* path = NULL;
+    const uint32_t owner_tag = message->owner_tag;
+    FS_Error mount_error;
 
+    // Mounts of the caller go before aliases, so they can replace "/data"
     switch(message->command) {
     // File operations
     case StorageCommandFileOpen:
         path = furi_string_alloc_set(message->data->fopen.path);
+        mount_error = storage_mounts_resolve(
+            app->mounts, owner_tag, path, message->data->fopen.access_mode & FSAM_WRITE);
+        if(mount_error != FSE_OK) {
+            message->data->fopen.file->error_id = mount_error;
+            message->return_data->bool_value = false;
+            break;
+        }
         storage_process_alias(app, path, message->data->fopen.thread_id, true);
         message->return_data->bool_value = storage_process_file_open(
             app,
@@ -632,6 +642,7 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
     // Dir operations
     case StorageCommandDirOpen:
         path = furi_string_alloc_set(message->data->dopen.path);
+        storage_mounts_resolve(app->mounts, owner_tag, path, false);
         storage_process_alias(app, path, message->data->dopen.thread_id, true);
         message->return_data->bool_value =
             storage_process_dir_open(app, message->data->dopen.file, path);
@@ -656,33 +667,47 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
     // Common operations
     case StorageCommandCommonTimestamp:
         path = furi_string_alloc_set(message->data->ctimestamp.path);
+        storage_mounts_resolve(app->mounts, owner_tag, path, false);
         storage_process_alias(app, path, message->data->ctimestamp.thread_id, false);
         message->return_data->error_value =
             storage_process_common_timestamp(app, path, message->data->ctimestamp.timestamp);
         break;
     case StorageCommandCommonStat:
         path = furi_string_alloc_set(message->data->cstat.path);
+        storage_mounts_resolve(app->mounts, owner_tag, path, false);
         storage_process_alias(app, path, message->data->cstat.thread_id, false);
         message->return_data->error_value =
             storage_process_common_stat(app, path, message->data->cstat.fileinfo);
         break;
     case StorageCommandCommonRemove:
         path = furi_string_alloc_set(message->data->path.path);
+        mount_error = storage_mounts_resolve(app->mounts, owner_tag, path, true);
+        if(mount_error != FSE_OK) {
+            message->return_data->error_value = mount_error;
+            break;
+        }
         storage_process_alias(app, path, message->data->path.thread_id, false);
         message->return_data->error_value = storage_process_common_remove(app, path);
         break;
     case StorageCommandCommonMkDir:
         path = furi_string_alloc_set(message->data->path.path);
+        mount_error = storage_mounts_resolve(app->mounts, owner_tag, path, true);
+        if(mount_error != FSE_OK) {
+            message->return_data->error_value = mount_error;
+            break;
+        }
         storage_process_alias(app, path, message->data->path.thread_id, true);
         message->return_data->error_value = storage_process_common_mkdir(app, path);
         break;
     case StorageCommandCommonFSInfo:
         path = furi_string_alloc_set(message->data->cfsinfo.fs_path);
+        storage_mounts_resolve(app->mounts, owner_tag, path, false);
         storage_process_alias(app, path, message->data->cfsinfo.thread_id, false);
         message->return_data->error_value = storage_process_common_fs_info(
             app, path, message->data->cfsinfo.total_space, message->data->cfsinfo.free_space);
         break;
     case StorageCommandCommonResolvePath:
+        storage_mounts_resolve(app->mounts, owner_tag, message->data->cresolvepath.path, false);
         storage_process_alias(
             app, message->data->cresolvepath.path, message->data->cresolvepath.thread_id, true);
         break;
@@ -692,6 +717,8 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
         FuriString* path2 = furi_string_alloc_set(message->data->cequivpath.path2);
         storage_path_trim_trailing_slashes(path1);
         storage_path_trim_trailing_slashes(path2);
+        storage_mounts_resolve(app->mounts, owner_tag, path1, false);
+        storage_mounts_resolve(app->mounts, owner_tag, path2, false);
         storage_process_alias(app, path1, message->data->cequivpath.thread_id, false);
         storage_process_alias(app, path2, message->data->cequivpath.thread_id, false);
         if(message->data->cequivpath.check_subdir) {
@@ -743,6 +770,9 @@ void storage_process_message_internal(Storage* app, StorageMessage* message) {
         furi_string_free(path);
     }
 
+    // Before unlocking, the caller reads its delay once the call returns
+    storage_io_account(app->io, message);
+
     api_lock_unlock(message->lock);
 }
 
@@ -92,19 +92,15 @@ static void debug_changed(VariableItem* item) {
 const char* const heap_trace_mode_text[] = {
     "None",
     "Main",
-#ifdef FURI_DEBUG
     "Tree",
     "All",
-#endif
 };
 
 const uint32_t heap_trace_mode_value[] = {
     FuriHalRtcHeapTrackModeNone,
     FuriHalRtcHeapTrackModeMain,
-#ifdef FURI_DEBUG
     FuriHalRtcHeapTrackModeTree,
     FuriHalRtcHeapTrackModeAll,
-#endif
 };
 
 static void heap_trace_mode_changed(VariableItem* item) {
@@ -0,0 +1,285 @@
+#include "container_probe.h"
+#include "containerization.h"
+
+#include <core/log.h>
+#include <m-array.h>
+
+#define TAG "ContainerProbe"
+
+// Event loop, timer dispatch, registry lookup and the service callback with its logging
+#define CONTAINER_PROBE_STACK_SIZE (2 * 1024)
+#define CONTAINER_PROBE_QUEUE_SIZE 8
+
+// Kubernetes defaults for unset fields
+#define CONTAINER_PROBE_DEFAULT_PERIOD_MS  10000
+#define CONTAINER_PROBE_DEFAULT_TIMEOUT_MS 1000
+#define CONTAINER_PROBE_DEFAULT_FAILURES   3
+
+typedef enum {
+    ContainerProbeCommandWatch,
+    ContainerProbeCommandUnwatch,
+    ContainerProbeCommandStop,
+} ContainerProbeCommandType;
+
+typedef struct {
+    ContainerProbeCommandType type;
+    ContainerId container;
+    HealthCheckSpec spec; // Command is a copy owned by the message
+} ContainerProbeCommand;
+
+typedef struct {
+    ContainerProbeExecutor* executor;
+    ContainerId container;
+    HealthCheckSpec spec;
+    char* command; // Split in place into namespace, service and args
+    const char* namespace;
+    const char* service;
+    const char* args;
+    FuriEventLoopTimer* timer;
+    uint32_t successes;
+    uint32_t failures;
+    bool delayed; // Timer runs the initial delay
+} ContainerProbe;
+
+ARRAY_DEF(ContainerProbeArray, ContainerProbe*, M_PTR_OPLIST) // NOLINT
+
+struct ContainerProbeExecutor {
+    FuriThread* thread;
+    FuriMessageQueue* queue;
+    FuriEventLoop* event_loop; // Owned by the executor thread
+    ContainerProbeArray_t probes; // Only touched by the executor thread
+    ContainerProbeFailureCallback callback;
+    void* context;
+};
+
+static void container_probe_free(ContainerProbe* probe) {
+    furi_event_loop_timer_free(probe->timer);
+    free(probe->command);
+    free(probe);
+}
+
+static bool container_probe_run(ContainerProbe* probe) {
+    ServiceRegistry* registry = furi_get_service_registry();
+    ServiceEndpoint* endpoint =
+        registry ? service_registry_lookup(registry, probe->service, probe->namespace) : NULL;
+    if(!endpoint) {
+        FURI_LOG_D(TAG, "%s: no such service", probe->service);
+        return false;
+    }
+
+    const uint32_t start = furi_get_tick();
+    bool healthy = service_endpoint_probe(endpoint, probe->args);
+    const uint32_t duration = furi_get_tick() - start;
+    service_endpoint_release(endpoint);
+
+    if(healthy && duration > furi_ms_to_ticks(probe->spec.timeout_ms)) {
+        FURI_LOG_W(TAG, "%s: probe took %lu ticks", probe->service, duration);
+        healthy = false;
+    }
+
+    return healthy;
+}
+
+static void container_probe_timer_callback(void* context) {
+    ContainerProbe* probe = context;
+    const HealthCheckSpec* spec = &probe->spec;
+
+    if(probe->delayed) {
+        probe->delayed = false;
+        furi_event_loop_timer_start(probe->timer, furi_ms_to_ticks(spec->period_ms));
+    }
+
+    if(container_probe_run(probe)) {
+        probe->successes++;
+        if(probe->successes >= spec->success_threshold) probe->failures = 0;
+        return;
+    }
+
+    probe->successes = 0;
+    if(++probe->failures < spec->failure_threshold) return;
+
+    FURI_LOG_W(TAG, "%lX failed %lu health checks", probe->container, probe->failures);
+    probe->failures = 0;
+    probe->executor->callback(probe->container, probe->executor->context);
+}
+
+static size_t container_probe_find(ContainerProbeExecutor* executor, ContainerId container) {
+    for(size_t i = 0; i < ContainerProbeArray_size(executor->probes); i++) {
+        if((*ContainerProbeArray_get(executor->probes, i))->container == container) return i;
+    }
+
+    return ContainerProbeArray_size(executor->probes);
+}
+
+static void container_probe_unwatch(ContainerProbeExecutor* executor, ContainerId container) {
+    const size_t index = container_probe_find(executor, container);
+    if(index == ContainerProbeArray_size(executor->probes)) return;
+
+    container_probe_free(*ContainerProbeArray_get(executor->probes, index));
+    ContainerProbeArray_erase(executor->probes, index);
+}
+
+static void
+    container_probe_watch(ContainerProbeExecutor* executor, ContainerProbeCommand* command) {
+    container_probe_unwatch(executor, command->container);
+
+    ContainerProbe* probe = malloc(sizeof(ContainerProbe));
+    probe->executor = executor;
+    probe->container = command->container;
+    probe->spec = command->spec;
+    probe->command = (char*)command->spec.command;
+
+    // "[namespace/]service [args]", split once instead of on every probe
+    char* args = strchr(probe->command, ' ');
+    if(args) {
+        *args++ = '\0';
+        while(*args == ' ') args++;
+    }
+    probe->args = args ? args : "";
+
+    char* service = strchr(probe->command, '/');
+    if(service) {
+        *service++ = '\0';
+        probe->namespace = probe->command;
+        probe->service = service;
+    } else {
+        probe->namespace = NULL;
+        probe->service = probe->command;
+    }
+
+    probe->timer = furi_event_loop_timer_alloc(
+        executor->event_loop,
+        container_probe_timer_callback,
+        FuriEventLoopTimerTypePeriodic,
+        probe);
+    probe->delayed = probe->spec.initial_delay_ms > 0;
+    furi_event_loop_timer_start(
+        probe->timer,
+        furi_ms_to_ticks(probe->delayed ? probe->spec.initial_delay_ms : probe->spec.period_ms));
+
+    ContainerProbeArray_push_back(executor->probes, probe);
+}
+
+static void container_probe_queue_callback(FuriEventLoopObject* object, void* context) {
+    UNUSED(object);
+    ContainerProbeExecutor* executor = context;
+    ContainerProbeCommand command;
+
+    while(furi_message_queue_get(executor->queue, &command, 0) == FuriStatusOk) {
+        if(command.type == ContainerProbeCommandWatch) {
+            container_probe_watch(executor, &command);
+        } else if(command.type == ContainerProbeCommandUnwatch) {
+            container_probe_unwatch(executor, command.container);
+        } else {
+            // Commands behind the stop are released by container_probe_executor_free
+            furi_event_loop_stop(executor->event_loop);
+            break;
+        }
+    }
+}
+
+static int32_t container_probe_thread(void* context) {
+    ContainerProbeExecutor* executor = context;
+
+    // Timers can only be used from the thread the loop was created in
+    executor->event_loop = furi_event_loop_alloc();
+    furi_event_loop_subscribe_message_queue(
+        executor->event_loop,
+        executor->queue,
+        FuriEventLoopEventIn,
+        container_probe_queue_callback,
+        executor);
+
+    furi_event_loop_run(executor->event_loop);
+
+    for(size_t i = 0; i < ContainerProbeArray_size(executor->probes); i++) {
+        container_probe_free(*ContainerProbeArray_get(executor->probes, i));
+    }
+    ContainerProbeArray_reset(executor->probes);
+
+    furi_event_loop_unsubscribe(executor->event_loop, executor->queue);
+    furi_event_loop_free(executor->event_loop);
+    executor->event_loop = NULL;
+
+    return 0;
+}
+
+ContainerProbeExecutor*
+    container_probe_executor_alloc(ContainerProbeFailureCallback callback, void* context) {
+    furi_check(callback);
+
+    ContainerProbeExecutor* executor = malloc(sizeof(ContainerProbeExecutor));
+    executor->callback = callback;
+    executor->context = context;
+    executor->queue =
+        furi_message_queue_alloc(CONTAINER_PROBE_QUEUE_SIZE, sizeof(ContainerProbeCommand));
+    ContainerProbeArray_init(executor->probes);
+
+    executor->thread = furi_thread_alloc_ex(
+        "ContainerProbe", CONTAINER_PROBE_STACK_SIZE, container_probe_thread, executor);
+    furi_thread_start(executor->thread);
+
+    return executor;
+}
+
+void container_probe_executor_free(ContainerProbeExecutor* executor) {
+    furi_check(executor);
+
+    ContainerProbeCommand command = {.type = ContainerProbeCommandStop};
+    furi_check(
+        furi_message_queue_put(executor->queue, &command, FuriWaitForever) == FuriStatusOk);
+    furi_thread_join(executor->thread);
+    furi_thread_free(executor->thread);
+
+    // Commands sent after the loop stopped still own their copies
+    while(furi_message_queue_get(executor->queue, &command, 0) == FuriStatusOk) {
+        if(command.type == ContainerProbeCommandWatch) free((void*)command.spec.command);
+    }
+
+    ContainerProbeArray_clear(executor->probes);
+    furi_message_queue_free(executor->queue);
+    free(executor);
+}
+
+void container_probe_executor_watch(
+    ContainerProbeExecutor* executor,
+    ContainerId container,
+    const HealthCheckSpec* spec) {
+    furi_check(executor);
+    furi_check(spec);
+
+    if(spec->type != HealthCheckTypeCommand || !spec->command) {
+        if(spec->type != HealthCheckTypeNone) {
+            FURI_LOG_W(TAG, "%lX: only command health checks are supported", container);
+        }
+        return;
+    }
+
+    ContainerProbeCommand command = {
+        .type = ContainerProbeCommandWatch,
+        .container = container,
+        .spec = *spec,
+    };
+    command.spec.command = strdup(spec->command);
+    if(!command.spec.period_ms) command.spec.period_ms = CONTAINER_PROBE_DEFAULT_PERIOD_MS;
+    if(!command.spec.timeout_ms) command.spec.timeout_ms = CONTAINER_PROBE_DEFAULT_TIMEOUT_MS;
+    if(!command.spec.success_threshold) command.spec.success_threshold = 1;
+    if(!command.spec.failure_threshold) {
+        command.spec.failure_threshold = CONTAINER_PROBE_DEFAULT_FAILURES;
+    }
+
+    // Executor never waits for the caller, so this can't deadlock
+    furi_check(
+        furi_message_queue_put(executor->queue, &command, FuriWaitForever) == FuriStatusOk);
+}
+
+void container_probe_executor_unwatch(ContainerProbeExecutor* executor, ContainerId container) {
+    furi_check(executor);
+
+    ContainerProbeCommand command = {
+        .type = ContainerProbeCommandUnwatch,
+        .container = container,
+    };
+    furi_check(
+        furi_message_queue_put(executor->queue, &command, FuriWaitForever) == FuriStatusOk);
+}
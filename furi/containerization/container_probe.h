@@ -0,0 +1,77 @@
+#pragma once
+
+#include <furi.h>
+#include "container_runtime.h"
+
+/**
+ * @brief Health check executor
+ *
+ * Runs the health checks of every container from a single thread, one event
+ * loop timer per container. Used by the container runtime.
+ *
+ * Probe callbacks run to completion on the executor thread, timeout_ms is
+ * only checked once they return. A callback that blocks stops the health
+ * checks of every container, so callbacks must not block.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct ContainerProbeExecutor ContainerProbeExecutor;
+
+/**
+ * @brief Container crossed its failure threshold
+ *
+ * Called from the executor thread, must not block on the container runtime.
+ * Probing goes on, the callback is called again after the next
+ * failure_threshold failures.
+ *
+ * @param container
+ * @param context
+ */
+typedef void (*ContainerProbeFailureCallback)(ContainerId container, void* context);
+
+/**
+ * @brief Allocate an executor and start its thread
+ *
+ * @param callback
+ * @param context
+ * @return ContainerProbeExecutor*
+ */
+ContainerProbeExecutor*
+    container_probe_executor_alloc(ContainerProbeFailureCallback callback, void* context);
+
+/**
+ * @brief Stop the executor thread and free the executor
+ *
+ * @param executor
+ */
+void container_probe_executor_free(ContainerProbeExecutor* executor);
+
+/**
+ * @brief Start probing a container
+ *
+ * Replaces an earlier health check of the container. Unset spec fields take
+ * the Kubernetes defaults.
+ *
+ * @param executor
+ * @param container
+ * @param spec health check, copied
+ */
+void container_probe_executor_watch(
+    ContainerProbeExecutor* executor,
+    ContainerId container,
+    const HealthCheckSpec* spec);
+
+/**
+ * @brief Stop probing a container
+ *
+ * @param executor
+ * @param container
+ */
+void container_probe_executor_unwatch(ContainerProbeExecutor* executor, ContainerId container);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,473 +1,2198 @@
 #include "container_runtime.h"
+#include "container_runtime_i.h"
 #include <furi.h>
 #include <furi/core/mutex.h>
 #include <furi/core/thread.h>
+#include <furi/core/thread_list.h>
 #include <furi/core/timer.h>
 #include <furi/core/log.h>
+#include <furi_hal.h>
 #include <applications/services/loader/loader.h>
+#include <loader/firmware_api/firmware_api.h>
+#include <flipper_application/flipper_application.h>
 #include <storage/storage.h>
+#include <m-array.h>
+#include <m-dict.h>
+#include <toolbox/stream/file_stream.h>
+#include <toolbox/stream/string_stream.h>
+#include "containerization.h"
+#include "container_probe.h"
 #include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 
 #define TAG "ContainerRT"
 
-// Reduced maximum number of containers to conserve memory
-#define MAX_CONTAINERS 5  // Reduced from 8 to save memory
-#define CONTAINER_POOL_SIZE 3  // Pre-allocated container handles
+// Container records are allocated in slabs that never move, so Container
+// pointers stay valid for the lifetime of the record
+#define CONTAINER_SLAB_SIZE 4
+
+// Free heap left to applications when growing the container table
+#define CONTAINER_SLAB_MIN_FREE_HEAP (8 * 1024)
+
+// ContainerId: record index in the low half, record generation in the high half
+#define CONTAINER_ID_INDEX(id)      ((id) & 0xFFFF)
+#define CONTAINER_ID_GENERATION(id) ((id) >> 16)
+#define CONTAINER_ID(index, generation) (((uint32_t)(generation) << 16) | (index))
+#define CONTAINER_RECORD_NONE 0xFFFF
+
+// Scheduler periods a container may stay above its memory limit after being
+// asked to exit, before it is killed
+#define CONTAINER_MEMORY_LIMIT_GRACE_PERIODS 3
+
+// How long forced stop waits for the container thread to exit
+#define CONTAINER_STOP_TIMEOUT_MS 1000
+
+// Resource sampling period, also how often due restarts are checked
+#define CONTAINER_SCHEDULER_PERIOD_MS 1000
+
+// Worker loads FAP images like the Loader does on 2 KB, runtime frames come on top
+#define CONTAINER_WORKER_STACK_SIZE (3 * 1024)
+
+typedef enum {
+    ContainerWorkerFlagStart = (1 << 0), // Containers wait for admission or a restart
+    ContainerWorkerFlagStop = (1 << 1),
+    ContainerWorkerFlagAll = ContainerWorkerFlagStart | ContainerWorkerFlagStop,
+} ContainerWorkerFlag;
+
+// Free heap below which warm images are evicted
+#define CONTAINER_WARM_IMAGE_MIN_FREE_HEAP (16 * 1024)
+
+// Application state of checkpointed containers, one file per container
+#define CONTAINER_CHECKPOINT_DIR EXT_PATH(".tmp/containers")
+
+// Volumes of a pod are shared by its containers, /ext/pods/<pod>/<volume>
+#define CONTAINER_VOLUME_DIR EXT_PATH("pods")
+
+// Stack of containers running a firmware entry point
+#define CONTAINER_ENTRY_POINT_STACK_SIZE 1024
+
+// Number of scheduler ticks CPU usage is averaged over
+#define CONTAINER_CPU_WINDOW 8
 
 typedef struct Container {
     ContainerConfig config;
     ContainerStatus status;
+    ContainerRuntime* runtime;
     void* app_handle;
-    uint32_t last_health_check; // Timestamps to avoid checking too frequently
+    FlipperApplication* fap; // Image loaded by the runtime, NULL for built-ins
+    FlipperApplication* preloaded; // Image preloaded by the creator, used on first start
+    FlipperApplicationWarmImage* warm_image; // Parsed image kept for restarts
+    uint32_t warm_image_timestamp; // Image file timestamp the warm image was recorded from
+    size_t warm_image_size;
+    FuriThread* thread; // Main thread of the image, NULL for built-ins
+    ContainerId id; // Generation counted handle, also tags every container thread
+    uint16_t generation; // Bumped when the record is freed, survives reuse
+    uint16_t next_free; // Next free record while on the free list
+    uint8_t memory_limit_strikes; // Consecutive samples above max_memory
+    uint8_t cpu_samples[CONTAINER_CPU_WINDOW]; // Per-tick CPU usage ring, percent
+    uint8_t cpu_sample_index;
+    ContainerThrottleMode throttle_mode; // Mode the container was throttled with
+    uint32_t restart_at; // Tick to restart the container at
+    uint32_t restart_backoff; // Last back-off in ms, 0 once the container ran long enough
+    uint32_t running_since; // Tick the container last entered Running at
+    ContainerCheckpointCallback checkpoint_save; // Registered by the application
+    ContainerCheckpointCallback checkpoint_restore;
+    void* checkpoint_context;
+    bool restore_pending; // Resumed from a checkpoint, restored on registration
+    uint32_t resume_started; // Tick container_resume was called at
+    uint32_t trace_start; // Tick the traced start was requested at
+    uint32_t trace_stop; // Tick the traced stop was requested at
+    bool trace_start_pending; // Image started, entry point not reached yet
+    bool trace_stop_pending; // Asked to exit, exit not recorded yet
+    bool starting; // Admitted, image is being loaded without the lock
+    bool stop_requested; // Stopped while starting, the started image is stopped
 } Container;
 
+ARRAY_DEF(ContainerSlabArray, Container*, M_PTR_OPLIST) // NOLINT
+ARRAY_DEF(ContainerIdArray, ContainerId, M_POD_OPLIST) // NOLINT
+DICT_DEF2(ContainerIndex, const char*, M_CSTR_OPLIST, ContainerId, M_POD_OPLIST) // NOLINT
+
 struct ContainerRuntime {
     FuriMutex* mutex;
     FuriTimer* scheduler_timer;
-    Container containers[MAX_CONTAINERS];
-    uint8_t container_count;
-    uint8_t active_container_count; // Track running containers separately
+    FuriThread* worker; // Starts containers for the scheduler, off the timer thread
+    FuriThreadList* thread_list; // Reused between resource samples
+    FuriPubSubSubscription* loader_subscription; // Exit events of built-ins
+    ContainerTrace* trace; // Lifecycle events and start-up latencies
+    ContainerProbeExecutor* probes; // Started with the first health checked container
+    bool scheduler_active; // Timer only runs while there is something to sample or restart
+    ContainerThrottleMode throttle_mode;
+    ContainerSlabArray_t slabs; // CONTAINER_SLAB_SIZE records each
+    ContainerIndex_t index; // Container name to handle
+    ContainerIdArray_t start_queue; // Worker only, restarts then admissions of a pass
+    uint16_t capacity; // Records in all slabs
+    uint16_t free_head; // First free record, CONTAINER_RECORD_NONE if all are used
+    uint16_t container_count;
+    uint16_t active_container_count; // Track running containers separately
+    ContainerSchedulerStats scheduler_stats;
     bool running;
-    ContainerHandle* recycled_container_pool; // Memory pool for container handles
-    ContainerHandle container_handle_pool[CONTAINER_POOL_SIZE]; // Static allocation
-    uint8_t next_free_handle_index;
 };
 
-// Memory-efficient container health checker - check less frequently
-static void container_check_health(Container* container) {
-    // Only check every 5 seconds to reduce CPU usage
-    uint32_t current_time = furi_get_tick();
-    if(current_time - container->last_health_check < 5000) {
-        return;
+static Container* container_runtime_record(ContainerRuntime* runtime, uint16_t index) {
+    return *ContainerSlabArray_get(runtime->slabs, index / CONTAINER_SLAB_SIZE) +
+           index % CONTAINER_SLAB_SIZE;
+}
+
+// Add a slab of records if the heap can spare it
+static bool container_runtime_grow(ContainerRuntime* runtime) {
+    const size_t slab_size = sizeof(Container) * CONTAINER_SLAB_SIZE;
+    if(runtime->capacity + CONTAINER_SLAB_SIZE > CONTAINER_RECORD_NONE ||
+       memmgr_get_free_heap() < slab_size + CONTAINER_SLAB_MIN_FREE_HEAP) {
+        return false;
     }
-    container->last_health_check = current_time;
-    
-    if(!container || container->status.state != ContainerStateRunning) {
-        return;
+
+    Container* slab = malloc(slab_size);
+    memset(slab, 0, slab_size);
+    ContainerSlabArray_push_back(runtime->slabs, slab);
+
+    // Link new records in index order in front of the free list
+    for(uint16_t i = CONTAINER_SLAB_SIZE; i > 0; i--) {
+        slab[i - 1].generation = 1;
+        slab[i - 1].next_free = runtime->free_head;
+        runtime->free_head = runtime->capacity + i - 1;
     }
-    
-    Loader* loader = furi_record_open(RECORD_LOADER);
-    bool app_running = false;
-    
-    if(strstr(container->config.image, ".fap") != NULL) {
-        // External FAP app
-        app_running = loader_is_app_running(loader, container->config.image);
+    runtime->capacity += CONTAINER_SLAB_SIZE;
+
+    return true;
+}
+
+static Container* container_runtime_alloc_record(ContainerRuntime* runtime) {
+    if(runtime->free_head == CONTAINER_RECORD_NONE && !container_runtime_grow(runtime)) {
+        return NULL;
+    }
+
+    const uint16_t index = runtime->free_head;
+    Container* container = container_runtime_record(runtime, index);
+    runtime->free_head = container->next_free;
+
+    const uint16_t generation = container->generation;
+    memset(container, 0, sizeof(Container));
+    container->generation = generation;
+    container->id = CONTAINER_ID(index, generation);
+
+    return container;
+}
+
+// Stale handles of the record stop resolving once the generation moves on
+static void container_runtime_free_record(ContainerRuntime* runtime, Container* container) {
+    const uint16_t index = CONTAINER_ID_INDEX(container->id);
+    uint16_t generation = container->generation + 1;
+    if(generation == 0) generation = 1;
+
+    memset(container, 0, sizeof(Container));
+    container->generation = generation;
+    container->next_free = runtime->free_head;
+    runtime->free_head = index;
+}
+
+// Must be called with the lock held
+static Container* container_runtime_resolve(ContainerRuntime* runtime, ContainerId id) {
+    const uint16_t index = CONTAINER_ID_INDEX(id);
+    if(id == CONTAINER_ID_INVALID || index >= runtime->capacity) return NULL;
+
+    Container* container = container_runtime_record(runtime, index);
+    if(!container->config.name || container->id != id) return NULL;
+
+    return container;
+}
+
+// Make sure count more containers can be created without growing the table
+static bool container_runtime_reserve(ContainerRuntime* runtime, size_t count) {
+    bool success = true;
+
+    furi_mutex_acquire(runtime->mutex, FuriWaitForever);
+    while(success && runtime->capacity - runtime->container_count < count) {
+        success = container_runtime_grow(runtime);
+    }
+    furi_mutex_release(runtime->mutex);
+
+    return success;
+}
+
+static bool container_is_fap(const Container* container) {
+    return !container->config.entry_point && strstr(container->config.image, ".fap") != NULL;
+}
+
+static void container_trace(
+    Container* container,
+    ContainerTraceEventType type,
+    uint32_t timestamp,
+    int32_t value) {
+    container_trace_record(
+        container->runtime->trace, container->id, container->config.image, type, timestamp, value);
+}
+
+// Init ticks are set by the container thread, checked until the entry point is reached
+static void container_trace_first_tick(Container* container) {
+    if(!container->trace_start_pending || !container->fap) return;
+
+    const FlipperApplicationLoadTimes* times = flipper_application_get_load_times(container->fap);
+    if(!times->init_end) return;
+
+    container_trace(
+        container, ContainerTraceEventInit, times->init_end, times->init_end - times->init_start);
+    container_trace(
+        container,
+        ContainerTraceEventFirstTick,
+        times->init_end,
+        times->init_end - container->trace_start);
+    container->trace_start_pending = false;
+}
+
+// Exit of a container thread or built-in, stop if it was asked to exit
+static void container_trace_exit(Container* container, int32_t return_code) {
+    const uint32_t now = furi_get_tick();
+
+    if(container->trace_stop_pending) {
+        container_trace(container, ContainerTraceEventStop, now, now - container->trace_stop);
+        container->trace_stop_pending = false;
     } else {
-        // Built-in app
-        app_running = loader_is_locked(loader);
+        container_trace(container, ContainerTraceEventCrash, now, return_code);
     }
-    
-    furi_record_close(RECORD_LOADER);
-    
-    if(!app_running && container->status.state == ContainerStateRunning) {
-        container->status.state = ContainerStateTerminated;
+}
+
+// Tick only while containers run or wait for a restart, idle runtime never wakes up
+static void container_runtime_update_scheduler(ContainerRuntime* runtime) {
+    if(!runtime->running) return;
+
+    bool needed = runtime->active_container_count > 0;
+    for(uint16_t i = 0; i < runtime->capacity && !needed; i++) {
+        const Container* container = container_runtime_record(runtime, i);
+        needed = container->status.restart_pending || container->status.admission_pending;
+    }
+
+    if(needed && !runtime->scheduler_active) {
+        furi_timer_start(runtime->scheduler_timer, CONTAINER_SCHEDULER_PERIOD_MS);
+    } else if(!needed && runtime->scheduler_active) {
+        furi_timer_stop(runtime->scheduler_timer);
     }
+    runtime->scheduler_active = needed;
 }
 
-// Enhanced scheduler callback with health checking
-static void container_runtime_scheduler_callback(void* context) {
-    ContainerRuntime* runtime = context;
-    
-    if(!furi_mutex_acquire(runtime->mutex, 0)) return;
+static void container_runtime_probe_failed(ContainerId id, void* context);
 
-    for(uint8_t i = 0; i < MAX_CONTAINERS; i++) {
-        Container* container = &runtime->containers[i];
-        
-        // Skip empty slots
-        if(container->config.name == NULL) continue;
-        
-        // Check health first
-        container_check_health(container);
-        
-        // Update uptime for running containers
+// Health checks only run while the container is running
+static void container_update_probe(Container* container, bool running) {
+    ContainerRuntime* runtime = container->runtime;
+    const HealthCheckSpec* health_check = &container->config.health_check;
+
+    if(health_check->type == HealthCheckTypeNone) return;
+
+    if(running) {
+        if(!runtime->probes) {
+            runtime->probes =
+                container_probe_executor_alloc(container_runtime_probe_failed, runtime);
+        }
+        container_probe_executor_watch(runtime->probes, container->id, health_check);
+    } else if(runtime->probes) {
+        container_probe_executor_unwatch(runtime->probes, container->id);
+    }
+}
+
+// Pod and volume names become directory names
+static bool container_volume_name_is_valid(const char* name) {
+    return name && *name && !strchr(name, '/') && strcmp(name, ".") != 0 &&
+           strcmp(name, "..") != 0;
+}
+
+static bool container_mount_volumes(const Container* container, Storage* storage) {
+    const ContainerConfig* config = &container->config;
+    if(!config->volume_mount_count) return true;
+
+    if(!container_volume_name_is_valid(config->pod)) {
+        FURI_LOG_E(TAG, "%s: volumes need a valid pod name", config->name);
+        return false;
+    }
+
+    StorageMount* mounts = malloc(sizeof(StorageMount) * config->volume_mount_count);
+    FuriString** targets = malloc(sizeof(FuriString*) * config->volume_mount_count);
+    bool success = true;
+
+    storage_simply_mkdir(storage, CONTAINER_VOLUME_DIR);
+    FuriString* pod_dir = furi_string_alloc_printf("%s/%s", CONTAINER_VOLUME_DIR, config->pod);
+    storage_simply_mkdir(storage, furi_string_get_cstr(pod_dir));
+
+    for(uint32_t i = 0; i < config->volume_mount_count; i++) {
+        const VolumeMountSpec* volume = &config->volume_mounts[i];
+        targets[i] = furi_string_alloc_printf(
+            "%s/%s", furi_string_get_cstr(pod_dir), volume->name ? volume->name : "");
+        if(!container_volume_name_is_valid(volume->name)) {
+            FURI_LOG_E(TAG, "%s: invalid volume name", config->name);
+            success = false;
+        } else if(!storage_simply_mkdir(storage, furi_string_get_cstr(targets[i]))) {
+            FURI_LOG_E(TAG, "%s: can't create volume %s", config->name, volume->name);
+            success = false;
+        }
+
+        mounts[i].path = volume->mount_path;
+        mounts[i].target = furi_string_get_cstr(targets[i]);
+        mounts[i].read_only = volume->read_only;
+    }
+
+    // Rejects paths that aren't a single top level directory
+    if(success) {
+        success = storage_mounts_set(storage, container->id, mounts, config->volume_mount_count);
+        if(!success) FURI_LOG_E(TAG, "%s: invalid mount path", config->name);
+    }
+
+    for(uint32_t i = 0; i < config->volume_mount_count; i++) {
+        furi_string_free(targets[i]);
+    }
+    furi_string_free(pod_dir);
+    free(targets);
+    free(mounts);
+
+    return success;
+}
+
+// Storage counts and limits I/O of every thread tagged with the container id
+// and remaps the paths of its volumes
+static bool container_update_storage(const Container* container, bool registered) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    bool success = true;
+    if(registered) {
+        success = container_mount_volumes(container, storage);
+        if(success) {
+            storage_io_account_set(
+                storage, container->id, container->config.resource_limits.io_bytes_per_second);
+        }
+    } else {
+        storage_mounts_remove(storage, container->id);
+        storage_io_account_remove(storage, container->id);
+    }
+    furi_record_close(RECORD_STORAGE);
+    return success;
+}
+
+// Strings and volumes copied by container_create_common
+static void container_free_config(ContainerConfig* config) {
+    free((void*)config->name);
+    free((void*)config->image);
+    if(config->health_check.type != HealthCheckTypeNone) {
+        free((void*)config->health_check.command);
+    }
+    free((void*)config->pod);
+    for(uint32_t i = 0; i < config->volume_mount_count; i++) {
+        free((void*)config->volume_mounts[i].name);
+        free((void*)config->volume_mounts[i].mount_path);
+    }
+    free((void*)config->volume_mounts);
+}
+
+// Keep running container counter in sync with state transitions
+static void container_set_state(Container* container, ContainerState state) {
+    ContainerRuntime* runtime = container->runtime;
+
+    if(container->status.state == state) return;
+
+    if(state == ContainerStateRunning) {
+        runtime->active_container_count++;
+        container->running_since = furi_get_tick();
+        container_update_probe(container, true);
+    } else if(container->status.state == ContainerStateRunning) {
+        if(runtime->active_container_count > 0) runtime->active_container_count--;
+        // Last run stays reported until the next one
+        container->status.uptime =
+            (furi_get_tick() - container->running_since) / furi_kernel_get_tick_frequency();
+        container_update_probe(container, false);
+    }
+
+    container->status.state = state;
+    container_runtime_update_scheduler(runtime);
+}
+
+// Release image of a container whose main thread has exited
+static void container_release_image(Container* container) {
+    if(container->fap) {
+        // Joins and frees the main thread as well
+        flipper_application_free(container->fap);
+        container->fap = NULL;
+        container->thread = NULL;
+    } else if(container->thread) {
+        // Entry point thread, already stopped
+        furi_thread_join(container->thread);
+        furi_thread_free(container->thread);
+        container->thread = NULL;
+    }
+    container->app_handle = NULL;
+    // Application state is gone with the image
+    container->checkpoint_save = NULL;
+    container->checkpoint_restore = NULL;
+    container->checkpoint_context = NULL;
+}
+
+static ContainerExitReason container_exit_reason(const Container* container, int32_t exit_code) {
+    if(container->status.oom_killed) return ContainerExitReasonOOMKilled;
+    if(container->status.unhealthy) return ContainerExitReasonUnhealthy;
+    if(container->status.untraced) return ContainerExitReasonUntraced;
+    return exit_code ? ContainerExitReasonError : ContainerExitReasonCompleted;
+}
+
+static bool container_should_restart(const Container* container, ContainerExitReason reason) {
+    switch(container->config.restart_policy) {
+    case ContainerRestartPolicyAlways:
+        return true;
+    case ContainerRestartPolicyOnFailure:
+        return reason != ContainerExitReasonCompleted;
+    default:
+        return false;
+    }
+}
+
+uint32_t container_restart_backoff_next(uint32_t backoff, uint32_t running_ticks) {
+    // Crash loop is over once a run lasts
+    if(running_ticks >= furi_ms_to_ticks(CONTAINER_RESTART_BACKOFF_RESET_MS)) {
+        backoff = 0;
+    }
+
+    return backoff ? MIN(backoff * 2, (uint32_t)CONTAINER_RESTART_BACKOFF_MAX_MS) :
+                     CONTAINER_RESTART_BACKOFF_MIN_MS;
+}
+
+uint32_t container_restart_delay(uint32_t backoff, uint32_t random) {
+    return backoff - random % (backoff / 4 + 1);
+}
+
+// Running container exited on its own, must be called with the runtime mutex held
+static void
+    container_exited(Container* container, ContainerExitReason reason, int32_t exit_code) {
+    ContainerRuntime* runtime = container->runtime;
+
+    container_set_state(container, ContainerStateTerminated);
+    container->status.exit_reason = reason;
+    container->status.exit_code = exit_code;
+
+    if(!container_should_restart(container, reason)) {
+        container->restart_backoff = 0;
+        return;
+    }
+
+    // A failed start never ran at all
+    const uint32_t now = furi_get_tick();
+    const uint32_t running_ticks =
+        reason == ContainerExitReasonStartFailed ? 0 : now - container->running_since;
+    container->restart_backoff =
+        container_restart_backoff_next(container->restart_backoff, running_ticks);
+
+    const uint32_t delay =
+        container_restart_delay(container->restart_backoff, furi_hal_random_get());
+    FURI_LOG_I(TAG, "%s: restarting in %lums", container->config.name, delay);
+
+    container->restart_at = now + furi_ms_to_ticks(delay);
+    container->status.restart_pending = true;
+    container_runtime_update_scheduler(runtime);
+}
+
+// Runs in the timer thread: image can't be released from the thread scrubber
+static void container_thread_exited(void* context, uint32_t arg) {
+    UNUSED(arg);
+    Container* container = context;
+    ContainerRuntime* runtime = container->runtime;
+
+    furi_check(furi_mutex_acquire(runtime->mutex, FuriWaitForever) == FuriStatusOk);
+
+    // Container may have been stopped and released already
+    if(container->thread && furi_thread_get_state(container->thread) == FuriThreadStateStopped) {
+        const int32_t return_code = furi_thread_get_return_code(container->thread);
+        FURI_LOG_I(TAG, "%s exited: %li", container->config.name, return_code);
+        container_trace_first_tick(container);
+        container->trace_start_pending = false;
+        container_trace_exit(container, return_code);
+        container_release_image(container);
         if(container->status.state == ContainerStateRunning) {
-            container->status.uptime++;
-            
-            // Minimal resource usage sampling - avoid frequent calls to save CPU
-            if(container->status.uptime % 10 == 0) { // Every 10 seconds
-                // Estimate memory usage - very lightweight approximation
-                container->status.memory_used = container->config.resource_limits.max_memory / 2;
-                
-                // Set CPU usage to a simple estimate
-                container->status.cpu_usage = container->config.resource_limits.cpu_time_share / 2;
-            }
+            container_exited(
+                container, container_exit_reason(container, return_code), return_code);
         }
-        
-        // Auto-restart containers that crashed but should be restarted
-        if(container->config.restart_on_crash && 
-           container->status.state == ContainerStateTerminated) {
-            
-            // Add exponential backoff for restarts to prevent rapid cycling
-            uint32_t delay_factor = container->status.restart_count > 5 ? 5 : container->status.restart_count;
-            if(container->status.restart_count == 0 || 
-               (container->status.uptime > delay_factor * delay_factor)) {
-                container_start(container);
-                container->status.restart_count++;
-            }
+    }
+
+    furi_mutex_release(runtime->mutex);
+}
+
+static void
+    container_thread_state_callback(FuriThread* thread, FuriThreadState state, void* context) {
+    UNUSED(thread);
+
+    if(state == FuriThreadStateStopped) {
+        furi_timer_pending_callback(container_thread_exited, context, 0);
+    }
+}
+
+static void container_loader_app_exited(void* context, uint32_t arg) {
+    UNUSED(arg);
+    ContainerRuntime* runtime = context;
+
+    furi_check(furi_mutex_acquire(runtime->mutex, FuriWaitForever) == FuriStatusOk);
+
+    // Loader runs one application at a time, so any running built-in is gone
+    for(uint16_t i = 0; i < runtime->capacity; i++) {
+        Container* container = container_runtime_record(runtime, i);
+        if(!container->config.name || container->thread || container->config.entry_point ||
+           container_is_fap(container)) {
+            continue;
+        }
+
+        if(container->status.state == ContainerStateRunning) {
+            FURI_LOG_I(TAG, "%s exited", container->config.name);
+            container->app_handle = NULL;
+            // Loader doesn't report return codes
+            container_trace_exit(container, 0);
+            container_exited(container, container_exit_reason(container, 0), 0);
+        } else if(container->trace_stop_pending) {
+            container_trace_exit(container, 0);
         }
     }
 
     furi_mutex_release(runtime->mutex);
 }
 
-// Ultra-minimal FAP existence check - skip for built-ins
-static bool container_check_local_image(const char* image_path) {
-    if(!image_path) return false;
-    
-    // Skip check for built-in apps (no .fap extension)
-    if(!strstr(image_path, ".fap")) {
-        return true;
+// Runs in the Loader thread, which must not be blocked by restarts
+static void container_loader_callback(const void* message, void* context) {
+    const LoaderEvent* event = message;
+
+    if(event->type == LoaderEventTypeApplicationStopped ||
+       event->type == LoaderEventTypeApplicationLoadFailed) {
+        furi_timer_pending_callback(container_loader_app_exited, context, 0);
     }
-    
-    // Ultra-minimal validation - just check if file exists
-    Storage* storage = furi_record_open(RECORD_STORAGE);
-    FileInfo file_info;
-    bool exists = storage_common_stat(storage, image_path, &file_info) == FSE_OK;
-    furi_record_close(RECORD_STORAGE);
-    
-    if(!exists) {
-        FURI_LOG_E(TAG, "FAP not found: %s", image_path);
+}
+
+static void container_evict_warm_image(Container* container, const char* reason) {
+    if(!container->warm_image) return;
+
+    FURI_LOG_I(
+        TAG,
+        "%s: evicting warm image, %zu bytes: %s",
+        container->config.name,
+        container->warm_image_size,
+        reason);
+    flipper_application_warm_image_free(container->warm_image);
+    container->warm_image = NULL;
+    container->warm_image_size = 0;
+}
+
+static bool container_runtime_evict_largest_warm_image(ContainerRuntime* runtime) {
+    Container* largest = NULL;
+    for(uint16_t i = 0; i < runtime->capacity; i++) {
+        Container* container = container_runtime_record(runtime, i);
+        if(container->warm_image &&
+           (!largest || container->warm_image_size > largest->warm_image_size)) {
+            largest = container;
+        }
     }
-    
-    return exists;
+
+    if(!largest) return false;
+    container_evict_warm_image(largest, "heap pressure");
+    return true;
 }
 
-ContainerRuntime* container_runtime_alloc(void) {
-    ContainerRuntime* runtime = malloc(sizeof(ContainerRuntime));
-    if(!runtime) {
-        FURI_LOG_E(TAG, "Failed to allocate runtime");
-        return NULL;
+// Evict warm images, largest first, until free heap is above min_free_heap
+static void container_runtime_evict_warm_images(ContainerRuntime* runtime, size_t min_free_heap) {
+    while(memmgr_get_free_heap() < min_free_heap &&
+          container_runtime_evict_largest_warm_image(runtime)) {
     }
-    
-    memset(runtime, 0, sizeof(ContainerRuntime));
-    
-    runtime->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
-    if(!runtime->mutex) {
-        FURI_LOG_E(TAG, "Failed to allocate mutex");
-        free(runtime);
-        return NULL;
+}
+
+// Threads belong to a container either by owner tag (images loaded by the
+// runtime) or by appid (built-ins started through the Loader)
+static bool container_owns_thread(const Container* container, const FuriThreadListItem* item) {
+    if(item->owner_tag == container->id) {
+        return true;
     }
-    
-    runtime->container_count = 0;
-    runtime->running = false;
-    
-    return runtime;
+
+    return !container->thread && item->app_id &&
+           strcmp(item->app_id, container->config.image) == 0;
 }
 
-void container_runtime_free(ContainerRuntime* runtime) {
-    furi_assert(runtime);
-    
-    // Stop the scheduler
-    if(runtime->running && runtime->scheduler_timer) {
-        furi_timer_stop(runtime->scheduler_timer);
-        furi_timer_free(runtime->scheduler_timer);
+// Suspend every thread of a container so it can no longer allocate
+static void container_freeze(Container* container, FuriThreadList* thread_list) {
+    for(size_t i = 0; i < furi_thread_list_size(thread_list); i++) {
+        FuriThreadListItem* item = furi_thread_list_get_at(thread_list, i);
+        if(container_owns_thread(container, item)) {
+            furi_thread_suspend(furi_thread_get_id(item->thread));
+        }
     }
-    
-    // Free all containers
-    for(uint8_t i = 0; i < MAX_CONTAINERS; i++) {
-        Container* container = &runtime->containers[i];
-        
-        if(container->config.name == NULL) continue;
-        
-        if(container->status.state != ContainerStateTerminated) {
-            container_stop(container, true);
+}
+
+static void container_thaw(Container* container, FuriThreadList* thread_list) {
+    for(size_t i = 0; i < furi_thread_list_size(thread_list); i++) {
+        FuriThreadListItem* item = furi_thread_list_get_at(thread_list, i);
+        if(container_owns_thread(container, item)) {
+            furi_thread_resume(furi_thread_get_id(item->thread));
         }
-        
-        // Free allocated config strings
-        if(container->config.name) free((void*)container->config.name);
-        if(container->config.image) free((void*)container->config.image);
     }
-    
-    furi_mutex_free(runtime->mutex);
-    free(runtime);
 }
 
-void container_runtime_start(ContainerRuntime* runtime) {
-    furi_assert(runtime);
-    
-    if(runtime->running) return;
-    
-    runtime->running = true;
-    
-    // Start the scheduler timer - check every 1 second (minimal overhead)
-    runtime->scheduler_timer = furi_timer_alloc(
-        container_runtime_scheduler_callback, 
-        FuriTimerTypePeriodic, 
-        runtime);
-    furi_timer_start(runtime->scheduler_timer, 1000);
+static void
+    container_set_throttled(Container* container, FuriThreadList* thread_list, bool throttled) {
+    if(throttled && !container->status.throttled) {
+        // Killed containers only keep the CPU nobody else wants until they exit
+        container->throttle_mode = container->status.oom_killed ?
+                                       ContainerThrottleModePriority :
+                                       container->runtime->throttle_mode;
+        FURI_LOG_D(TAG, "%s over CPU share, throttling", container->config.name);
+    }
+
+    // Throttling is reapplied every tick to catch newly spawned threads
+    for(size_t i = 0; i < furi_thread_list_size(thread_list); i++) {
+        FuriThreadListItem* item = furi_thread_list_get_at(thread_list, i);
+        if(!container_owns_thread(container, item)) continue;
+
+        // Never suspended: a thread holding a system lock would stall every service
+        FuriThreadId thread_id = furi_thread_get_id(item->thread);
+        if(container->throttle_mode == ContainerThrottleModePriority) {
+            if(throttled) {
+                furi_thread_override_priority(thread_id, FuriThreadPriorityLowest);
+            } else {
+                furi_thread_restore_priority(thread_id);
+            }
+        }
+    }
+
+    container->status.throttled = throttled;
+}
+
+static void
+    container_enforce_cpu_share(Container* container, FuriThreadList* thread_list, float cpu) {
+    container->cpu_samples[container->cpu_sample_index] = cpu > 100.0f ? 100 : (uint8_t)cpu;
+    container->cpu_sample_index = (container->cpu_sample_index + 1) % CONTAINER_CPU_WINDOW;
+
+    uint32_t cpu_total = 0;
+    for(size_t i = 0; i < CONTAINER_CPU_WINDOW; i++) {
+        cpu_total += container->cpu_samples[i];
+    }
+    container->status.cpu_usage = cpu_total / CONTAINER_CPU_WINDOW;
+
+    // System containers run the services everything else relies on
+    if(container->config.system_container) return;
+
+    bool over_share =
+        container->status.cpu_usage > container->config.resource_limits.cpu_time_share;
+    if((over_share && container->runtime->throttle_mode != ContainerThrottleModeNone) ||
+       container->status.oom_killed) {
+        container_set_throttled(container, thread_list, true);
+    } else if(container->status.throttled) {
+        container_set_throttled(container, thread_list, false);
+    }
+}
+
+// Exit while running counts as a crash, so the restart policy applies
+static void container_request_exit(Container* container) {
+    if(container->thread) {
+        furi_thread_signal(container->thread, FuriSignalExit, NULL);
+    } else {
+        Loader* loader = furi_record_open(RECORD_LOADER);
+        loader_signal(loader, FuriSignalExit, NULL);
+        furi_record_close(RECORD_LOADER);
+    }
+}
+
+// Runs in the timer thread, the probe executor never takes the runtime lock
+static void container_unhealthy(void* context, uint32_t arg) {
+    ContainerRuntime* runtime = context;
+
+    furi_check(furi_mutex_acquire(runtime->mutex, FuriWaitForever) == FuriStatusOk);
+
+    Container* container = container_runtime_resolve(runtime, arg);
+    if(container && container->status.state == ContainerStateRunning) {
+        FURI_LOG_W(TAG, "%s failed its health check, requesting exit", container->config.name);
+        container->status.unhealthy = true;
+        container_request_exit(container);
+    }
+
+    furi_mutex_release(runtime->mutex);
+}
+
+static void container_runtime_probe_failed(ContainerId id, void* context) {
+    furi_timer_pending_callback(container_unhealthy, context, id);
+}
+
+static void container_enforce_memory_limit(Container* container, FuriThreadList* thread_list) {
+    const uint32_t limit = container->config.resource_limits.max_memory;
+
+    if(container->status.memory_used <= limit) {
+        container->memory_limit_strikes = 0;
+        return;
+    }
+
+    if(container->memory_limit_strikes == 0) {
+        FURI_LOG_W(
+            TAG,
+            "%s exceeds memory limit: %lu > %lu, requesting exit",
+            container->config.name,
+            container->status.memory_used,
+            limit);
+        container_request_exit(container);
+    }
+
+    if(container->memory_limit_strikes > CONTAINER_MEMORY_LIMIT_GRACE_PERIODS) {
+        // Killed already, keep asking until the threads exit
+        container_request_exit(container);
+    } else if(++container->memory_limit_strikes > CONTAINER_MEMORY_LIMIT_GRACE_PERIODS) {
+        // Heap can't be reclaimed from a live thread and suspending it could
+        // leave system locks held. The container keeps running at the lowest
+        // priority until it exits, then its exit event reaps it like any other
+        // exit and the restart policy applies.
+        FURI_LOG_E(TAG, "%s killed: out of memory", container->config.name);
+        container->status.oom_killed = true;
+        container_set_throttled(container, thread_list, true);
+        container_request_exit(container);
+    }
+}
+
+// Memory of a thread without a heap trace slot is unknown, so the container
+// can't be held to its limit and has to go
+static void container_enforce_heap_trace(Container* container) {
+    if(!container->status.untraced) {
+        FURI_LOG_E(
+            TAG, "%s has a thread without heap trace, requesting exit", container->config.name);
+        container->status.untraced = true;
+    }
+    container_request_exit(container);
+}
+
+// Sum live heap and CPU usage of all container threads, heap is only known for
+// threads with heap trace enabled
+static void container_runtime_sample_resources(ContainerRuntime* runtime) {
+    if(!furi_thread_enumerate(runtime->thread_list)) return;
+
+    for(uint16_t i = 0; i < runtime->capacity; i++) {
+        Container* container = container_runtime_record(runtime, i);
+        if(container->config.name == NULL) continue;
+        if(container->status.state != ContainerStateRunning) continue;
+
+        uint32_t memory_used = 0;
+        float cpu = 0.0f;
+        bool untraced = false;
+        for(size_t j = 0; j < furi_thread_list_size(runtime->thread_list); j++) {
+            FuriThreadListItem* item = furi_thread_list_get_at(runtime->thread_list, j);
+            if(container_owns_thread(container, item)) {
+                memory_used += item->heap;
+                cpu += item->cpu;
+                untraced |= item->heap_untraced;
+            }
+        }
+
+        if(untraced) container_enforce_heap_trace(container);
+
+        container_enforce_cpu_share(container, runtime->thread_list, cpu);
+
+        container->status.memory_used = memory_used;
+        if(memory_used > container->status.memory_peak) {
+            container->status.memory_peak = memory_used;
+        }
+
+        // Warm image shares the container budget, live heap takes precedence
+        if(container->warm_image &&
+           memory_used + container->warm_image_size > container->config.resource_limits.max_memory) {
+            container_evict_warm_image(container, "memory limit");
+        }
+
+        container_enforce_memory_limit(container, runtime->thread_list);
+    }
+}
+
+static bool container_restart_due(const Container* container, uint32_t now) {
+    return container->status.restart_pending && (int32_t)(now - container->restart_at) >= 0;
+}
+
+static bool container_start_begin(Container* container);
+static bool container_start_run(Container* container, bool restart);
+static bool container_resume_begin(Container* container);
+
+// Admission retry of a queued container. Looked up again, it may have been
+// stopped or deleted since it was queued.
+static void container_runtime_admit_pending(ContainerRuntime* runtime, ContainerId id) {
+    furi_check(furi_mutex_acquire(runtime->mutex, FuriWaitForever) == FuriStatusOk);
+    Container* container = container_runtime_resolve(runtime, id);
+    if(!container || !container->status.admission_pending) {
+        furi_mutex_release(runtime->mutex);
+        return;
+    }
+
+    const bool admitted = container->status.checkpointed ? container_resume_begin(container) :
+                                                           container_start_begin(container);
+    furi_mutex_release(runtime->mutex);
+
+    if(admitted) {
+        container_start_run(container, false);
+    }
+}
+
+// Restart of a queued container, skipped if it was stopped or deleted since
+static void container_runtime_restart(ContainerRuntime* runtime, ContainerId id) {
+    furi_check(furi_mutex_acquire(runtime->mutex, FuriWaitForever) == FuriStatusOk);
+    Container* container = container_runtime_resolve(runtime, id);
+    if(!container || !container_restart_due(container, furi_get_tick())) {
+        furi_mutex_release(runtime->mutex);
+        return;
+    }
+
+    container->status.restart_pending = false;
+    container->status.restart_count++;
+    const bool admitted = container_start_begin(container);
+    if(!admitted && !container->status.admission_pending) {
+        container_exited(container, ContainerExitReasonStartFailed, 0);
+    }
+    furi_mutex_release(runtime->mutex);
+
+    if(admitted) {
+        container_start_run(container, true);
+    }
+}
+
+// Image loads need a large stack and take long, the timer thread has neither
+static int32_t container_runtime_worker(void* context) {
+    ContainerRuntime* runtime = context;
+
+    while(true) {
+        const uint32_t flags =
+            furi_thread_flags_wait(ContainerWorkerFlagAll, FuriFlagWaitAny, FuriWaitForever);
+        furi_check((flags & FuriFlagError) == 0);
+
+        if(flags & ContainerWorkerFlagStop) break;
+
+        // Queued under the lock, started without it
+        furi_check(furi_mutex_acquire(runtime->mutex, FuriWaitForever) == FuriStatusOk);
+
+        ContainerIdArray_reset(runtime->start_queue);
+        const uint32_t now = furi_get_tick();
+        for(uint16_t i = 0; i < runtime->capacity; i++) {
+            Container* container = container_runtime_record(runtime, i);
+            if(container->config.name && container_restart_due(container, now)) {
+                ContainerIdArray_push_back(runtime->start_queue, container->id);
+            }
+        }
+
+        furi_mutex_release(runtime->mutex);
+
+        for(size_t i = 0; i < ContainerIdArray_size(runtime->start_queue); i++) {
+            container_runtime_restart(runtime, *ContainerIdArray_get(runtime->start_queue, i));
+        }
+
+        furi_check(furi_mutex_acquire(runtime->mutex, FuriWaitForever) == FuriStatusOk);
+
+        // Highest class first, so preempted containers can't take the room back
+        ContainerIdArray_reset(runtime->start_queue);
+        for(int32_t priority_class = ContainerPriorityClassSystem; priority_class >= 0;
+            priority_class--) {
+            for(uint16_t i = 0; i < runtime->capacity; i++) {
+                Container* container = container_runtime_record(runtime, i);
+                if(container->config.name && container->status.admission_pending &&
+                   container->config.priority_class == (ContainerPriorityClass)priority_class) {
+                    ContainerIdArray_push_back(runtime->start_queue, container->id);
+                }
+            }
+        }
+
+        furi_mutex_release(runtime->mutex);
+
+        for(size_t i = 0; i < ContainerIdArray_size(runtime->start_queue); i++) {
+            container_runtime_admit_pending(
+                runtime, *ContainerIdArray_get(runtime->start_queue, i));
+        }
+
+        furi_check(furi_mutex_acquire(runtime->mutex, FuriWaitForever) == FuriStatusOk);
+        container_runtime_update_scheduler(runtime);
+        furi_mutex_release(runtime->mutex);
+    }
+
+    return 0;
+}
+
+// Exits are reported by thread and Loader events, the scheduler only samples
+// resources of running containers and hands due starts to the worker
+static void container_runtime_scheduler_callback(void* context) {
+    ContainerRuntime* runtime = context;
+    
+    if(furi_mutex_acquire(runtime->mutex, 0) != FuriStatusOk) return;
+    const uint32_t pass_start = DWT->CYCCNT;
+
+    if(runtime->active_container_count) {
+        container_runtime_sample_resources(runtime);
+    }
+
+    container_runtime_evict_warm_images(runtime, CONTAINER_WARM_IMAGE_MIN_FREE_HEAP);
+
+    const uint32_t now = furi_get_tick();
+    bool start_pending = false;
+    for(uint16_t i = 0; i < runtime->capacity; i++) {
+        Container* container = container_runtime_record(runtime, i);
+        
+        // Skip empty slots
+        if(container->config.name == NULL) continue;
+
+        container_trace_first_tick(container);
+        start_pending |= container->status.admission_pending ||
+                         container_restart_due(container, now);
+    }
+
+    if(start_pending) {
+        furi_thread_flags_set(furi_thread_get_id(runtime->worker), ContainerWorkerFlagStart);
+    }
+
+    container_runtime_update_scheduler(runtime);
+
+    ContainerSchedulerStats* stats = &runtime->scheduler_stats;
+    const uint32_t pass_us =
+        (DWT->CYCCNT - pass_start) / furi_hal_cortex_instructions_per_microsecond();
+    stats->runs++;
+    stats->total_us += pass_us;
+    if(pass_us > stats->max_us) stats->max_us = pass_us;
+
+    furi_mutex_release(runtime->mutex);
+}
+
+// Ultra-minimal FAP existence check - skip for built-ins
+static bool container_check_local_image(const char* image_path) {
+    if(!image_path) return false;
+    
+    // Skip check for built-in apps (no .fap extension)
+    if(!strstr(image_path, ".fap")) {
+        return true;
+    }
+    
+    // Ultra-minimal validation - just check if file exists
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FileInfo file_info;
+    bool exists = storage_common_stat(storage, image_path, &file_info) == FSE_OK;
+    furi_record_close(RECORD_STORAGE);
+    
+    if(!exists) {
+        FURI_LOG_E(TAG, "FAP not found: %s", image_path);
+    }
+    
+    return exists;
+}
+
+ContainerRuntime* container_runtime_alloc(void) {
+    ContainerRuntime* runtime = malloc(sizeof(ContainerRuntime));
+    if(!runtime) {
+        FURI_LOG_E(TAG, "Failed to allocate runtime");
+        return NULL;
+    }
+    
+    memset(runtime, 0, sizeof(ContainerRuntime));
+    
+    // Recursive: admission stops preempted containers while holding the lock
+    runtime->mutex = furi_mutex_alloc(FuriMutexTypeRecursive);
+    if(!runtime->mutex) {
+        FURI_LOG_E(TAG, "Failed to allocate mutex");
+        free(runtime);
+        return NULL;
+    }
+    
+    runtime->thread_list = furi_thread_list_alloc();
+    runtime->trace = container_trace_alloc();
+    runtime->throttle_mode = ContainerThrottleModePriority;
+    ContainerSlabArray_init(runtime->slabs);
+    ContainerIndex_init(runtime->index);
+    ContainerIdArray_init(runtime->start_queue);
+    runtime->free_head = CONTAINER_RECORD_NONE;
+    runtime->container_count = 0;
+    runtime->running = false;
+    
+    return runtime;
+}
+
+void container_runtime_free(ContainerRuntime* runtime) {
+    furi_assert(runtime);
+    
+    // Stop the scheduler
+    if(runtime->running && runtime->scheduler_timer) {
+        furi_timer_stop(runtime->scheduler_timer);
+        furi_timer_free(runtime->scheduler_timer);
+    }
+
+    // Waits for a start in progress
+    if(runtime->worker) {
+        furi_thread_flags_set(furi_thread_get_id(runtime->worker), ContainerWorkerFlagStop);
+        furi_thread_join(runtime->worker);
+        furi_thread_free(runtime->worker);
+    }
+
+    if(runtime->loader_subscription) {
+        Loader* loader = furi_record_open(RECORD_LOADER);
+        furi_pubsub_unsubscribe(loader_get_pubsub(loader), runtime->loader_subscription);
+        furi_record_close(RECORD_LOADER);
+    }
+    
+    // Free all containers
+    for(uint16_t i = 0; i < runtime->capacity; i++) {
+        Container* container = container_runtime_record(runtime, i);
+        
+        if(container->config.name == NULL) continue;
+        
+        if(container->status.state != ContainerStateTerminated) {
+            container_stop(container, true);
+        }
+        
+        container_update_storage(container, false);
+        container_free_config(&container->config);
+        if(container->preloaded) flipper_application_free(container->preloaded);
+        if(container->warm_image) flipper_application_warm_image_free(container->warm_image);
+    }
+    
+    ContainerIndex_clear(runtime->index);
+    ContainerIdArray_clear(runtime->start_queue);
+    for(size_t i = 0; i < ContainerSlabArray_size(runtime->slabs); i++) {
+        free(*ContainerSlabArray_get(runtime->slabs, i));
+    }
+    ContainerSlabArray_clear(runtime->slabs);
+    
+    if(runtime->probes) container_probe_executor_free(runtime->probes);
+    furi_thread_list_free(runtime->thread_list);
+    container_trace_free(runtime->trace);
+    furi_mutex_free(runtime->mutex);
+    free(runtime);
+}
+
+void container_runtime_start(ContainerRuntime* runtime) {
+    furi_assert(runtime);
+    
+    if(runtime->running) return;
+    
+    runtime->running = true;
+    
+    runtime->worker = furi_thread_alloc_ex(
+        "ContainerWorker", CONTAINER_WORKER_STACK_SIZE, container_runtime_worker, runtime);
+    furi_thread_start(runtime->worker);
+
+    // Started on demand by the first running container
+    runtime->scheduler_timer = furi_timer_alloc(
+        container_runtime_scheduler_callback, 
+        FuriTimerTypePeriodic, 
+        runtime);
+}
+
+ContainerTrace* container_runtime_get_trace(ContainerRuntime* runtime) {
+    furi_assert(runtime);
+    return runtime->trace;
+}
+
+void container_runtime_set_throttle_mode(ContainerRuntime* runtime, ContainerThrottleMode mode) {
+    furi_assert(runtime);
+
+    furi_mutex_acquire(runtime->mutex, FuriWaitForever);
+    // Release everything throttled with the previous mode
+    for(uint16_t i = 0; i < runtime->capacity; i++) {
+        Container* container = container_runtime_record(runtime, i);
+        if(container->config.name && container->status.throttled) {
+            container_set_throttled(container, runtime->thread_list, false);
+        }
+    }
+    runtime->throttle_mode = mode;
+    furi_mutex_release(runtime->mutex);
+}
+
+static Container* container_create_common(
+    ContainerRuntime* runtime,
+    const ContainerConfig* config,
+    FlipperApplication* preloaded) {
+    if(furi_mutex_acquire(runtime->mutex, FuriWaitForever) != FuriStatusOk) {
+        FURI_LOG_E(TAG, "Failed to acquire mutex");
+        return NULL;
+    }
+    
+    // Names are the lookup key of the index
+    if(ContainerIndex_get(runtime->index, config->name)) {
+        FURI_LOG_E(TAG, "Container %s already exists", config->name);
+        furi_mutex_release(runtime->mutex);
+        return NULL;
+    }
+    
+    Container* container = container_runtime_alloc_record(runtime);
+    if(!container) {
+        FURI_LOG_E(TAG, "No memory for container records");
+        furi_mutex_release(runtime->mutex);
+        return NULL;
+    }
+    
+    container->runtime = runtime;
+    container->preloaded = preloaded;
+    container->config.name = strdup(config->name);
+    container->config.image = strdup(config->image);
+    container->config.args = config->args; // Just store the pointer
+    container->config.restart_policy = config->restart_policy;
+    container->config.system_container = config->system_container;
+    container->config.warm_restart = config->warm_restart;
+    container->config.health_check = config->health_check;
+    container->config.entry_point = config->entry_point;
+    if(config->health_check.type != HealthCheckTypeNone) {
+        // Command and endpoint share the storage
+        container->config.health_check.command =
+            config->health_check.command ? strdup(config->health_check.command) : NULL;
+    }
+    container->config.pod = config->pod ? strdup(config->pod) : NULL;
+    if(config->volume_mount_count) {
+        VolumeMountSpec* volume_mounts =
+            malloc(sizeof(VolumeMountSpec) * config->volume_mount_count);
+        for(uint32_t i = 0; i < config->volume_mount_count; i++) {
+            const VolumeMountSpec* volume = &config->volume_mounts[i];
+            volume_mounts[i].name = volume->name ? strdup(volume->name) : NULL;
+            volume_mounts[i].mount_path = volume->mount_path ? strdup(volume->mount_path) : NULL;
+            volume_mounts[i].read_only = volume->read_only;
+        }
+        container->config.volume_mounts = volume_mounts;
+        container->config.volume_mount_count = config->volume_mount_count;
+    }
+    // System containers are never preempted by user pods
+    container->config.priority_class = config->system_container ?
+                                           ContainerPriorityClassSystem :
+                                           config->priority_class;
+    
+    // Use provided resource limits with ultra-minimal defaults
+    container->config.resource_limits.max_memory = 
+        config->resource_limits.max_memory > 0 ? 
+        config->resource_limits.max_memory : 2 * 1024; // Even more minimal: 2KB default
+    
+    container->config.resource_limits.cpu_time_share = 
+        config->resource_limits.cpu_time_share > 0 ?
+        config->resource_limits.cpu_time_share : 3; // Even more minimal: 3% default
+    
+    container->config.resource_limits.max_threads = 
+        config->resource_limits.max_threads > 0 ?
+        config->resource_limits.max_threads : 1; // Keep 1 thread as absolute minimum
+
+    container->config.resource_limits.io_bytes_per_second =
+        config->resource_limits.io_bytes_per_second;
+    if(!container_update_storage(container, true)) {
+        // Preloaded image stays with the caller
+        container_update_storage(container, false);
+        container_free_config(&container->config);
+        container_runtime_free_record(runtime, container);
+        furi_mutex_release(runtime->mutex);
+        return NULL;
+    }
+    
+    container->status.state = ContainerStatePending;
+    container->status.restart_count = 0;
+    container->status.uptime = 0;
+    
+    // Key is owned by the record and lives as long as the index entry
+    ContainerIndex_set_at(runtime->index, container->config.name, container->id);
+    runtime->container_count++;
+    
+    furi_mutex_release(runtime->mutex);
+    
+    return container;
+}
+
+Container* container_create(ContainerRuntime* runtime, const ContainerConfig* config) {
+    furi_assert(runtime);
+    furi_assert(config);
+    
+    if(!config->name || !config->image) {
+        FURI_LOG_E(TAG, "Invalid config");
+        return NULL;
+    }
+    
+    // Validate image exists before allocating anything
+    if(!container_check_local_image(config->image)) {
+        return NULL;
+    }
+
+    return container_create_common(runtime, config, NULL);
+}
+
+Container* container_create_preloaded(
+    ContainerRuntime* runtime,
+    const ContainerConfig* config,
+    FlipperApplication* fap) {
+    furi_assert(runtime);
+    furi_assert(config);
+
+    if(!config->name || !config->image) {
+        FURI_LOG_E(TAG, "Invalid config");
+        return NULL;
+    }
+
+    // Preloading already proved the image exists
+    return container_create_common(runtime, config, fap);
+}
+
+static void
+    container_keep_warm_image(Container* container, FlipperApplication* fap, uint32_t timestamp) {
+    FlipperApplicationWarmImage* image = flipper_application_take_warm_image(fap);
+    if(!image) return;
+
+    // Image shares the memory budget with the previous run peak
+    size_t size = flipper_application_warm_image_get_size(image);
+    if(size + container->status.memory_peak > container->config.resource_limits.max_memory) {
+        FURI_LOG_I(
+            TAG, "%s: warm image of %zu bytes doesn't fit the limit", container->config.name, size);
+        flipper_application_warm_image_free(image);
+        return;
+    }
+
+    container->warm_image = image;
+    container->warm_image_size = size;
+    container->warm_image_timestamp = timestamp;
+}
+
+// Load steps the image got through, preloaded images report the caller's preload
+static void container_trace_load(Container* container, FlipperApplication* fap) {
+    const FlipperApplicationLoadTimes* times = flipper_application_get_load_times(fap);
+
+    if(times->open_end) {
+        container_trace(
+            container,
+            ContainerTraceEventElfOpen,
+            times->open_end,
+            times->open_end - times->open_start);
+    }
+    if(times->sections_end) {
+        container_trace(
+            container,
+            ContainerTraceEventSectionLoad,
+            times->sections_end,
+            times->sections_end - times->open_end);
+    }
+    if(times->relocation_end) {
+        container_trace(
+            container,
+            ContainerTraceEventRelocation,
+            times->relocation_end,
+            times->relocation_end - times->relocation_start);
+    }
+}
+
+// Load FAP image in the runtime so that the container thread is owned and traced.
+// Loading runs without the lock, the warm image is taken off the container
+// meanwhile so the scheduler can't evict it mid-map.
+static bool container_run_fap(Container* container) {
+    ContainerRuntime* runtime = container->runtime;
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FlipperApplicationWarmImage* warm_image = NULL;
+    size_t warm_image_size = 0;
+    FuriThread* thread = NULL;
+    bool mapped = false;
+    bool success = false;
+
+    // Warm image is only valid for the file it was recorded from
+    uint32_t timestamp = 0;
+    const uint32_t stat_start = furi_get_tick();
+    if(container->config.warm_restart) {
+        storage_common_timestamp(storage, container->config.image, &timestamp);
+    }
+    const uint32_t stat_end = furi_get_tick();
+
+    furi_mutex_acquire(runtime->mutex, FuriWaitForever);
+    // Preloaded image is only good for the first start, restarts read it again
+    FlipperApplication* fap = container->preloaded;
+    container->preloaded = NULL;
+    if(container->config.warm_restart) {
+        container_trace(container, ContainerTraceEventImageStat, stat_end, stat_end - stat_start);
+        if(container->warm_image && container->warm_image_timestamp != timestamp) {
+            container_evict_warm_image(container, "image changed");
+        }
+    }
+    if(!fap) {
+        warm_image = container->warm_image;
+        warm_image_size = container->warm_image_size;
+        container->warm_image = NULL;
+        container->warm_image_size = 0;
+    }
+    furi_mutex_release(runtime->mutex);
+
+    if(warm_image) {
+        fap = flipper_application_alloc(storage, firmware_api_interface);
+        FlipperApplicationLoadStatus load_status =
+            flipper_application_map_warm_image(fap, container->config.image, warm_image);
+        if(load_status == FlipperApplicationLoadStatusSuccess) {
+            FURI_LOG_D(TAG, "%s: started from warm image", container->config.name);
+            mapped = true;
+        } else {
+            FURI_LOG_W(
+                TAG,
+                "Warm load failed, %s: %s",
+                container->config.image,
+                flipper_application_load_status_to_string(load_status));
+            FURI_LOG_I(
+                TAG,
+                "%s: evicting warm image, %zu bytes: load failed",
+                container->config.name,
+                warm_image_size);
+            flipper_application_warm_image_free(warm_image);
+            warm_image = NULL;
+            flipper_application_free(fap);
+            fap = NULL;
+        }
+    }
+
+    do {
+        if(!fap) {
+            fap = flipper_application_alloc(storage, firmware_api_interface);
+            if(container->config.warm_restart) {
+                flipper_application_record_warm_image(fap);
+            }
+
+            FlipperApplicationPreloadStatus preload_status =
+                flipper_application_preload(fap, container->config.image);
+            if(preload_status != FlipperApplicationPreloadStatusSuccess) {
+                FURI_LOG_E(
+                    TAG,
+                    "Preload failed, %s: %s",
+                    container->config.image,
+                    flipper_application_preload_status_to_string(preload_status));
+                break;
+            }
+        }
+
+        if(!mapped) {
+            FlipperApplicationLoadStatus load_status = flipper_application_map_to_memory(fap);
+            if(load_status != FlipperApplicationLoadStatusSuccess) {
+                FURI_LOG_E(
+                    TAG,
+                    "Load failed, %s: %s",
+                    container->config.image,
+                    flipper_application_load_status_to_string(load_status));
+                break;
+            }
+        }
+
+        if(flipper_application_is_plugin(fap)) {
+            FURI_LOG_E(TAG, "Plugin %s is not runnable", container->config.image);
+            break;
+        }
+
+        thread = flipper_application_alloc_thread(fap, container->config.args);
+        furi_thread_set_appid(thread, container->config.name);
+        // Every thread spawned by the app inherits the tag and the heap trace
+        furi_thread_set_owner_tag(thread, container->id);
+        furi_thread_enable_heap_trace(thread);
+        furi_thread_set_state_callback(thread, container_thread_state_callback);
+        furi_thread_set_state_context(thread, container);
+        success = true;
+    } while(false);
+
+    furi_mutex_acquire(runtime->mutex, FuriWaitForever);
+    if(fap) {
+        container_trace_load(container, fap);
+    }
+
+    // Image used for this run goes back, a fresh load may record a new one
+    if(warm_image) {
+        container->warm_image = warm_image;
+        container->warm_image_size = warm_image_size;
+        container->warm_image_timestamp = timestamp;
+    } else if(success && !mapped) {
+        container_keep_warm_image(container, fap, timestamp);
+    }
+
+    // Published before the start, the exit event takes the lock to look them up
+    if(success) {
+        container->trace_start_pending = true;
+        container->fap = fap;
+        container->thread = thread;
+        container->app_handle = fap;
+    }
+    furi_mutex_release(runtime->mutex);
+
+    if(success) {
+        furi_thread_start(thread);
+    } else {
+        flipper_application_free(fap);
+    }
+
+    furi_record_close(RECORD_STORAGE);
+    return success;
+}
+
+// Firmware entry point, started like the main thread of a FAP without an image to load
+static bool container_run_entry_point(Container* container) {
+    furi_mutex_acquire(container->runtime->mutex, FuriWaitForever);
+
+    FuriThread* thread = furi_thread_alloc_ex(
+        container->config.name,
+        CONTAINER_ENTRY_POINT_STACK_SIZE,
+        container->config.entry_point,
+        container->config.args);
+    furi_thread_set_appid(thread, container->config.name);
+    furi_thread_set_owner_tag(thread, container->id);
+    furi_thread_enable_heap_trace(thread);
+    furi_thread_set_state_callback(thread, container_thread_state_callback);
+    furi_thread_set_state_context(thread, container);
+    furi_thread_start(thread);
+
+    container->thread = thread;
+    container->app_handle = thread;
+
+    // Nothing to load, the entry point is reached right away
+    const uint32_t now = furi_get_tick();
+    container_trace(container, ContainerTraceEventInit, now, 0);
+    container_trace(container, ContainerTraceEventFirstTick, now, now - container->trace_start);
+
+    furi_mutex_release(container->runtime->mutex);
+    return true;
+}
+
+static bool container_run_app(Container* container) {
+    if(container->config.entry_point) {
+        return container_run_entry_point(container);
+    }
+
+    // We already checked that the app exists in container_create
+    if(container_is_fap(container)) {
+        return container_run_fap(container);
+    }
+
+    // Built-in application
+    ContainerRuntime* runtime = container->runtime;
+    Loader* loader = furi_record_open(RECORD_LOADER);
+
+    // Loader is only guaranteed to exist once a built-in is started
+    furi_mutex_acquire(runtime->mutex, FuriWaitForever);
+    if(!runtime->loader_subscription) {
+        runtime->loader_subscription = furi_pubsub_subscribe(
+            loader_get_pubsub(loader), container_loader_callback, runtime);
+    }
+    furi_mutex_release(runtime->mutex);
+
+    const uint32_t init_start = furi_get_tick();
+    bool success = loader_start(loader, container->config.image, container->config.args, NULL) ==
+                   LoaderStatusOk;
+    container->app_handle = (void*)1; // Placeholder for built-ins
+    furi_record_close(RECORD_LOADER);
+
+    // Loader returns once the application thread is started
+    if(success) {
+        const uint32_t init_end = furi_get_tick();
+        container_trace(container, ContainerTraceEventInit, init_end, init_end - init_start);
+        container_trace(
+            container, ContainerTraceEventFirstTick, init_end, init_end - container->trace_start);
+    }
+
+    return success;
+}
+
+static bool container_checkpoint_begin(Container* container);
+
+// Budget plus 20% for the image and runtime bookkeeping
+static size_t container_required_memory(const Container* container) {
+    const size_t max_memory = container->config.resource_limits.max_memory;
+    return max_memory + max_memory / 5;
+}
+
+// Largest block decides, total free heap says nothing on a fragmented heap
+static bool container_runtime_fits(ContainerRuntime* runtime, size_t required) {
+    // Warm images are a cache, dropped before anything is preempted
+    while(memmgr_heap_get_max_free_block() < required) {
+        if(!container_runtime_evict_largest_warm_image(runtime)) return false;
+    }
+
+    return true;
+}
+
+// FAP containers preempted earlier that are still releasing their heap
+static bool container_runtime_preemption_in_progress(ContainerRuntime* runtime) {
+    for(uint16_t i = 0; i < runtime->capacity; i++) {
+        Container* container = container_runtime_record(runtime, i);
+        if(container->config.name && container->status.preempted && container->thread) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// Lowest class first, then the largest heap user
+static Container* container_runtime_find_victim(ContainerRuntime* runtime, Container* candidate) {
+    Container* victim = NULL;
+
+    for(uint16_t i = 0; i < runtime->capacity; i++) {
+        Container* container = container_runtime_record(runtime, i);
+        if(!container->config.name || container->status.state != ContainerStateRunning ||
+           container->config.priority_class >= candidate->config.priority_class) {
+            continue;
+        }
+
+        if(!victim || container->config.priority_class < victim->config.priority_class ||
+           (container->config.priority_class == victim->config.priority_class &&
+            container->status.memory_used > victim->status.memory_used)) {
+            victim = container;
+        }
+    }
+
+    return victim;
+}
+
+// Checkpoint or stop lower priority containers until their heap would cover
+// the shortfall. Doesn't wait: the scheduler retries once they have exited.
+static bool container_runtime_preempt(ContainerRuntime* runtime, Container* candidate) {
+    const size_t required = container_required_memory(candidate);
+    size_t available = memmgr_heap_get_max_free_block();
+    bool preempted = false;
+
+    while(available < required) {
+        Container* victim = container_runtime_find_victim(runtime, candidate);
+        if(!victim) break;
+
+        FURI_LOG_W(
+            TAG,
+            "Preempting %s for %s, %zu of %zu bytes available",
+            victim->config.name,
+            candidate->config.name,
+            available,
+            required);
+
+        available += victim->status.memory_used;
+        if(!victim->checkpoint_save || !container_checkpoint_begin(victim)) {
+            container_stop(victim, false);
+        }
+
+        // Stopping clears both, victim comes back once there is room
+        victim->status.preempted = true;
+        victim->status.admission_pending = true;
+        preempted = true;
+    }
+
+    return preempted;
+}
+
+// Must be called with the lock held
+static bool container_runtime_admit(ContainerRuntime* runtime, Container* container) {
+    const size_t required = container_required_memory(container);
+
+    if(container_runtime_fits(runtime, required)) {
+        container->status.admission_pending = false;
+        container->status.preempted = false;
+        return true;
+    }
+
+    // Preempted containers and containers that preempted others wait for
+    // room, anything else fails right away
+    bool wait = container->status.preempted || container_runtime_preemption_in_progress(runtime) ||
+                container_runtime_preempt(runtime, container);
+
+    if(!container->status.admission_pending || !wait) {
+        FURI_LOG_W(
+            TAG,
+            "%s: largest free block %zu, required %zu%s",
+            container->config.name,
+            memmgr_heap_get_max_free_block(),
+            required,
+            wait ? ", waiting for memory" : "");
+    }
+
+    container->status.admission_pending = wait;
+    container_runtime_update_scheduler(runtime);
+
+    return false;
+}
+
+// Admission of a start, must be called with the lock held. Admitted
+// containers are marked as starting until container_start_run is done.
+static bool container_start_begin(Container* container) {
+    // Threads of a paused container are still alive
+    if(container->status.state == ContainerStatePaused && !container->status.checkpointed) {
+        FURI_LOG_E(TAG, "%s is paused, resume it instead", container->config.name);
+        return false;
+    }
+
+    // Previous instance hasn't exited yet and still holds its heap
+    if(container->thread) {
+        FURI_LOG_E(TAG, "%s is still exiting", container->config.name);
+        return false;
+    }
+
+    if(container->starting) {
+        FURI_LOG_E(TAG, "%s is already starting", container->config.name);
+        return false;
+    }
+
+    // Retried admission keeps the tick of the original request
+    if(!container->status.admission_pending) {
+        container->trace_start = furi_get_tick();
+    }
+    if(!container_runtime_admit(container->runtime, container)) return false;
+
+    const uint32_t now = furi_get_tick();
+    container_trace(container, ContainerTraceEventAdmission, now, now - container->trace_start);
+    container->starting = true;
+    container->stop_requested = false;
+
+    return true;
+}
+
+// Start of an admitted container, must be called without the lock. Record may
+// be deleted as soon as starting is cleared, so it isn't touched afterwards.
+static bool container_start_run(Container* container, bool restart) {
+    ContainerRuntime* runtime = container->runtime;
+
+    bool success = container_run_app(container);
+
+    furi_mutex_acquire(runtime->mutex, FuriWaitForever);
+    container->starting = false;
+    if(!success) {
+        if(container->restore_pending && !container->stop_requested) {
+            FURI_LOG_E(TAG, "%s: restart from checkpoint failed", container->config.name);
+        }
+        container->restore_pending = false;
+        if(restart && !container->stop_requested) {
+            container_exited(container, ContainerExitReasonStartFailed, 0);
+        }
+    } else {
+        container_set_state(container, ContainerStateRunning);
+        container->status.unhealthy = false;
+        container->status.untraced = false;
+        container->status.oom_killed = false;
+        container->status.memory_used = 0;
+        container->status.memory_peak = 0;
+        container->status.cpu_usage = 0;
+        memset(container->cpu_samples, 0, sizeof(container->cpu_samples));
+        container->memory_limit_strikes = 0;
+
+        // Stop came in while the image was loading, it applies to this run
+        if(container->stop_requested) {
+            container_stop(container, false);
+        }
+    }
+    furi_mutex_release(runtime->mutex);
+
+    return success;
+}
+
+bool container_start(Container* container) {
+    furi_assert(container);
+
+    ContainerRuntime* runtime = container->runtime;
+
+    furi_mutex_acquire(runtime->mutex, FuriWaitForever);
+    // Already running? Return success immediately
+    if(container->status.state == ContainerStateRunning) {
+        furi_mutex_release(runtime->mutex);
+        return true;
+    }
+    bool admitted = container_start_begin(container);
+    furi_mutex_release(runtime->mutex);
+
+    return admitted && container_start_run(container, false);
+}
+
+// Wait for a start in progress and for the exit event to release the image,
+// must be called without the lock
+static bool container_wait_exit(Container* container) {
+    ContainerRuntime* runtime = container->runtime;
+    uint32_t start = furi_get_tick();
+
+    while(furi_get_tick() - start < CONTAINER_STOP_TIMEOUT_MS) {
+        furi_mutex_acquire(runtime->mutex, FuriWaitForever);
+        bool exited = !container->thread && !container->starting;
+        furi_mutex_release(runtime->mutex);
+        if(exited) return true;
+        furi_delay_tick(2);
+    }
+
+    return false;
+}
+
+static void container_checkpoint_path(const Container* container, FuriString* path) {
+    furi_string_printf(path, "%s/%s.ckpt", CONTAINER_CHECKPOINT_DIR, container->config.name);
+}
+
+static void container_checkpoint_remove(Container* container) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    FuriString* path = furi_string_alloc();
+    container_checkpoint_path(container, path);
+    storage_simply_remove(storage, furi_string_get_cstr(path));
+    furi_string_free(path);
+    furi_record_close(RECORD_STORAGE);
+
+    container->status.checkpointed = false;
+    container->restore_pending = false;
+}
+
+void container_stop(Container* container, bool force) {
+    furi_assert(container);
+    
+    ContainerRuntime* runtime = container->runtime;
+
+    furi_mutex_acquire(runtime->mutex, FuriWaitForever);
+    // Image being loaded is stopped once it's started
+    container->stop_requested = container->starting;
+    // Stopping by hand ends the crash loop
+    container->status.restart_pending = false;
+    container->restart_backoff = 0;
+    container->status.admission_pending = false;
+    container->status.preempted = false;
+
+    // Checkpoint would resurrect the old state on the next start
+    if(container->status.checkpointed) {
+        container_checkpoint_remove(container);
+    }
+
+    if(container->status.state == ContainerStateTerminated) {
+        container_runtime_update_scheduler(runtime);
+        furi_mutex_release(runtime->mutex);
+        return;
+    }
+
+    // Lowest priority threads could starve before seeing the exit request
+    if(container->status.throttled) {
+        container_set_throttled(container, runtime->thread_list, false);
+    }
+
+    const bool paused = container->status.state == ContainerStatePaused;
+    if(paused && container->app_handle && furi_thread_enumerate(runtime->thread_list)) {
+        container_thaw(container, runtime->thread_list);
+    }
+
+    // Terminated before the exit request, so the exit event doesn't trigger a restart
+    container_set_state(container, ContainerStateTerminated);
+    container->trace_stop = furi_get_tick();
+    container->trace_stop_pending = container->app_handle != NULL;
+
+    // Ask the application to exit. Thread is released by its exit event,
+    // so it's only touched under the lock.
+    if(container->thread) {
+        furi_thread_signal(container->thread, FuriSignalExit, NULL);
+        furi_mutex_release(runtime->mutex);
+
+        if(force) {
+            container_wait_exit(container);
+        }
+    } else if(!container->app_handle) {
+        // Checkpointed, nothing is running
+        furi_mutex_release(runtime->mutex);
+    } else {
+        furi_mutex_release(runtime->mutex);
+
+        Loader* loader = furi_record_open(RECORD_LOADER);
+        loader_signal(loader, FuriSignalExit, NULL);
+        furi_record_close(RECORD_LOADER);
+    }
+}
+
+bool container_pause(Container* container) {
+    furi_assert(container);
+
+    ContainerRuntime* runtime = container->runtime;
+    bool paused = false;
+
+    furi_mutex_acquire(runtime->mutex, FuriWaitForever);
+
+    do {
+        if(container->status.state != ContainerStateRunning) break;
+
+        // Threads are suspended wherever they are, only applications that accept
+        // that for checkpoint save can be frozen
+        if(!container->checkpoint_save) {
+            FURI_LOG_E(TAG, "%s: no checkpoint callbacks registered", container->config.name);
+            break;
+        }
+
+        if(!furi_thread_enumerate(runtime->thread_list)) break;
+
+        // Priority override would outlive the pause
+        if(container->status.throttled) {
+            container_set_throttled(container, runtime->thread_list, false);
+        }
+        container_freeze(container, runtime->thread_list);
+        container_set_state(container, ContainerStatePaused);
+        paused = true;
+    } while(false);
+
+    furi_mutex_release(runtime->mutex);
+
+    return paused;
+}
+
+// Save is done to RAM while the container is frozen: a suspended thread may
+// hold locks the storage path needs
+static bool container_checkpoint_save(Container* container, uint32_t* size) {
+    ContainerRuntime* runtime = container->runtime;
+    Stream* state = string_stream_alloc();
+
+    container_freeze(container, runtime->thread_list);
+    bool success = container->checkpoint_save(state, container->checkpoint_context);
+    container_thaw(container, runtime->thread_list);
+
+    if(success) {
+        Storage* storage = furi_record_open(RECORD_STORAGE);
+        FuriString* path = furi_string_alloc();
+        container_checkpoint_path(container, path);
+
+        *size = stream_size(state);
+        storage_simply_mkdir(storage, EXT_PATH(".tmp"));
+        storage_simply_mkdir(storage, CONTAINER_CHECKPOINT_DIR);
+        stream_rewind(state);
+        success = stream_save_to_file(
+                      state, storage, furi_string_get_cstr(path), FSOM_CREATE_ALWAYS) == *size;
+        if(!success) {
+            storage_simply_remove(storage, furi_string_get_cstr(path));
+        }
+
+        furi_string_free(path);
+        furi_record_close(RECORD_STORAGE);
+    }
+
+    stream_free(state);
+    return success;
+}
+
+// Save state and ask the application to exit, must be called with the lock held
+static bool container_checkpoint_begin(Container* container) {
+    ContainerRuntime* runtime = container->runtime;
+
+    if(container->status.state != ContainerStateRunning || !container->thread) {
+        FURI_LOG_E(
+            TAG, "%s: only running FAP containers can be checkpointed", container->config.name);
+        return false;
+    }
+
+    if(!container->checkpoint_save) {
+        FURI_LOG_E(TAG, "%s: no checkpoint callbacks registered", container->config.name);
+        return false;
+    }
+
+    if(!furi_thread_enumerate(runtime->thread_list)) return false;
+
+    if(container->status.throttled) {
+        container_set_throttled(container, runtime->thread_list, false);
+    }
+
+    uint32_t size = 0;
+    if(!container_checkpoint_save(container, &size)) {
+        FURI_LOG_E(TAG, "%s: checkpoint save failed", container->config.name);
+        return false;
+    }
+
+    // Paused before the exit request, so the exit event doesn't trigger a restart
+    container_set_state(container, ContainerStatePaused);
+    container->trace_stop = furi_get_tick();
+    container->trace_stop_pending = true;
+    container->status.checkpointed = true;
+    container->status.checkpoint_size = size;
+    furi_thread_signal(container->thread, FuriSignalExit, NULL);
+
+    return true;
 }
 
-// Find an available container slot
-static Container* container_find_free_slot(ContainerRuntime* runtime) {
-    for(uint8_t i = 0; i < MAX_CONTAINERS; i++) {
-        if(runtime->containers[i].config.name == NULL) {
-            return &runtime->containers[i];
-        }
-    }
-    return NULL;
-}
+bool container_checkpoint(Container* container) {
+    furi_assert(container);
 
-// Preflight check for resources - fail early if not enough memory
-bool container_runtime_can_start_container(ContainerRuntime* runtime, const ContainerConfig* config) {
-    // Calculate system's free memory - simplified example
-    size_t free_mem = furi_get_free_heap_size();
-    size_t required_mem = config->resource_limits.max_memory;
-    
-    // Add 20% overhead for container management
-    required_mem = required_mem * 1.2;
-    
-    // Check if there's enough memory
-    if(free_mem < required_mem) {
-        FURI_LOG_W(TAG, "Not enough memory to start container %s", config->name);
-        FURI_LOG_W(TAG, "Required: %d, Available: %d", required_mem, free_mem);
-        return false;
+    ContainerRuntime* runtime = container->runtime;
+    const uint32_t start = furi_get_tick();
+
+    furi_mutex_acquire(runtime->mutex, FuriWaitForever);
+    const size_t free_heap = memmgr_get_free_heap();
+    bool success = container_checkpoint_begin(container);
+    furi_mutex_release(runtime->mutex);
+
+    if(!success) return false;
+
+    if(!container_wait_exit(container)) {
+        FURI_LOG_W(TAG, "%s: still exiting, heap is released later", container->config.name);
     }
-    
+
+    furi_mutex_acquire(runtime->mutex, FuriWaitForever);
+    const size_t free_heap_after = memmgr_get_free_heap();
+    container->status.reclaimed = free_heap_after > free_heap ? free_heap_after - free_heap : 0;
+    container->status.pause_time = furi_get_tick() - start;
+    FURI_LOG_I(
+        TAG,
+        "%s checkpointed: %lu bytes saved, %lu bytes reclaimed, %lums",
+        container->config.name,
+        container->status.checkpoint_size,
+        container->status.reclaimed,
+        container->status.pause_time);
+    furi_mutex_release(runtime->mutex);
+
     return true;
 }
 
-Container* container_create(ContainerRuntime* runtime, const ContainerConfig* config) {
-    furi_assert(runtime);
-    furi_assert(config);
-    
-    if(!config->name || !config->image) {
-        FURI_LOG_E(TAG, "Invalid config");
-        return NULL;
-    }
-    
-    // Validate image exists before allocating anything
-    if(!container_check_local_image(config->image)) {
-        return NULL;
-    }
-    
-    if(!furi_mutex_acquire(runtime->mutex, FuriWaitForever)) {
-        FURI_LOG_E(TAG, "Failed to acquire mutex");
-        return NULL;
+// Admission of a checkpointed container, must be called with the lock held
+static bool container_resume_begin(Container* container) {
+    // State is restored when the application registers its callbacks
+    container->restore_pending = true;
+    container->resume_started = furi_get_tick();
+    if(container_start_begin(container)) return true;
+
+    if(!container->status.admission_pending) {
+        FURI_LOG_E(TAG, "%s: restart from checkpoint failed", container->config.name);
     }
-    
-    // Check if we've reached max containers
-    if(runtime->container_count >= MAX_CONTAINERS) {
-        FURI_LOG_E(TAG, "Max containers reached");
+    container->restore_pending = false;
+    return false;
+}
+
+void container_resume(Container* container) {
+    furi_assert(container);
+
+    ContainerRuntime* runtime = container->runtime;
+
+    furi_mutex_acquire(runtime->mutex, FuriWaitForever);
+
+    if(container->status.state != ContainerStatePaused) {
         furi_mutex_release(runtime->mutex);
-        return NULL;
+        return;
     }
-    
-    // Check available resources before proceeding
-    if(!container_runtime_can_start_container(runtime, config)) {
+
+    if(!container->status.checkpointed) {
+        if(furi_thread_enumerate(runtime->thread_list)) {
+            container_thaw(container, runtime->thread_list);
+            container_set_state(container, ContainerStateRunning);
+        }
         furi_mutex_release(runtime->mutex);
-        return NULL;
+        return;
     }
-    
-    // Find unused container slot
-    Container* container = container_find_free_slot(runtime);
+
+    const bool admitted = container_resume_begin(container);
+    furi_mutex_release(runtime->mutex);
+
+    if(admitted) {
+        container_start_run(container, false);
+    }
+}
+
+// Container of the calling thread, must be called with the lock held
+static Container* container_runtime_find_current(ContainerRuntime* runtime) {
+    // Container threads are tagged with the container handle
+    return container_runtime_resolve(
+        runtime, furi_thread_get_owner_tag(furi_thread_get_current_id()));
+}
+
+bool container_checkpoint_register(
+    ContainerCheckpointCallback save,
+    ContainerCheckpointCallback restore,
+    void* context) {
+    furi_check(save);
+    furi_check(restore);
+
+    ContainerRuntime* runtime = furi_get_container_runtime();
+    if(!runtime) return false;
+
+    furi_mutex_acquire(runtime->mutex, FuriWaitForever);
+
+    Container* container = container_runtime_find_current(runtime);
     if(!container) {
-        FURI_LOG_E(TAG, "No container slots");
         furi_mutex_release(runtime->mutex);
-        return NULL;
+        FURI_LOG_W(TAG, "Checkpoint callbacks registered outside of a container");
+        return false;
     }
-    
-    // Initialize container with proper error handling
-    memset(container, 0, sizeof(Container));
-    
-    char* name_copy = strdup(config->name);
-    if(!name_copy) {
-        FURI_LOG_E(TAG, "Out of memory");
-        furi_mutex_release(runtime->mutex);
-        return NULL;
+
+    container->checkpoint_save = save;
+    container->checkpoint_restore = restore;
+    container->checkpoint_context = context;
+    const bool restore_pending = container->restore_pending;
+
+    FuriString* path = furi_string_alloc();
+    container_checkpoint_path(container, path);
+
+    // Restore runs in the application thread, runtime stays available meanwhile
+    furi_mutex_release(runtime->mutex);
+
+    bool restored = false;
+    if(restore_pending) {
+        Storage* storage = furi_record_open(RECORD_STORAGE);
+        Stream* stream = file_stream_alloc(storage);
+        if(file_stream_open(stream, furi_string_get_cstr(path), FSAM_READ, FSOM_OPEN_EXISTING)) {
+            restored = restore(stream, context);
+        }
+        stream_free(stream);
+        furi_record_close(RECORD_STORAGE);
     }
-    
-    char* image_copy = strdup(config->image);
-    if(!image_copy) {
-        FURI_LOG_E(TAG, "Out of memory");
-        free(name_copy);
+
+    furi_string_free(path);
+
+    if(restore_pending) {
+        furi_mutex_acquire(runtime->mutex, FuriWaitForever);
+        if(!restored) {
+            FURI_LOG_E(TAG, "%s: checkpoint restore failed", container->config.name);
+        }
+        container->status.resume_time = furi_get_tick() - container->resume_started;
+        container_checkpoint_remove(container);
         furi_mutex_release(runtime->mutex);
-        return NULL;
     }
-    
-    container->config.name = name_copy;
-    container->config.image = image_copy;
-    container->config.args = config->args; // Just store the pointer
-    container->config.restart_on_crash = config->restart_on_crash;
-    container->config.system_container = config->system_container;
-    
-    // Use provided resource limits with ultra-minimal defaults
-    container->config.resource_limits.max_memory = 
-        config->resource_limits.max_memory > 0 ? 
-        config->resource_limits.max_memory : 2 * 1024; // Even more minimal: 2KB default
-    
-    container->config.resource_limits.cpu_time_share = 
-        config->resource_limits.cpu_time_share > 0 ?
-        config->resource_limits.cpu_time_share : 3; // Even more minimal: 3% default
-    
-    container->config.resource_limits.max_threads = 
-        config->resource_limits.max_threads > 0 ?
-        config->resource_limits.max_threads : 1; // Keep 1 thread as absolute minimum
-    
-    container->status.state = ContainerStatePending;
-    container->status.restart_count = 0;
-    container->status.uptime = 0;
-    
-    runtime->container_count++;
-    
-    furi_mutex_release(runtime->mutex);
-    
-    return container;
+
+    return restored;
 }
 
-static bool container_run_app(Container* container) {
-    // We already checked that the app exists in container_create
-    Loader* loader = furi_record_open(RECORD_LOADER);
-    bool success = false;
-    
-    // Check if app is external FAP
-    if(strstr(container->config.image, ".fap") != NULL) {
-        success = loader_start_with_gui_error(
-            loader, 
-            container->config.image, 
-            container->config.args);
-        
-        if(success) {
-            container->app_handle = (void*)container->config.image;
-        }
-    } else {
-        // Built-in application
-        success = loader_start(loader, container->config.image, container->config.args);
-        container->app_handle = (void*)1; // Placeholder for built-ins
+void container_checkpoint_unregister(void) {
+    ContainerRuntime* runtime = furi_get_container_runtime();
+    if(!runtime) return;
+
+    furi_mutex_acquire(runtime->mutex, FuriWaitForever);
+
+    Container* container = container_runtime_find_current(runtime);
+    if(container) {
+        container->checkpoint_save = NULL;
+        container->checkpoint_restore = NULL;
+        container->checkpoint_context = NULL;
     }
-    
-    furi_record_close(RECORD_LOADER);
-    return success;
+
+    furi_mutex_release(runtime->mutex);
 }
 
-bool container_start(Container* container) {
+void container_get_status(Container* container, ContainerStatus* status) {
     furi_assert(container);
+    furi_assert(status);
     
-    // Already running? Return success immediately
-    if(container->status.state == ContainerStateRunning) {
-        return true;
-    }
-    
-    // Start the application
-    bool success = container_run_app(container);
-    
-    if(success) {
-        container->status.state = ContainerStateRunning;
-        container->status.uptime = 0;
+    // State is kept current by exit events
+    *status = container->status;
+
+    // Scheduler may skip ticks, so uptime is taken from the clock
+    if(status->state == ContainerStateRunning) {
+        status->uptime =
+            (furi_get_tick() - container->running_since) / furi_kernel_get_tick_frequency();
     }
-    
-    return success;
+
+    const int32_t remaining = container->restart_at - furi_get_tick();
+    status->restart_delay = status->restart_pending && remaining > 0 ? remaining : 0;
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_io_account_get(storage, container->id, &status->io);
+    furi_record_close(RECORD_STORAGE);
 }
 
-void container_stop(Container* container, bool force) {
+bool container_delete(Container* container) {
     furi_assert(container);
-    
-    if(container->status.state == ContainerStateTerminated) {
-        return;
-    }
-    
-    // Stop the application
-    Loader* loader = furi_record_open(RECORD_LOADER);
-    
-    // External app vs built-in app
-    if(strstr(container->config.image, ".fap") != NULL) {
-        loader_stop_external(loader, container->config.image);
-    } else {
-        loader_stop(loader);
+
+    ContainerRuntime* runtime = container->runtime;
+
+    container_stop(container, true);
+    // Start in progress stops the image it started
+    container_wait_exit(container);
+
+    furi_mutex_acquire(runtime->mutex, FuriWaitForever);
+
+    // Exit event of the main thread still references the record
+    if(container->thread) {
+        FURI_LOG_E(TAG, "%s is still exiting", container->config.name);
+        furi_mutex_release(runtime->mutex);
+        return false;
     }
-    
-    furi_record_close(RECORD_LOADER);
-    
-    container->status.state = ContainerStateTerminated;
-    
-    // Find the container's runtime and update the active count
-    // Note: this is a simplification; in a real implementation
-    // we would have the runtime stored in the container
-    ContainerRuntime* runtime = container_runtime_get_instance(); // Assuming this function exists
-    if(runtime) {
-        furi_mutex_acquire(runtime->mutex, FuriWaitForever);
-        if(runtime->active_container_count > 0) {
-            runtime->active_container_count--;
-        }
+
+    // Worker is loading the image without the lock
+    if(container->starting) {
+        FURI_LOG_E(TAG, "%s is still starting", container->config.name);
         furi_mutex_release(runtime->mutex);
+        return false;
     }
+
+    container_update_storage(container, false);
+    ContainerIndex_erase(runtime->index, container->config.name);
+    container_free_config(&container->config);
+    if(container->preloaded) flipper_application_free(container->preloaded);
+    if(container->warm_image) flipper_application_warm_image_free(container->warm_image);
+    container_runtime_free_record(runtime, container);
+    runtime->container_count--;
+
+    furi_mutex_release(runtime->mutex);
+
+    return true;
 }
 
-void container_get_status(Container* container, ContainerStatus* status) {
+ContainerId container_get_id(const Container* container) {
     furi_assert(container);
-    furi_assert(status);
-    
-    // Check if application is still running
-    container_check_health(container);
-    
-    *status = container->status;
+    return container->id;
 }
 
-// Ultra-optimized container counter - direct access with mutex
-uint8_t container_runtime_get_count(ContainerRuntime* runtime) {
+const ContainerConfig* container_get_config(const Container* container) {
+    furi_assert(container);
+    return &container->config;
+}
+
+Container* container_runtime_get(ContainerRuntime* runtime, ContainerId id) {
     furi_assert(runtime);
-    
+
     furi_mutex_acquire(runtime->mutex, FuriWaitForever);
-    uint8_t count = runtime->container_count;
+    Container* container = container_runtime_resolve(runtime, id);
+    furi_mutex_release(runtime->mutex);
+
+    return container;
+}
+
+Container* container_runtime_find(ContainerRuntime* runtime, const char* name) {
+    furi_assert(runtime);
+    furi_assert(name);
+
+    Container* container = NULL;
+
+    furi_mutex_acquire(runtime->mutex, FuriWaitForever);
+    const ContainerId* id = ContainerIndex_get(runtime->index, name);
+    if(id) {
+        container = container_runtime_resolve(runtime, *id);
+    }
+    furi_mutex_release(runtime->mutex);
+
+    return container;
+}
+
+ContainerId container_runtime_get_next(ContainerRuntime* runtime, ContainerId id) {
+    furi_assert(runtime);
+
+    ContainerId next = CONTAINER_ID_INVALID;
+    // Index of a deleted container is still a valid position
+    uint32_t index = id == CONTAINER_ID_INVALID ? 0 : CONTAINER_ID_INDEX(id) + 1;
+
+    furi_mutex_acquire(runtime->mutex, FuriWaitForever);
+    for(; index < runtime->capacity; index++) {
+        Container* container = container_runtime_record(runtime, index);
+        if(container->config.name) {
+            next = container->id;
+            break;
+        }
+    }
+    furi_mutex_release(runtime->mutex);
+
+    return next;
+}
+
+void container_runtime_get_scheduler_stats(
+    ContainerRuntime* runtime,
+    ContainerSchedulerStats* stats) {
+    furi_assert(runtime);
+    furi_assert(stats);
+
+    furi_mutex_acquire(runtime->mutex, FuriWaitForever);
+    *stats = runtime->scheduler_stats;
     furi_mutex_release(runtime->mutex);
-    
-    return count;
 }
 
 // Ultra-optimized container counter - direct access with mutex
-uint16_t container_runtime_get_running_count(ContainerRuntime* runtime) {
+size_t container_runtime_get_count(ContainerRuntime* runtime) {
     furi_assert(runtime);
     
-    uint16_t count = 0;
     furi_mutex_acquire(runtime->mutex, FuriWaitForever);
-    
-    count = runtime->active_container_count;
-    
+    size_t count = runtime->container_count;
     furi_mutex_release(runtime->mutex);
+    
     return count;
 }
 
-// Optimize memory allocation with static pool
-ContainerHandle* container_runtime_allocate_handle(ContainerRuntime* runtime) {
+size_t container_runtime_get_capacity(ContainerRuntime* runtime) {
     furi_assert(runtime);
-    
-    ContainerHandle* handle = NULL;
-    
+
+    const size_t slab_size = sizeof(Container) * CONTAINER_SLAB_SIZE;
+    const size_t free_heap = memmgr_get_free_heap();
+
     furi_mutex_acquire(runtime->mutex, FuriWaitForever);
-    
-    if(runtime->recycled_container_pool) {
-        // Reuse from linked list if available
-        handle = runtime->recycled_container_pool;
-        runtime->recycled_container_pool = handle->next;
-        memset(handle, 0, sizeof(ContainerHandle));
-    } else if(runtime->next_free_handle_index < CONTAINER_POOL_SIZE) {
-        // Use from static pool if available
-        handle = &runtime->container_handle_pool[runtime->next_free_handle_index++];
-        memset(handle, 0, sizeof(ContainerHandle));
-    } else {
-        // Fall back to malloc only if necessary
-        handle = malloc(sizeof(ContainerHandle));
-        if(handle) {
-            memset(handle, 0, sizeof(ContainerHandle));
-        }
+
+    // Same rules as container_runtime_grow
+    size_t capacity = runtime->capacity;
+    if(free_heap > CONTAINER_SLAB_MIN_FREE_HEAP) {
+        capacity += (free_heap - CONTAINER_SLAB_MIN_FREE_HEAP) / slab_size * CONTAINER_SLAB_SIZE;
     }
-    
+    // Record indexes stay below CONTAINER_RECORD_NONE
+    const size_t max_capacity = CONTAINER_RECORD_NONE / CONTAINER_SLAB_SIZE * CONTAINER_SLAB_SIZE;
+    capacity = MIN(capacity, max_capacity);
+
     furi_mutex_release(runtime->mutex);
-    return handle;
+
+    return capacity;
 }
 
-// Return container handle to the recycling pool
-void container_runtime_free_handle(ContainerRuntime* runtime, ContainerHandle* handle) {
+// Ultra-optimized container counter - direct access with mutex
+uint16_t container_runtime_get_running_count(ContainerRuntime* runtime) {
     furi_assert(runtime);
-    furi_assert(handle);
     
+    uint16_t count = 0;
     furi_mutex_acquire(runtime->mutex, FuriWaitForever);
     
-    handle->next = runtime->recycled_container_pool;
-    runtime->recycled_container_pool = handle;
+    count = runtime->active_container_count;
     
     furi_mutex_release(runtime->mutex);
+    return count;
 }
 
 // Pre-allocate resources before starting containers to avoid memory fragmentation
@@ -483,8 +2208,9 @@ bool container_runtime_preallocate_resources(ContainerRuntime* runtime, PodManif
         return false;
     }
     
-    if(runtime->container_count + container_count > MAX_CONTAINERS) {
-        FURI_LOG_E(TAG, "Not enough container slots");
+    // Grow the table up front so records don't interleave with container heap
+    if(!container_runtime_reserve(runtime, container_count)) {
+        FURI_LOG_E(TAG, "Not enough memory for %lu containers", container_count);
         return false;
     }
     
@@ -516,13 +2242,19 @@ bool container_runtime_parallel_init(ContainerRuntime* runtime, PodManifest* man
     
     // First create all containers (quick operation)
     for(uint32_t i = 0; i < container_count; i++) {
-        ContainerConfig config;
+        ContainerConfig config = {0};
         config.name = containers[i].name;
         config.image = containers[i].image;
         config.args = containers[i].args;
-        config.restart_on_crash = containers[i].restart_on_crash;
+        config.restart_policy = containers[i].restart_policy;
         config.system_container = containers[i].system_privileges;
+        config.warm_restart = containers[i].warm_restart;
+        config.priority_class = containers[i].priority_class;
         config.resource_limits = containers[i].resources;
+        config.health_check = containers[i].health_check;
+        config.pod = pod_manifest_get_name(manifest);
+        config.volume_mounts = containers[i].volume_mounts;
+        config.volume_mount_count = containers[i].volume_mount_count;
         
         created_containers[i] = container_create(runtime, &config);
         if(!created_containers[i]) {
@@ -532,22 +2264,17 @@ bool container_runtime_parallel_init(ContainerRuntime* runtime, PodManifest* man
     }
     
     // Then start containers sequentially (slow operation)
-    if(success) {
+    for(uint32_t i = 0; success && i < container_count; i++) {
+        success = container_start(created_containers[i]);
+    }
+
+    // Names stay taken until the records are deleted
+    if(!success) {
         for(uint32_t i = 0; i < container_count; i++) {
-            if(!container_start(created_containers[i])) {
-                success = false;
-                // Stop all previously started containers
-                for(uint32_t j = 0; j < i; j++) {
-                    container_stop(created_containers[j], true);
-                }
-                break;
-            }
-            
-            // Update active container count when starting
-            runtime->active_container_count++;
+            if(created_containers[i]) container_delete(created_containers[i]);
         }
     }
-    
+
     free(created_containers);
     return success;
 }
@@ -568,42 +2295,3 @@ bool container_runtime_start_pod(ContainerRuntime* runtime, PodManifest* manifes
     
     return success;
 }
-
-// Enhanced container health check with Kubernetes-like probes
-void container_check_health_probes(Container* container) {
-    if(!container || container->status.state != ContainerStateRunning) {
-        return;
-    }
-    
-    // Check liveness probe
-    if(container->config.liveness_probe.enabled) {
-        if(container->status.uptime >= container->config.liveness_probe.initial_delay_seconds) {
-            // Only check periodically
-            if(container->status.uptime % container->config.liveness_probe.period_seconds == 0) {
-                bool probe_success = true;
-                
-                // Simple command-based probe
-                if(container->config.liveness_probe.type == ProbeTypeCommand) {
-                    // In a real implementation, we would execute the command
-                    // and check the return code
-                    probe_success = true; // Placeholder
-                }
-                
-                // Update failure count
-                if(!probe_success) {
-                    container->status.liveness_failures++;
-                    if(container->status.liveness_failures >= container->config.liveness_probe.failure_threshold) {
-                        FURI_LOG_W(TAG, "Liveness probe failed for %s, restarting", container->config.name);
-                        container_stop(container, true);
-                        container_start(container);
-                        container->status.restart_count++;
-                    }
-                } else {
-                    container->status.liveness_failures = 0;
-                }
-            }
-        }
-    }
-    
-    // Add readiness probe implementation here if needed
-}
@@ -3,6 +3,9 @@
 #include <furi.h>
 #include <furi/core/mutex.h>
 #include <furi/core/thread.h>
+#include <flipper_application/flipper_application.h>
+#include <toolbox/stream/stream.h>
+#include <storage/storage.h>
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -19,6 +22,12 @@ extern "C" {
 
 typedef struct ContainerRuntime ContainerRuntime;
 typedef struct Container Container;
+typedef struct ContainerTrace ContainerTrace;
+
+/** Generation counted container handle, stays invalid once the container is deleted */
+typedef uint32_t ContainerId;
+
+#define CONTAINER_ID_INVALID 0
 
 /** Container states */
 typedef enum {
@@ -28,32 +37,128 @@ typedef enum {
     ContainerStateTerminated,
 } ContainerState;
 
+/** What the runtime does with containers using more than their cpu_time_share */
+typedef enum {
+    ContainerThrottleModeNone, // Only measure CPU usage
+    ContainerThrottleModePriority, // Drop container threads to the lowest priority
+} ContainerThrottleMode;
+
+/** Scheduling priority, a container may preempt running containers of lower classes */
+typedef enum {
+    ContainerPriorityClassBestEffort,
+    ContainerPriorityClassNormal,
+    ContainerPriorityClassHigh,
+    ContainerPriorityClassSystem, // Default for system containers
+} ContainerPriorityClass;
+
 /** Resource limits for a container */
 typedef struct {
-    uint32_t max_memory;     // Maximum memory in bytes
-    uint32_t cpu_time_share; // CPU time share (0-100%)
+    uint32_t max_memory;     // Maximum live heap in bytes, enforced by the runtime
+    uint32_t cpu_time_share; // CPU time share (0-100%), enforced by throttling
     uint32_t max_threads;    // Maximum number of threads
+    uint32_t io_bytes_per_second; // Storage throughput of all threads, 0 for unlimited
 } ContainerResourceLimits;
 
+/** When a container that exited on its own is started again */
+typedef enum {
+    ContainerRestartPolicyNever,
+    ContainerRestartPolicyOnFailure, // After a nonzero exit code or a failed health check
+    ContainerRestartPolicyAlways,
+} ContainerRestartPolicy;
+
+/** Why a container last terminated without being stopped */
+typedef enum {
+    ContainerExitReasonNone,
+    ContainerExitReasonCompleted, // Returned 0, built-ins always do
+    ContainerExitReasonError, // Returned nonzero, see ContainerStatus.exit_code
+    ContainerExitReasonUnhealthy, // Asked to exit after failing its health check
+    ContainerExitReasonOOMKilled, // Killed for exceeding resource_limits.max_memory
+    ContainerExitReasonStartFailed, // Restart couldn't load or start the image
+    ContainerExitReasonUntraced, // Stopped, a thread got no heap trace slot
+} ContainerExitReason;
+
+/** Health check type */
+typedef enum {
+    HealthCheckTypeNone,
+    HealthCheckTypeCommand, // "<service> [args]", runs the probe callback of the service
+    HealthCheckTypeHttp, // Not supported, never probed
+} HealthCheckType;
+
+/** Liveness probe, a container failing it is asked to exit and restarted like after a crash */
+typedef struct {
+    HealthCheckType type;
+    union {
+        const char* command;
+        const char* endpoint;
+    };
+    uint32_t initial_delay_ms; // From start to the first probe
+    uint32_t period_ms;
+    uint32_t timeout_ms;        // Slower probes count as failed, checked once the probe returns
+    uint32_t success_threshold; // Consecutive successes clearing earlier failures
+    uint32_t failure_threshold; // Consecutive failures making the container unhealthy
+} HealthCheckSpec;
+
+/** Pod volume, /ext/pods/<pod>/<name> seen by the container at mount_path */
+typedef struct {
+    const char* name;
+    const char* mount_path; // Single top level directory such as "/data"
+    bool read_only;
+} VolumeMountSpec;
+
 /** Container configuration */
 typedef struct {
     const char* name;
     const char* image;       // FAP file path or built-in app name
     ContainerResourceLimits resource_limits;
     void* args;              // Application arguments
-    bool restart_on_crash;   // Auto-restart on abnormal termination
+    ContainerRestartPolicy restart_policy; // Restart with exponential back-off after an exit
     bool system_container;   // Has access to system resources
+    bool warm_restart;       // Keep parsed FAP image between runs for faster restarts
+    ContainerPriorityClass priority_class;
+    HealthCheckSpec health_check;
+    const char* pod;         // Pod the container belongs to, NULL if none
+    const VolumeMountSpec* volume_mounts; // Need a pod, ignored for built-ins
+    uint32_t volume_mount_count;
+    FuriThreadCallback entry_point; // Firmware function run with args, image only names it
 } ContainerConfig;
 
 /** Container status information */
 typedef struct {
     ContainerState state;
-    uint32_t memory_used;
-    uint32_t cpu_usage;
-    uint32_t uptime;
+    uint32_t memory_used;    // Live heap bytes of all container threads
+    uint32_t memory_peak;    // Highest memory_used seen since the last start
+    uint32_t cpu_usage;      // CPU usage in percent averaged over the sampling window
+    bool throttled;          // Container is over its cpu_time_share and throttled
+    uint32_t uptime;         // Seconds in Running since the last start or resume
     uint32_t restart_count;
+    bool restart_pending;    // Backing off before restarting
+    uint32_t restart_delay;  // Milliseconds left until the pending restart
+    ContainerExitReason exit_reason; // Of the last termination
+    int32_t exit_code;       // Return code of the last exit
+    bool oom_killed;         // Killed for exceeding resource_limits.max_memory, at the lowest
+                             // priority until its threads exit
+    bool checkpointed;       // Paused with its state on SD and its heap released
+    uint32_t checkpoint_size; // Bytes of application state saved by the last checkpoint
+    uint32_t reclaimed;      // Heap bytes released by the last checkpoint
+    uint32_t pause_time;     // Milliseconds the last checkpoint took
+    uint32_t resume_time;    // Milliseconds from resume until the state was restored
+    bool preempted;          // Stopped or checkpointed to make room for a higher priority class
+    bool admission_pending;  // Waiting for memory released by preempted containers
+    bool unhealthy;          // Asked to exit after failing its health check
+    bool untraced;           // Asked to exit, a thread got no heap trace slot so its memory
+                             // couldn't be limited
+    StorageIoStats io;       // Storage use since the container was created
 } ContainerStatus;
 
+/**
+ * @brief Application state checkpoint callback
+ * 
+ * @param stream file stream positioned at the start of the state
+ * @param context context passed to container_checkpoint_register
+ * @return true on success
+ */
+typedef bool (*ContainerCheckpointCallback)(Stream* stream, void* context);
+
 /**
  * @brief Create a container runtime
  * 
@@ -75,6 +180,24 @@ void container_runtime_free(ContainerRuntime* runtime);
  */
 void container_runtime_start(ContainerRuntime* runtime);
 
+/**
+ * @brief Set how containers over their CPU time share are throttled
+ * 
+ * System containers are never throttled.
+ * 
+ * @param runtime 
+ * @param mode throttling mode, ContainerThrottleModePriority by default
+ */
+void container_runtime_set_throttle_mode(ContainerRuntime* runtime, ContainerThrottleMode mode);
+
+/**
+ * @brief Get the lifecycle trace of the runtime
+ * 
+ * @param runtime 
+ * @return ContainerTrace*, see container_trace.h
+ */
+ContainerTrace* container_runtime_get_trace(ContainerRuntime* runtime);
+
 /**
  * @brief Create a new container
  * 
@@ -84,29 +207,95 @@ void container_runtime_start(ContainerRuntime* runtime);
  */
 Container* container_create(ContainerRuntime* runtime, const ContainerConfig* config);
 
+/**
+ * @brief Create a new container for an image preloaded by the caller
+ * 
+ * Skips the image check of container_create. The container owns the image
+ * and maps it on first start, restarts load the image again.
+ * 
+ * @param runtime 
+ * @param config 
+ * @param fap image after flipper_application_preload, NULL for built-ins
+ * @return Container* or NULL, the caller still owns fap then
+ */
+Container* container_create_preloaded(
+    ContainerRuntime* runtime,
+    const ContainerConfig* config,
+    FlipperApplication* fap);
+
 /**
  * @brief Start a container
  * 
+ * Admission requires the largest free heap block to hold the container
+ * memory limit. If it doesn't, running containers of lower priority classes
+ * are checkpointed or stopped and the container is started by the runtime
+ * once their memory is released, see ContainerStatus.admission_pending.
+ * Preempted containers are started again when there is room.
+ * 
  * @param container 
  * @return true if started successfully
- * @return false if failed to start
+ * @return false if failed to start or waiting for admission
  */
 bool container_start(Container* container);
 
 /**
- * @brief Pause a container
+ * @brief Pause a container in place
  * 
- * @param container 
+ * Every container thread is suspended wherever it is. A thread holding a lock
+ * another thread needs, e.g. of storage or a furi record, stalls that thread
+ * until the container is resumed, so only applications that registered
+ * checkpoint callbacks, and with them accept being suspended during save, can
+ * be paused. Use container_checkpoint to release the heap instead.
+ * 
+ * @param container running container with checkpoint callbacks
+ * @return true if the container was paused
+ */
+bool container_pause(Container* container);
+
+/**
+ * @brief Pause a container and swap it out to SD
+ * 
+ * Application state is saved with the callbacks the application registered,
+ * then the application exits and its heap is returned to the system.
+ * container_resume starts it again and restores the state.
+ * 
+ * @param container running FAP container with checkpoint callbacks
+ * @return true if the container was checkpointed
  */
-void container_pause(Container* container);
+bool container_checkpoint(Container* container);
 
 /**
- * @brief Resume a paused container
+ * @brief Resume a paused or checkpointed container
  * 
  * @param container 
  */
 void container_resume(Container* container);
 
+/**
+ * @brief Register checkpoint callbacks of the calling application
+ * 
+ * Must be called from a container thread once the application state is
+ * allocated. If the container is being resumed from a checkpoint, restore is
+ * called from this function before it returns. Save is called with every
+ * container thread suspended and must only read the state.
+ * 
+ * @param save writes application state to the stream
+ * @param restore reads application state written by save
+ * @param context context passed to the callbacks
+ * @return true if the state was restored from a checkpoint
+ */
+bool container_checkpoint_register(
+    ContainerCheckpointCallback save,
+    ContainerCheckpointCallback restore,
+    void* context);
+
+/**
+ * @brief Unregister checkpoint callbacks of the calling application
+ * 
+ * Must be called before the application state is freed.
+ */
+void container_checkpoint_unregister(void);
+
 /**
  * @brief Stop a container
  * 
@@ -115,6 +304,17 @@ void container_resume(Container* container);
  */
 void container_stop(Container* container, bool force);
 
+/**
+ * @brief Stop a container and release its record
+ * 
+ * Handles and pointers of the container are invalid afterwards. Waits for
+ * a start in progress and for the container to exit.
+ * 
+ * @param container 
+ * @return true if deleted, false if the container is still starting or exiting
+ */
+bool container_delete(Container* container);
+
 /**
  * @brief Get container status
  * 
@@ -123,13 +323,85 @@ void container_stop(Container* container, bool force);
  */
 void container_get_status(Container* container, ContainerStatus* status);
 
+/**
+ * @brief Get container handle
+ * 
+ * @param container 
+ * @return ContainerId, unique for the lifetime of the runtime
+ */
+ContainerId container_get_id(const Container* container);
+
+/**
+ * @brief Get container configuration
+ * 
+ * @param container 
+ * @return configuration, strings are owned by the container
+ */
+const ContainerConfig* container_get_config(const Container* container);
+
+/**
+ * @brief Resolve a container handle
+ * 
+ * @param runtime 
+ * @param id 
+ * @return Container* or NULL if the container was deleted
+ */
+Container* container_runtime_get(ContainerRuntime* runtime, ContainerId id);
+
+/**
+ * @brief Find a container by name
+ * 
+ * @param runtime 
+ * @param name 
+ * @return Container* or NULL if not found
+ */
+Container* container_runtime_find(ContainerRuntime* runtime, const char* name);
+
+/**
+ * @brief Iterate over containers
+ * 
+ * @param runtime 
+ * @param id previous handle, CONTAINER_ID_INVALID to get the first one
+ * @return next handle or CONTAINER_ID_INVALID at the end
+ */
+ContainerId container_runtime_get_next(ContainerRuntime* runtime, ContainerId id);
+
 /**
  * @brief Get the count of containers
  * 
+ * Capacity grows with free heap, there is no fixed limit.
+ * 
+ * @param runtime 
+ * @return size_t Number of containers
+ */
+size_t container_runtime_get_count(ContainerRuntime* runtime);
+
+/**
+ * @brief Get the count of containers that fit right now
+ * 
+ * Allocated records plus the records free heap can still add.
+ * 
+ * @param runtime 
+ * @return size_t Number of containers
+ */
+size_t container_runtime_get_capacity(ContainerRuntime* runtime);
+
+/** Time spent in scheduler passes */
+typedef struct {
+    uint32_t runs;
+    uint32_t total_us;
+    uint32_t max_us;
+} ContainerSchedulerStats;
+
+/**
+ * @brief Get the time spent in scheduler passes since the runtime was started
+ * 
  * @param runtime 
- * @return uint8_t Number of containers
+ * @param stats 
  */
-uint8_t container_runtime_get_count(ContainerRuntime* runtime);
+void container_runtime_get_scheduler_stats(
+    ContainerRuntime* runtime,
+    ContainerSchedulerStats* stats);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,43 @@
+/**
+ * @file container_runtime_i.h
+ * @brief Container runtime internals, exposed for unit tests
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Restart back-off doubles from the minimum up to the cap, and starts over once
+// the container stayed up for the reset period
+#define CONTAINER_RESTART_BACKOFF_MIN_MS   1000
+#define CONTAINER_RESTART_BACKOFF_MAX_MS   (5 * 60 * 1000)
+#define CONTAINER_RESTART_BACKOFF_RESET_MS (10 * 60 * 1000)
+
+/**
+ * @brief Back-off before the next restart
+ * 
+ * @param backoff previous back-off in ms, 0 if there was none
+ * @param running_ticks how long the container ran before it exited, 0 if it didn't start
+ * @return back-off in ms
+ */
+uint32_t container_restart_backoff_next(uint32_t backoff, uint32_t running_ticks);
+
+/**
+ * @brief Restart delay for a back-off
+ * 
+ * Up to a quarter shorter than the back-off, so containers failing together
+ * don't reload together.
+ * 
+ * @param backoff back-off in ms
+ * @param random random value, furi_hal_random_get()
+ * @return delay in ms
+ */
+uint32_t container_restart_delay(uint32_t backoff, uint32_t random);
+
+#ifdef __cplusplus
+}
+#endif
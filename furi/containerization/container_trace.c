@@ -0,0 +1,295 @@
+#include "container_trace.h"
+
+#include <core/log.h>
+
+#define TAG "ContainerTrace"
+
+// Images with histograms, the least recently updated one is replaced
+#define CONTAINER_TRACE_MAX_IMAGES 8
+
+typedef struct {
+    FuriString* image;
+    uint32_t updated;
+    ContainerTraceHistogram phases[CONTAINER_TRACE_PHASE_COUNT];
+} ContainerTraceImage;
+
+struct ContainerTrace {
+    FuriMutex* mutex;
+    ContainerTraceEvent events[CONTAINER_TRACE_CAPACITY];
+    uint32_t head; // Sequence of the next event
+    uint32_t tail; // Sequence of the oldest event since the last reset
+    ContainerTraceImage images[CONTAINER_TRACE_MAX_IMAGES];
+    size_t image_count;
+};
+
+static const char* const container_trace_event_names[ContainerTraceEventCount] = {
+    [ContainerTraceEventAdmission] = "admission",
+    [ContainerTraceEventImageStat] = "image_stat",
+    [ContainerTraceEventElfOpen] = "elf_open",
+    [ContainerTraceEventSectionLoad] = "section_load",
+    [ContainerTraceEventRelocation] = "relocation",
+    [ContainerTraceEventInit] = "init",
+    [ContainerTraceEventFirstTick] = "first_tick",
+    [ContainerTraceEventStop] = "stop",
+    [ContainerTraceEventCrash] = "crash",
+};
+
+ContainerTrace* container_trace_alloc(void) {
+    ContainerTrace* trace = malloc(sizeof(ContainerTrace));
+    trace->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    for(size_t i = 0; i < CONTAINER_TRACE_MAX_IMAGES; i++) {
+        trace->images[i].image = furi_string_alloc();
+    }
+    return trace;
+}
+
+void container_trace_free(ContainerTrace* trace) {
+    furi_check(trace);
+    for(size_t i = 0; i < CONTAINER_TRACE_MAX_IMAGES; i++) {
+        furi_string_free(trace->images[i].image);
+    }
+    furi_mutex_free(trace->mutex);
+    free(trace);
+}
+
+static ContainerTraceImage*
+    container_trace_get_image_record(ContainerTrace* trace, const char* image) {
+    ContainerTraceImage* oldest = NULL;
+    for(size_t i = 0; i < trace->image_count; i++) {
+        ContainerTraceImage* record = &trace->images[i];
+        if(furi_string_equal(record->image, image)) return record;
+        if(!oldest || (int32_t)(record->updated - oldest->updated) < 0) oldest = record;
+    }
+
+    ContainerTraceImage* record;
+    if(trace->image_count < CONTAINER_TRACE_MAX_IMAGES) {
+        record = &trace->images[trace->image_count++];
+    } else {
+        FURI_LOG_D(TAG, "Dropping %s", furi_string_get_cstr(oldest->image));
+        record = oldest;
+    }
+
+    furi_string_set(record->image, image);
+    memset(record->phases, 0, sizeof(record->phases));
+    return record;
+}
+
+static void container_trace_histogram_add(ContainerTraceHistogram* histogram, uint32_t ms) {
+    size_t bucket = ms ? (32 - __builtin_clz(ms)) : 0;
+    if(bucket >= CONTAINER_TRACE_HISTOGRAM_BUCKETS) bucket = CONTAINER_TRACE_HISTOGRAM_BUCKETS - 1;
+
+    // Halve everything instead of wrapping, keeps the shape of the histogram
+    if(histogram->count == UINT16_MAX || histogram->buckets[bucket] == UINT16_MAX) {
+        histogram->count = 0;
+        for(size_t i = 0; i < CONTAINER_TRACE_HISTOGRAM_BUCKETS; i++) {
+            histogram->buckets[i] /= 2;
+            histogram->count += histogram->buckets[i];
+        }
+        histogram->total_ms /= 2;
+    }
+
+    histogram->buckets[bucket]++;
+    histogram->count++;
+    histogram->total_ms += ms;
+    if(ms > histogram->max_ms) histogram->max_ms = ms;
+}
+
+void container_trace_record(
+    ContainerTrace* trace,
+    ContainerId container,
+    const char* image,
+    ContainerTraceEventType type,
+    uint32_t timestamp,
+    int32_t value) {
+    furi_check(trace);
+    furi_check(type < ContainerTraceEventCount);
+
+    furi_check(furi_mutex_acquire(trace->mutex, FuriWaitForever) == FuriStatusOk);
+
+    ContainerTraceEvent* event = &trace->events[trace->head % CONTAINER_TRACE_CAPACITY];
+    event->timestamp = timestamp;
+    event->container = container;
+    event->value = value;
+    event->type = type;
+    trace->head++;
+
+    if(type < CONTAINER_TRACE_PHASE_COUNT) {
+        ContainerTraceImage* record = container_trace_get_image_record(trace, image ? image : "");
+        record->updated = timestamp;
+        container_trace_histogram_add(&record->phases[type], value > 0 ? (uint32_t)value : 0);
+    }
+
+    furi_mutex_release(trace->mutex);
+}
+
+size_t container_trace_read(
+    ContainerTrace* trace,
+    uint32_t* sequence,
+    ContainerTraceEvent* events,
+    size_t count) {
+    furi_check(trace);
+    furi_check(sequence);
+    furi_check(events || !count);
+
+    furi_check(furi_mutex_acquire(trace->mutex, FuriWaitForever) == FuriStatusOk);
+
+    uint32_t oldest = trace->tail;
+    if(trace->head - oldest > CONTAINER_TRACE_CAPACITY) {
+        oldest = trace->head - CONTAINER_TRACE_CAPACITY;
+    }
+    if((int32_t)(*sequence - oldest) < 0) *sequence = oldest;
+
+    size_t read = 0;
+    while(read < count && *sequence != trace->head) {
+        events[read++] = trace->events[*sequence % CONTAINER_TRACE_CAPACITY];
+        (*sequence)++;
+    }
+
+    furi_mutex_release(trace->mutex);
+    return read;
+}
+
+bool container_trace_get_image(
+    ContainerTrace* trace,
+    size_t index,
+    FuriString* image,
+    ContainerTraceHistogram* phases) {
+    furi_check(trace);
+
+    furi_check(furi_mutex_acquire(trace->mutex, FuriWaitForever) == FuriStatusOk);
+
+    bool found = index < trace->image_count;
+    if(found) {
+        if(image) furi_string_set(image, trace->images[index].image);
+        if(phases) memcpy(phases, trace->images[index].phases, sizeof(trace->images[index].phases));
+    }
+
+    furi_mutex_release(trace->mutex);
+    return found;
+}
+
+void container_trace_reset(ContainerTrace* trace) {
+    furi_check(trace);
+
+    furi_check(furi_mutex_acquire(trace->mutex, FuriWaitForever) == FuriStatusOk);
+    // Sequences keep counting so readers holding one don't replay old events
+    trace->tail = trace->head;
+    trace->image_count = 0;
+    furi_mutex_release(trace->mutex);
+}
+
+const char* container_trace_event_name(ContainerTraceEventType type) {
+    return type < ContainerTraceEventCount ? container_trace_event_names[type] : "unknown";
+}
+
+uint32_t container_trace_histogram_percentile(
+    const ContainerTraceHistogram* histogram,
+    uint8_t percentile) {
+    furi_check(histogram);
+    if(!histogram->count) return 0;
+
+    uint32_t target = ((uint32_t)histogram->count * percentile + 99) / 100;
+    if(!target) target = 1;
+
+    uint32_t seen = 0;
+    for(size_t i = 0; i < CONTAINER_TRACE_HISTOGRAM_BUCKETS - 1; i++) {
+        seen += histogram->buckets[i];
+        if(seen >= target) {
+            uint32_t upper = i ? (1UL << i) - 1 : 0;
+            return MIN(upper, histogram->max_ms);
+        }
+    }
+
+    return histogram->max_ms;
+}
+
+void container_trace_property_get(
+    ContainerTrace* trace,
+    PropertyValueCallback out,
+    char sep,
+    void* context) {
+    furi_check(trace);
+    furi_check(out);
+
+    FuriString* key = furi_string_alloc();
+    FuriString* value = furi_string_alloc();
+    PropertyValueContext property_context = {
+        .key = key, .value = value, .out = out, .sep = sep, .last = false, .context = context};
+
+    // Copy out first, out may block on a slow transport
+    ContainerTraceEvent* events = malloc(sizeof(ContainerTraceEvent) * CONTAINER_TRACE_CAPACITY);
+    uint32_t sequence = 0;
+    size_t count = container_trace_read(trace, &sequence, events, CONTAINER_TRACE_CAPACITY);
+
+    char index[12];
+    for(size_t i = 0; i < count; i++) {
+        snprintf(index, sizeof(index), "%lu", sequence - count + i);
+        property_value_out(
+            &property_context,
+            "%lu %lu %s %ld",
+            2,
+            "trace",
+            index,
+            events[i].timestamp,
+            events[i].container,
+            container_trace_event_name(events[i].type),
+            events[i].value);
+    }
+    free(events);
+
+    FuriString* image = furi_string_alloc();
+    ContainerTraceHistogram* phases =
+        malloc(sizeof(ContainerTraceHistogram) * CONTAINER_TRACE_PHASE_COUNT);
+    size_t image_index = 0;
+    for(; container_trace_get_image(trace, image_index, image, phases); image_index++) {
+        snprintf(index, sizeof(index), "%u", image_index);
+        property_value_out(
+            &property_context, NULL, 3, "image", index, "path", furi_string_get_cstr(image));
+
+        for(size_t phase = 0; phase < CONTAINER_TRACE_PHASE_COUNT; phase++) {
+            const ContainerTraceHistogram* histogram = &phases[phase];
+            if(!histogram->count) continue;
+
+            const char* name = container_trace_event_name(phase);
+            property_value_out(
+                &property_context, "%u", 4, "image", index, name, "count", histogram->count);
+            property_value_out(
+                &property_context,
+                "%lu",
+                4,
+                "image",
+                index,
+                name,
+                "mean",
+                histogram->total_ms / histogram->count);
+            property_value_out(
+                &property_context,
+                "%lu",
+                4,
+                "image",
+                index,
+                name,
+                "p50",
+                container_trace_histogram_percentile(histogram, 50));
+            property_value_out(
+                &property_context,
+                "%lu",
+                4,
+                "image",
+                index,
+                name,
+                "p90",
+                container_trace_histogram_percentile(histogram, 90));
+            property_value_out(
+                &property_context, "%lu", 4, "image", index, name, "max", histogram->max_ms);
+        }
+    }
+    free(phases);
+    furi_string_free(image);
+
+    property_context.last = true;
+    property_value_out(&property_context, "%u", 1, "images", image_index);
+
+    furi_string_free(key);
+    furi_string_free(value);
+}
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <furi.h>
+#include <toolbox/property.h>
+#include "container_runtime.h"
+
+/**
+ * @brief Container lifecycle trace
+ *
+ * Timestamped lifecycle events in a fixed size ring and per image latency
+ * histograms of the start-up phases.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Events kept in the ring, older ones are overwritten */
+#define CONTAINER_TRACE_CAPACITY 64
+
+/** Histogram bucket 0 counts 0ms, bucket n [2^(n-1), 2^n)ms, the last one everything above */
+#define CONTAINER_TRACE_HISTOGRAM_BUCKETS 12
+
+/** Lifecycle events, value meaning depends on the event */
+typedef enum {
+    ContainerTraceEventAdmission, // Admitted, ms since the start request
+    ContainerTraceEventImageStat, // Image file checked, ms
+    ContainerTraceEventElfOpen, // ELF headers parsed, ms
+    ContainerTraceEventSectionLoad, // Section table, assets and manifest read, ms
+    ContainerTraceEventRelocation, // Sections loaded and relocated or warm image mapped, ms
+    ContainerTraceEventInit, // Init arrays called, ms
+    ContainerTraceEventFirstTick, // Entry point reached, ms since the start request
+    ContainerTraceEventStop, // Exited on request, ms since the request
+    ContainerTraceEventCrash, // Exited on its own, return code
+    ContainerTraceEventCount,
+} ContainerTraceEventType;
+
+/** Events up to the first tick are start-up phases with a histogram */
+#define CONTAINER_TRACE_PHASE_COUNT (ContainerTraceEventFirstTick + 1)
+
+typedef struct ContainerTrace ContainerTrace;
+
+/** Binary trace record */
+typedef struct {
+    uint32_t timestamp; // Tick the event happened at
+    ContainerId container;
+    int32_t value;
+    uint8_t type; // ContainerTraceEventType
+} ContainerTraceEvent;
+
+/** Latency histogram of a start-up phase */
+typedef struct {
+    uint16_t buckets[CONTAINER_TRACE_HISTOGRAM_BUCKETS];
+    uint16_t count;
+    uint32_t total_ms;
+    uint32_t max_ms;
+} ContainerTraceHistogram;
+
+/**
+ * @brief Allocate a trace
+ *
+ * @return ContainerTrace*
+ */
+ContainerTrace* container_trace_alloc(void);
+
+/**
+ * @brief Free a trace
+ *
+ * @param trace
+ */
+void container_trace_free(ContainerTrace* trace);
+
+/**
+ * @brief Record an event
+ *
+ * Phase events are added to the histograms of the image as well.
+ *
+ * @param trace
+ * @param container
+ * @param image image of the container
+ * @param type
+ * @param timestamp tick the event happened at
+ * @param value see ContainerTraceEventType
+ */
+void container_trace_record(
+    ContainerTrace* trace,
+    ContainerId container,
+    const char* image,
+    ContainerTraceEventType type,
+    uint32_t timestamp,
+    int32_t value);
+
+/**
+ * @brief Read events in the order they were recorded
+ *
+ * Events overwritten since the last read are skipped.
+ *
+ * @param trace
+ * @param sequence sequence of the next event to read, 0 for the oldest one, updated
+ * @param events
+ * @param count capacity of events
+ * @return size_t number of events read
+ */
+size_t container_trace_read(
+    ContainerTrace* trace,
+    uint32_t* sequence,
+    ContainerTraceEvent* events,
+    size_t count);
+
+/**
+ * @brief Get the histograms of a traced image
+ *
+ * @param trace
+ * @param index image index
+ * @param image image path
+ * @param phases CONTAINER_TRACE_PHASE_COUNT histograms
+ * @return false once index is past the last image
+ */
+bool container_trace_get_image(
+    ContainerTrace* trace,
+    size_t index,
+    FuriString* image,
+    ContainerTraceHistogram* phases);
+
+/**
+ * @brief Drop every event and histogram
+ *
+ * @param trace
+ */
+void container_trace_reset(ContainerTrace* trace);
+
+/**
+ * @brief Get the name of an event
+ *
+ * @param type
+ * @return const char*
+ */
+const char* container_trace_event_name(ContainerTraceEventType type);
+
+/**
+ * @brief Estimate a latency percentile
+ *
+ * @param histogram
+ * @param percentile 1-100
+ * @return uint32_t upper bound of the bucket holding the percentile, ms
+ */
+uint32_t container_trace_histogram_percentile(
+    const ContainerTraceHistogram* histogram,
+    uint8_t percentile);
+
+/**
+ * @brief Output events and histograms as properties
+ *
+ * Keys are trace.<sequence> with "tick id event value" values,
+ * image.<index>.path, image.<index>.<phase>.<count|mean|p50|p90|max>
+ * and images with the number of images as the last one.
+ *
+ * @param trace
+ * @param out
+ * @param sep key part separator
+ * @param context
+ */
+void container_trace_property_get(
+    ContainerTrace* trace,
+    PropertyValueCallback out,
+    char sep,
+    void* context);
+
+#ifdef __cplusplus
+}
+#endif
@@ -12,6 +12,8 @@
 
 // System containers configuration path
 #define SYSTEM_CONTAINERS_PATH "/ext/resources/containerization/system-pod.json"
+// Compiled and validated copy of the system containers manifest
+#define SYSTEM_CONTAINERS_CACHE_PATH "/ext/resources/containerization/system-pod.bin"
 
 bool containerization_init(void) {
     ContainerRuntime* runtime = furi_get_container_runtime();
@@ -79,7 +81,8 @@ bool containerization_start_system_containers(void) {
     }
     
     // Load and instantiate system containers
-    PodManifest* manifest = pod_manifest_load_from_file(SYSTEM_CONTAINERS_PATH);
+    PodManifest* manifest =
+        pod_manifest_load_cached(SYSTEM_CONTAINERS_PATH, SYSTEM_CONTAINERS_CACHE_PATH);
     if(!manifest) {
         FURI_LOG_E(TAG, "Failed to load system containers manifest");
         return false;
@@ -109,14 +112,14 @@ size_t containerization_get_stats_string(char* buffer, size_t size) {
     }
     
     // Ultra-minimal stats - just container count and free memory
-    uint8_t count = container_runtime_get_count(runtime);
+    size_t count = container_runtime_get_count(runtime);
     uint32_t free_heap = memmgr_get_free_heap();
     uint32_t max_block = memmgr_heap_get_max_free_block();
     
     return snprintf(
         buffer, 
         size, 
-        "Pods: %u/8, Mem: %luK, Blk: %luK", 
+        "Pods: %zu, Mem: %luK, Blk: %luK", 
         count, 
         (unsigned long)(free_heap/1024), 
         (unsigned long)(max_block/1024));
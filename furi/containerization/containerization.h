@@ -12,11 +12,26 @@
 #include "container_runtime.h"
 #include "service_registry.h"
 #include "pod_manifest.h"
+#include "container_trace.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/**
+ * @brief Get the global container runtime
+ * 
+ * @return ContainerRuntime* or NULL before furi_init
+ */
+ContainerRuntime* furi_get_container_runtime(void);
+
+/**
+ * @brief Get the global service registry
+ * 
+ * @return ServiceRegistry* or NULL before furi_init
+ */
+ServiceRegistry* furi_get_service_registry(void);
+
 /**
  * @brief Initialize the containerization system
  * 
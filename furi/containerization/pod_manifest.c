@@ -2,25 +2,206 @@
 #include <furi.h>
 #include <storage/storage.h>
 #include <lib/flipper_format/flipper_format.h>
+#include <loader/firmware_api/firmware_api.h>
+#include <common/frozen/frozen.h>
+#include "containerization.h"
 #include <stdlib.h>
 #include <string.h>
 #include <furi/core/log.h>
 
 #define TAG "PodManifest"
 
-// Maximum allowed containers per manifest to prevent memory exhaustion
-#define MAX_CONTAINERS 8
+// Images preloaded ahead of instantiation, bounds memory held by the pipeline
+#define POD_MANIFEST_APPLY_LOOKAHEAD  2
+#define POD_MANIFEST_APPLY_STACK_SIZE (2 * 1024)
+
+#define POD_MANIFEST_CACHE_MAGIC   0x434D5046 // "FPMC"
+#define POD_MANIFEST_CACHE_VERSION 8
+#define POD_MANIFEST_CACHE_NO_STRING UINT32_MAX
+
+// Read only flags of a cache record are a byte
+#define POD_MANIFEST_MAX_VOLUME_MOUNTS 8
+
+// File bytes read at once by the JSON reader
+#define POD_MANIFEST_JSON_CHUNK_SIZE 64
+// Working buffer of pod_manifest_load_from_file for JSON manifests, bounds container objects
+#define POD_MANIFEST_JSON_BUFFER_SIZE 512
 
 struct PodManifest {
     char* name;
     char* namespace;
     PodContainerSpec* containers;
     uint32_t container_count;
+    uint8_t* blob; // Cache contents all strings point into, NULL for parsed manifests
 };
 
-PodManifest* pod_manifest_load_from_file(const char* path) {
-    furi_assert(path);
-    
+/* Compiled manifest cache layout:
+ * header, container_count records, string table of NUL terminated strings.
+ * Strings are referenced by offset into the string table. */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t container_count;
+    uint32_t source_timestamp; // Source manifest modification time
+    uint32_t source_size;
+    uint32_t strings_size;
+    uint32_t name;
+    uint32_t namespace;
+} PodManifestCacheHeader;
+
+typedef struct {
+    uint32_t name;
+    uint32_t image;
+    uint32_t args; // POD_MANIFEST_CACHE_NO_STRING if none
+    uint32_t health_check; // Command or endpoint, POD_MANIFEST_CACHE_NO_STRING if none
+    uint32_t initial_delay_ms;
+    uint32_t period_ms;
+    uint32_t timeout_ms;
+    uint32_t success_threshold;
+    uint32_t failure_threshold;
+    uint32_t max_memory;
+    uint32_t cpu_time_share;
+    uint32_t max_threads;
+    uint32_t io_bytes_per_second;
+    uint32_t volume_mounts; // Name and mount path string pairs, back to back
+    uint8_t restart_policy;
+    uint8_t system_privileges;
+    uint8_t warm_restart;
+    uint8_t priority_class;
+    uint8_t health_check_type;
+    uint8_t volume_mount_count;
+    uint8_t volume_read_only; // Bit per volume mount
+    uint8_t reserved;
+} PodManifestCacheRecord;
+
+static const char* const pod_manifest_priority_classes[] = {
+    [ContainerPriorityClassBestEffort] = "BestEffort",
+    [ContainerPriorityClassNormal] = "Normal",
+    [ContainerPriorityClassHigh] = "High",
+    [ContainerPriorityClassSystem] = "System",
+};
+
+static bool
+    pod_manifest_parse_priority_class(const char* value, ContainerPriorityClass* priority) {
+    for(size_t i = 0; i < COUNT_OF(pod_manifest_priority_classes); i++) {
+        if(strcmp(value, pod_manifest_priority_classes[i]) == 0) {
+            *priority = i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static const char* const pod_manifest_restart_policies[] = {
+    [ContainerRestartPolicyNever] = "Never",
+    [ContainerRestartPolicyOnFailure] = "OnFailure",
+    [ContainerRestartPolicyAlways] = "Always",
+};
+
+static bool
+    pod_manifest_parse_restart_policy(const char* value, ContainerRestartPolicy* policy) {
+    for(size_t i = 0; i < COUNT_OF(pod_manifest_restart_policies); i++) {
+        if(strcmp(value, pod_manifest_restart_policies[i]) == 0) {
+            *policy = i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void pod_manifest_free_volume_mounts(VolumeMountSpec* volume_mounts, uint32_t count) {
+    for(uint32_t i = 0; i < count; i++) {
+        free((void*)volume_mounts[i].name);
+        free((void*)volume_mounts[i].mount_path);
+    }
+    free(volume_mounts);
+}
+
+// VolumeMounts<N>, "name:/path[:ro]" separated by commas
+static bool pod_manifest_parse_volume_mounts(const char* value, PodContainerSpec* spec) {
+    uint32_t count = 1;
+    for(const char* c = value; *c; c++) {
+        if(*c == ',') count++;
+    }
+    if(count > POD_MANIFEST_MAX_VOLUME_MOUNTS) return false;
+
+    VolumeMountSpec* volume_mounts = malloc(sizeof(VolumeMountSpec) * count);
+    uint32_t parsed = 0;
+    bool success = true;
+
+    while(parsed < count) {
+        while(*value == ' ') value++;
+        const char* next = strchr(value, ',');
+        if(!next) next = value + strlen(value);
+        const char* end = next;
+        while(end > value && end[-1] == ' ') end--;
+
+        const char* path = memchr(value, ':', end - value);
+        if(!path || path == value) {
+            success = false;
+            break;
+        }
+
+        const char* path_end = memchr(path + 1, ':', end - path - 1);
+        const bool read_only = path_end != NULL;
+        if(!path_end) {
+            path_end = end;
+        } else if(end - path_end != 3 || strncmp(path_end, ":ro", 3) != 0) {
+            success = false;
+            break;
+        }
+
+        VolumeMountSpec* volume = &volume_mounts[parsed++];
+        volume->name = strndup(value, path - value);
+        volume->mount_path = strndup(path + 1, path_end - path - 1);
+        volume->read_only = read_only;
+        value = *next ? next + 1 : next;
+    }
+
+    if(!success) {
+        pod_manifest_free_volume_mounts(volume_mounts, parsed);
+        return false;
+    }
+
+    spec->volume_mounts = volume_mounts;
+    spec->volume_mount_count = count;
+    return true;
+}
+
+// Command health check, HealthCheck<N> with optional HealthCheck<Field><N> timings
+static void pod_manifest_read_health_check(
+    FlipperFormat* format,
+    uint32_t index,
+    FuriString* temp_str,
+    HealthCheckSpec* health_check) {
+    char key[32];
+
+    health_check->type = HealthCheckTypeNone;
+    snprintf(key, sizeof(key), "HealthCheck%lu", (unsigned long)index);
+    if(!flipper_format_read_string(format, key, temp_str)) return;
+
+    health_check->type = HealthCheckTypeCommand;
+    health_check->command = strdup(furi_string_get_cstr(temp_str));
+
+    const struct {
+        const char* name;
+        uint32_t* value;
+    } fields[] = {
+        {"Delay", &health_check->initial_delay_ms},
+        {"Period", &health_check->period_ms},
+        {"Timeout", &health_check->timeout_ms},
+        {"Success", &health_check->success_threshold},
+        {"Failure", &health_check->failure_threshold},
+    };
+    for(size_t i = 0; i < COUNT_OF(fields); i++) {
+        snprintf(key, sizeof(key), "HealthCheck%s%lu", fields[i].name, (unsigned long)index);
+        flipper_format_read_uint32(format, key, fields[i].value, 1);
+    }
+}
+
+static PodManifest* pod_manifest_load_flipper_format(const char* path) {
     Storage* storage = furi_record_open(RECORD_STORAGE);
     FlipperFormat* format = flipper_format_file_alloc(storage);
     
@@ -71,11 +252,11 @@ PodManifest* pod_manifest_load_from_file(const char* path) {
             break;
         }
         
-        // Limit container count to prevent memory exhaustion
-        if(container_count > MAX_CONTAINERS) {
-            FURI_LOG_W(TAG, "Container count %lu exceeds maximum, limiting to %d", 
-                      (unsigned long)container_count, MAX_CONTAINERS);
-            container_count = MAX_CONTAINERS;
+        // Runtime capacity grows with free heap, only the spec array itself must fit
+        if(container_count > UINT16_MAX ||
+           sizeof(PodContainerSpec) * container_count > memmgr_heap_get_max_free_block()) {
+            FURI_LOG_E(TAG, "Container count %lu doesn't fit in memory", container_count);
+            break;
         }
         
         manifest->container_count = container_count;
@@ -132,14 +313,32 @@ PodManifest* pod_manifest_load_from_file(const char* path) {
             } else {
                 spec->resources.max_threads = 3; // 3 threads default
             }
+
+            // Storage throughput in bytes per second (optional), unlimited by default
+            snprintf(container_key, sizeof(container_key), "IoLimit%lu", (unsigned long)i);
+            uint32_t io_limit = 0;
+            flipper_format_read_uint32(format, container_key, &io_limit, 1);
+            spec->resources.io_bytes_per_second = io_limit;
             
-            // Read restart policy (optional)
-            snprintf(container_key, sizeof(container_key), "RestartOnCrash%lu", (unsigned long)i);
-            uint32_t restart;
-            if(flipper_format_read_uint32(format, container_key, &restart, 1)) {
-                spec->restart_on_crash = restart != 0;
+            // Read restart policy (optional), RestartOnCrash<N> of older manifests is
+            // Always or Never
+            spec->restart_policy = ContainerRestartPolicyAlways;
+            snprintf(container_key, sizeof(container_key), "RestartPolicy%lu", (unsigned long)i);
+            if(flipper_format_read_string(format, container_key, temp_str)) {
+                if(!pod_manifest_parse_restart_policy(
+                       furi_string_get_cstr(temp_str), &spec->restart_policy)) {
+                    FURI_LOG_W(
+                        TAG,
+                        "Unknown restart policy %s, using Always",
+                        furi_string_get_cstr(temp_str));
+                }
             } else {
-                spec->restart_on_crash = true; // Default to true
+                snprintf(
+                    container_key, sizeof(container_key), "RestartOnCrash%lu", (unsigned long)i);
+                uint32_t restart;
+                if(flipper_format_read_uint32(format, container_key, &restart, 1) && !restart) {
+                    spec->restart_policy = ContainerRestartPolicyNever;
+                }
             }
             
             // Read system privileges (optional)
@@ -151,12 +350,35 @@ PodManifest* pod_manifest_load_from_file(const char* path) {
                 spec->system_privileges = false; // Default to false
             }
             
-            // Default health check type to None
-            spec->health_check.type = HealthCheckTypeNone;
+            // Keep parsed image for restarts (optional)
+            snprintf(container_key, sizeof(container_key), "WarmRestart%lu", (unsigned long)i);
+            uint32_t warm_restart;
+            if(flipper_format_read_uint32(format, container_key, &warm_restart, 1)) {
+                spec->warm_restart = warm_restart != 0;
+            } else {
+                spec->warm_restart = false;
+            }
+            
+            // Preemption class (optional)
+            snprintf(container_key, sizeof(container_key), "PriorityClass%lu", (unsigned long)i);
+            spec->priority_class = ContainerPriorityClassNormal;
+            if(flipper_format_read_string(format, container_key, temp_str) &&
+               !pod_manifest_parse_priority_class(
+                   furi_string_get_cstr(temp_str), &spec->priority_class)) {
+                FURI_LOG_W(
+                    TAG,
+                    "Unknown priority class %s, using Normal",
+                    furi_string_get_cstr(temp_str));
+            }
+            
+            pod_manifest_read_health_check(format, i, temp_str, &spec->health_check);
             
-            // Volume mounts not implemented in this version
-            spec->volume_mounts = NULL;
-            spec->volume_mount_count = 0;
+            // Pod volumes (optional)
+            snprintf(container_key, sizeof(container_key), "VolumeMounts%lu", (unsigned long)i);
+            if(flipper_format_read_string(format, container_key, temp_str) &&
+               !pod_manifest_parse_volume_mounts(furi_string_get_cstr(temp_str), spec)) {
+                FURI_LOG_W(TAG, "Invalid volume mounts %s", furi_string_get_cstr(temp_str));
+            }
         }
         
         FURI_LOG_I(
@@ -182,6 +404,585 @@ PodManifest* pod_manifest_load_from_file(const char* path) {
     return manifest;
 }
 
+/** Reads JSON values from a file through a small chunk, or in place from memory */
+typedef struct {
+    File* file; // NULL for memory sources
+    const char* data; // Chunk or memory source
+    size_t size;
+    size_t pos;
+    char chunk[POD_MANIFEST_JSON_CHUNK_SIZE];
+    char* buffer; // Caller buffer file values are copied to
+    size_t buffer_size;
+    const char* value; // Last captured value
+    size_t length;
+} PodManifestJsonReader;
+
+/** Pod wide settings applied once every container was read */
+typedef struct {
+    PodManifest* manifest;
+    uint32_t capacity; // Allocated container specs
+    int8_t* restart_policies; // Per container, -1 to follow restartPolicy
+    ContainerRestartPolicy restart_policy; // From restartPolicy
+} PodManifestJsonContext;
+
+typedef bool (*PodManifestJsonMemberCallback)(PodManifestJsonReader* reader, void* context);
+
+static int pod_manifest_json_peek(PodManifestJsonReader* reader) {
+    if(reader->pos == reader->size) {
+        if(!reader->file) return -1;
+        reader->data = reader->chunk;
+        reader->size = storage_file_read(reader->file, reader->chunk, sizeof(reader->chunk));
+        reader->pos = 0;
+        if(reader->size == 0) return -1;
+    }
+
+    return (uint8_t)reader->data[reader->pos];
+}
+
+static bool pod_manifest_json_is_space(int c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+static int pod_manifest_json_skip_space(PodManifestJsonReader* reader) {
+    int c;
+    while(pod_manifest_json_is_space(c = pod_manifest_json_peek(reader))) {
+        reader->pos++;
+    }
+    return c;
+}
+
+static bool pod_manifest_json_expect(PodManifestJsonReader* reader, char expected) {
+    if(pod_manifest_json_skip_space(reader) != expected) return false;
+    reader->pos++;
+    return true;
+}
+
+// Reads one complete value. File values are copied to the caller buffer when
+// kept, memory values are referenced in place.
+static bool pod_manifest_json_capture(PodManifestJsonReader* reader, bool keep) {
+    int c = pod_manifest_json_skip_space(reader);
+    const bool scalar = c != '"' && c != '{' && c != '[';
+    bool in_string = false;
+    bool escape = false;
+    int depth = 0;
+
+    reader->value = reader->file ? reader->buffer : reader->data + reader->pos;
+    reader->length = 0;
+
+    while(true) {
+        c = pod_manifest_json_peek(reader);
+        if(c < 0) return false;
+        if(scalar && (c == ',' || c == '}' || c == ']' || pod_manifest_json_is_space(c))) break;
+
+        if(reader->file && keep) {
+            if(reader->length == reader->buffer_size) {
+                FURI_LOG_E(TAG, "JSON value exceeds %zu byte buffer", reader->buffer_size);
+                return false;
+            }
+            reader->buffer[reader->length] = c;
+        }
+        reader->pos++;
+        reader->length++;
+
+        if(in_string) {
+            if(escape) {
+                escape = false;
+            } else if(c == '\\') {
+                escape = true;
+            } else if(c == '"') {
+                in_string = false;
+            }
+        } else if(c == '"') {
+            in_string = true;
+        } else if(c == '{' || c == '[') {
+            depth++;
+        } else if(c == '}' || c == ']') {
+            depth--;
+        }
+
+        if(!scalar && !in_string && depth == 0) break;
+    }
+
+    return reader->length > 0;
+}
+
+static bool pod_manifest_json_value_is(const PodManifestJsonReader* reader, const char* string) {
+    const size_t length = strlen(string);
+    return reader->length == length + 2 && reader->value[0] == '"' &&
+           memcmp(reader->value + 1, string, length) == 0;
+}
+
+// Unescaped copy of a captured string value
+static char* pod_manifest_json_string(const PodManifestJsonReader* reader) {
+    if(reader->length < 2 || reader->value[0] != '"') return NULL;
+
+    const int length = json_unescape(reader->value + 1, reader->length - 2, NULL, 0);
+    if(length < 0) return NULL;
+
+    char* string = malloc(length + 1);
+    json_unescape(reader->value + 1, reader->length - 2, string, length);
+    string[length] = '\0';
+
+    return string;
+}
+
+// Streams the members of an object, the callback reads or skips each value
+static bool pod_manifest_json_parse_object(
+    PodManifestJsonReader* reader,
+    PodManifestJsonMemberCallback callback,
+    void* context) {
+    if(!pod_manifest_json_expect(reader, '{')) return false;
+    if(pod_manifest_json_skip_space(reader) == '}') {
+        reader->pos++;
+        return true;
+    }
+
+    while(true) {
+        if(!pod_manifest_json_capture(reader, true) || reader->value[0] != '"' ||
+           !pod_manifest_json_expect(reader, ':') || !callback(reader, context)) {
+            return false;
+        }
+
+        const int c = pod_manifest_json_skip_space(reader);
+        reader->pos++;
+        if(c == '}') return true;
+        if(c != ',') return false;
+    }
+}
+
+// Streams the elements of an array, the callback reads each value
+static bool pod_manifest_json_parse_array(
+    PodManifestJsonReader* reader,
+    PodManifestJsonMemberCallback callback,
+    void* context) {
+    if(!pod_manifest_json_expect(reader, '[')) return false;
+    if(pod_manifest_json_skip_space(reader) == ']') {
+        reader->pos++;
+        return true;
+    }
+
+    while(true) {
+        if(!callback(reader, context)) return false;
+
+        const int c = pod_manifest_json_skip_space(reader);
+        reader->pos++;
+        if(c == ']') return true;
+        if(c != ',') return false;
+    }
+}
+
+// Byte quantity, plain or with a K/Ki/M/Mi suffix as in "4K"
+static void pod_manifest_json_scan_quantity(const char* str, int len, void* user_data) {
+    uint32_t* quantity = user_data;
+    uint32_t value = 0;
+    int i = 0;
+
+    for(; i < len && str[i] >= '0' && str[i] <= '9'; i++) {
+        value = value * 10 + (str[i] - '0');
+    }
+
+    if(i < len && (str[i] == 'K' || str[i] == 'k')) {
+        value *= 1024;
+        i++;
+    } else if(i < len && str[i] == 'M') {
+        value *= 1024 * 1024;
+        i++;
+    }
+    if(i < len && str[i] == 'i') i++;
+
+    if(i == 0 || i != len) {
+        FURI_LOG_W(TAG, "Invalid memory quantity %.*s", len, str);
+        return;
+    }
+
+    *quantity = value;
+}
+
+// exec.command, words of an array joined with spaces or a single string
+static void pod_manifest_json_scan_command(const char* str, int len, void* user_data) {
+    char** command = user_data;
+    // Joined words are never longer than the array they came from
+    char* value = malloc(len + 1);
+    size_t size = 0;
+
+    if(len > 0 && str[0] == '[') {
+        struct json_token token;
+        for(int i = 0; json_scanf_array_elem(str, len, "", i, &token) >= 0; i++) {
+            if(size) value[size++] = ' ';
+            memcpy(value + size, token.ptr, token.len);
+            size += token.len;
+        }
+    } else {
+        memcpy(value, str, len);
+        size = len;
+    }
+    value[size] = '\0';
+
+    free(*command);
+    *command = value;
+}
+
+// volumeMounts, array of {name, mountPath, readOnly}
+static void pod_manifest_json_scan_volume_mounts(const char* str, int len, void* user_data) {
+    PodContainerSpec* spec = user_data;
+    struct json_token token;
+
+    uint32_t count = 0;
+    while(json_scanf_array_elem(str, len, "", count, &token) >= 0) {
+        count++;
+    }
+    if(!count) return;
+    if(count > POD_MANIFEST_MAX_VOLUME_MOUNTS) {
+        FURI_LOG_W(TAG, "More than %u volume mounts", POD_MANIFEST_MAX_VOLUME_MOUNTS);
+        return;
+    }
+
+    VolumeMountSpec* volume_mounts = malloc(sizeof(VolumeMountSpec) * count);
+    for(uint32_t i = 0; i < count; i++) {
+        VolumeMountSpec* volume = &volume_mounts[i];
+        json_scanf_array_elem(str, len, "", i, &token);
+        json_scanf(
+            token.ptr,
+            token.len,
+            "{name: %Q, mountPath: %Q, readOnly: %B}",
+            &volume->name,
+            &volume->mount_path,
+            &volume->read_only);
+
+        if(!volume->name || !volume->mount_path) {
+            FURI_LOG_W(TAG, "Volume mount without name or mountPath");
+            pod_manifest_free_volume_mounts(volume_mounts, i + 1);
+            return;
+        }
+    }
+
+    spec->volume_mounts = volume_mounts;
+    spec->volume_mount_count = count;
+}
+
+// livenessProbe, Kubernetes field names with timings in seconds
+static void pod_manifest_json_scan_probe(const char* str, int len, void* user_data) {
+    HealthCheckSpec* health_check = user_data;
+    char* command = NULL;
+    char* path = NULL;
+    int delay = 0;
+    int period = 0;
+    int timeout = 0;
+    int success = 0;
+    int failure = 0;
+
+    json_scanf(
+        str,
+        len,
+        "{exec: {command: %M}, httpGet: {path: %Q}, initialDelaySeconds: %d, periodSeconds: %d, "
+        "timeoutSeconds: %d, successThreshold: %d, failureThreshold: %d}",
+        pod_manifest_json_scan_command,
+        &command,
+        &path,
+        &delay,
+        &period,
+        &timeout,
+        &success,
+        &failure);
+
+    if(command && command[0]) {
+        health_check->type = HealthCheckTypeCommand;
+        health_check->command = command;
+        free(path);
+    } else if(path) {
+        free(command);
+        health_check->type = HealthCheckTypeHttp;
+        health_check->endpoint = path;
+    } else {
+        FURI_LOG_W(TAG, "Unsupported livenessProbe");
+        free(command);
+        return;
+    }
+
+    health_check->initial_delay_ms = MAX(delay, 0) * 1000;
+    health_check->period_ms = MAX(period, 0) * 1000;
+    health_check->timeout_ms = MAX(timeout, 0) * 1000;
+    health_check->success_threshold = MAX(success, 0);
+    health_check->failure_threshold = MAX(failure, 0);
+}
+
+static bool pod_manifest_json_parse_container(PodManifestJsonReader* reader, void* context) {
+    PodManifestJsonContext* json = context;
+    PodManifest* manifest = json->manifest;
+
+    // Whole container object goes through the caller buffer
+    if(!pod_manifest_json_capture(reader, true) || reader->value[0] != '{') return false;
+
+    if(manifest->container_count == json->capacity) {
+        if(json->capacity == UINT16_MAX) return false;
+        json->capacity = MIN(json->capacity ? json->capacity * 2 : 2, (uint32_t)UINT16_MAX);
+        manifest->containers =
+            realloc(manifest->containers, sizeof(PodContainerSpec) * json->capacity);
+        json->restart_policies = realloc(json->restart_policies, json->capacity);
+    }
+
+    PodContainerSpec* spec = &manifest->containers[manifest->container_count];
+    memset(spec, 0, sizeof(PodContainerSpec));
+
+    // Same defaults as the FlipperFormat manifest
+    char* name = NULL;
+    char* image = NULL;
+    char* args = NULL;
+    char* priority_class = NULL;
+    char* restart_policy = NULL;
+    uint32_t memory = 32 * 1024;
+    uint32_t io_limit = 0;
+    int cpu = 50;
+    int threads = 3;
+    bool privileged = false;
+    bool warm_restart = false;
+    int8_t restart_on_crash = -1; // Older manifests, restartPolicy takes precedence
+
+    json_scanf(
+        reader->value,
+        reader->length,
+        "{name: %Q, image: %Q, args: %Q, priorityClassName: %Q, warmRestart: %B, "
+        "restartPolicy: %Q, restartOnCrash: %B, "
+        "resources: {limits: {memory: %M, cpu: %d, threads: %d, io: %M}}, "
+        "securityContext: {privileged: %B}, livenessProbe: %M, volumeMounts: %M}",
+        &name,
+        &image,
+        &args,
+        &priority_class,
+        &warm_restart,
+        &restart_policy,
+        &restart_on_crash,
+        pod_manifest_json_scan_quantity,
+        &memory,
+        &cpu,
+        &threads,
+        pod_manifest_json_scan_quantity,
+        &io_limit,
+        &privileged,
+        pod_manifest_json_scan_probe,
+        &spec->health_check,
+        pod_manifest_json_scan_volume_mounts,
+        spec);
+
+    spec->priority_class = ContainerPriorityClassNormal;
+    if(priority_class && !pod_manifest_parse_priority_class(priority_class, &spec->priority_class)) {
+        FURI_LOG_W(TAG, "Unknown priority class %s, using Normal", priority_class);
+    }
+    free(priority_class);
+
+    // Pod restartPolicy unless set, restartOnCrash is Always or Never
+    int8_t container_restart_policy = -1;
+    if(restart_on_crash >= 0) {
+        container_restart_policy = restart_on_crash ? ContainerRestartPolicyAlways :
+                                                      ContainerRestartPolicyNever;
+    }
+    ContainerRestartPolicy policy;
+    if(restart_policy && pod_manifest_parse_restart_policy(restart_policy, &policy)) {
+        container_restart_policy = policy;
+    } else if(restart_policy) {
+        FURI_LOG_W(TAG, "Unknown restart policy %s", restart_policy);
+    }
+    free(restart_policy);
+
+    if(!name || !image || cpu < 0 || threads < 0) {
+        FURI_LOG_E(TAG, "Container %lu: invalid spec", manifest->container_count);
+        free(name);
+        free(image);
+        free(args);
+        if(spec->health_check.type != HealthCheckTypeNone) {
+            free((void*)spec->health_check.command);
+        }
+        pod_manifest_free_volume_mounts(spec->volume_mounts, spec->volume_mount_count);
+        return false;
+    }
+
+    spec->name = name;
+    spec->image = image;
+    spec->args = args;
+    spec->resources.max_memory = memory;
+    spec->resources.cpu_time_share = cpu;
+    spec->resources.max_threads = threads;
+    spec->resources.io_bytes_per_second = io_limit;
+    spec->system_privileges = privileged;
+    spec->warm_restart = warm_restart;
+    // restartPolicy may follow the containers, resolved once the pod is read
+    json->restart_policies[manifest->container_count++] = container_restart_policy;
+
+    return true;
+}
+
+static bool pod_manifest_json_parse_metadata(PodManifestJsonReader* reader, void* context) {
+    PodManifest* manifest = ((PodManifestJsonContext*)context)->manifest;
+
+    if(pod_manifest_json_value_is(reader, "name")) {
+        if(!pod_manifest_json_capture(reader, true)) return false;
+        free(manifest->name);
+        manifest->name = pod_manifest_json_string(reader);
+    } else if(pod_manifest_json_value_is(reader, "namespace")) {
+        if(!pod_manifest_json_capture(reader, true)) return false;
+        free(manifest->namespace);
+        manifest->namespace = pod_manifest_json_string(reader);
+    } else {
+        return pod_manifest_json_capture(reader, false);
+    }
+
+    return true;
+}
+
+static bool pod_manifest_json_parse_spec(PodManifestJsonReader* reader, void* context) {
+    PodManifestJsonContext* json = context;
+
+    if(pod_manifest_json_value_is(reader, "containers")) {
+        return pod_manifest_json_parse_array(reader, pod_manifest_json_parse_container, context);
+    } else if(pod_manifest_json_value_is(reader, "restartPolicy")) {
+        if(!pod_manifest_json_capture(reader, true)) return false;
+        for(size_t i = 0; i < COUNT_OF(pod_manifest_restart_policies); i++) {
+            if(pod_manifest_json_value_is(reader, pod_manifest_restart_policies[i])) {
+                json->restart_policy = i;
+            }
+        }
+        return true;
+    }
+
+    return pod_manifest_json_capture(reader, false);
+}
+
+static bool pod_manifest_json_parse_pod(PodManifestJsonReader* reader, void* context) {
+    if(pod_manifest_json_value_is(reader, "metadata")) {
+        return pod_manifest_json_parse_object(reader, pod_manifest_json_parse_metadata, context);
+    } else if(pod_manifest_json_value_is(reader, "spec")) {
+        return pod_manifest_json_parse_object(reader, pod_manifest_json_parse_spec, context);
+    } else if(pod_manifest_json_value_is(reader, "kind")) {
+        if(!pod_manifest_json_capture(reader, true)) return false;
+        if(!pod_manifest_json_value_is(reader, "Pod")) {
+            FURI_LOG_E(TAG, "Manifest is not a Pod");
+            return false;
+        }
+        return true;
+    }
+
+    return pod_manifest_json_capture(reader, false);
+}
+
+static PodManifest* pod_manifest_json_parse(PodManifestJsonReader* reader) {
+    PodManifest* manifest = malloc(sizeof(PodManifest));
+    memset(manifest, 0, sizeof(PodManifest));
+
+    PodManifestJsonContext context = {
+        .manifest = manifest,
+        .capacity = 0,
+        .restart_policies = NULL,
+        .restart_policy = ContainerRestartPolicyAlways, // Kubernetes default
+    };
+
+    bool success = pod_manifest_json_parse_object(reader, pod_manifest_json_parse_pod, &context);
+
+    for(uint32_t i = 0; i < manifest->container_count; i++) {
+        const int8_t restart_policy = context.restart_policies[i];
+        manifest->containers[i].restart_policy =
+            restart_policy < 0 ? context.restart_policy : (ContainerRestartPolicy)restart_policy;
+    }
+    free(context.restart_policies);
+
+    if(success && (!manifest->name || manifest->container_count == 0)) {
+        FURI_LOG_E(TAG, "Missing pod name or containers");
+        success = false;
+    }
+
+    if(!success) {
+        FURI_LOG_E(TAG, "Invalid JSON manifest");
+        pod_manifest_free(manifest);
+        return NULL;
+    }
+
+    if(!manifest->namespace) manifest->namespace = strdup("default");
+
+    // Drop the growth slack
+    manifest->containers =
+        realloc(manifest->containers, sizeof(PodContainerSpec) * manifest->container_count);
+
+    FURI_LOG_I(
+        TAG,
+        "Loaded pod manifest: %s/%s with %lu containers",
+        manifest->namespace,
+        manifest->name,
+        manifest->container_count);
+
+    return manifest;
+}
+
+PodManifest* pod_manifest_load_from_file_buffered(
+    const char* path,
+    char* buffer,
+    size_t buffer_size) {
+    furi_check(path);
+    furi_check(buffer);
+    furi_check(buffer_size);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    PodManifest* manifest = NULL;
+
+    if(storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        PodManifestJsonReader reader = {
+            .file = file,
+            .buffer = buffer,
+            .buffer_size = buffer_size,
+        };
+        manifest = pod_manifest_json_parse(&reader);
+    } else {
+        FURI_LOG_E(TAG, "Failed to open %s", path);
+    }
+
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return manifest;
+}
+
+PodManifest* pod_manifest_create_from_json(const char* json_data) {
+    furi_check(json_data);
+
+    PodManifestJsonReader reader = {
+        .data = json_data,
+        .size = strlen(json_data),
+    };
+
+    return pod_manifest_json_parse(&reader);
+}
+
+// Manifests are either JSON or FlipperFormat, whatever the file extension
+static bool pod_manifest_file_is_json(const char* path) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    bool json = false;
+
+    if(storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        PodManifestJsonReader reader = {.file = file};
+        json = pod_manifest_json_skip_space(&reader) == '{';
+    }
+
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    return json;
+}
+
+PodManifest* pod_manifest_load_from_file(const char* path) {
+    furi_assert(path);
+
+    if(!pod_manifest_file_is_json(path)) {
+        return pod_manifest_load_flipper_format(path);
+    }
+
+    char* buffer = malloc(POD_MANIFEST_JSON_BUFFER_SIZE);
+    PodManifest* manifest =
+        pod_manifest_load_from_file_buffered(path, buffer, POD_MANIFEST_JSON_BUFFER_SIZE);
+    free(buffer);
+
+    return manifest;
+}
+
 // Enhanced validation - check each container
 bool pod_manifest_validate(PodManifest* manifest) {
     if(!manifest) return false;
@@ -227,8 +1028,314 @@ bool pod_manifest_validate(PodManifest* manifest) {
     return all_valid;
 }
 
+static bool pod_manifest_cache_string_valid(const PodManifestCacheHeader* header, uint32_t offset) {
+    return offset < header->strings_size;
+}
+
+// Map a cache blob, only structure is checked: contents were validated when compiled
+static PodManifest* pod_manifest_cache_map(uint8_t* blob, size_t size) {
+    if(size < sizeof(PodManifestCacheHeader)) return NULL;
+
+    const PodManifestCacheHeader* header = (const PodManifestCacheHeader*)blob;
+    const size_t records_size = header->container_count * sizeof(PodManifestCacheRecord);
+    if(header->container_count == 0 ||
+       size != sizeof(PodManifestCacheHeader) + records_size + header->strings_size) {
+        return NULL;
+    }
+
+    const PodManifestCacheRecord* records =
+        (const PodManifestCacheRecord*)(blob + sizeof(PodManifestCacheHeader));
+    char* strings = (char*)blob + sizeof(PodManifestCacheHeader) + records_size;
+
+    // Terminated string table keeps every offset a valid C string
+    if(header->strings_size == 0 || strings[header->strings_size - 1] != '\0' ||
+       !pod_manifest_cache_string_valid(header, header->name) ||
+       !pod_manifest_cache_string_valid(header, header->namespace)) {
+        return NULL;
+    }
+
+    // Volume mounts are the only part not pointing straight into the blob
+    size_t volume_mount_count = 0;
+    for(uint32_t i = 0; i < header->container_count; i++) {
+        if(records[i].volume_mount_count > POD_MANIFEST_MAX_VOLUME_MOUNTS) return NULL;
+        volume_mount_count += records[i].volume_mount_count;
+    }
+
+    PodManifest* manifest = malloc(sizeof(PodManifest));
+    memset(manifest, 0, sizeof(PodManifest));
+    manifest->name = strings + header->name;
+    manifest->namespace = strings + header->namespace;
+    manifest->container_count = header->container_count;
+    manifest->containers = malloc(sizeof(PodContainerSpec) * header->container_count);
+    memset(manifest->containers, 0, sizeof(PodContainerSpec) * header->container_count);
+    manifest->blob = blob;
+
+    VolumeMountSpec* volume_mounts =
+        volume_mount_count ? malloc(sizeof(VolumeMountSpec) * volume_mount_count) : NULL;
+
+    for(uint32_t i = 0; i < header->container_count; i++) {
+        const PodManifestCacheRecord* record = &records[i];
+        PodContainerSpec* spec = &manifest->containers[i];
+
+        // Pairs follow each other, each string ends inside the terminated table
+        uint32_t volume_string = record->volume_mounts;
+        bool volumes_valid = true;
+        for(uint8_t j = 0; j < record->volume_mount_count * 2 && volumes_valid; j++) {
+            volumes_valid = pod_manifest_cache_string_valid(header, volume_string);
+            if(volumes_valid) volume_string += strlen(strings + volume_string) + 1;
+        }
+
+        if(!volumes_valid || !pod_manifest_cache_string_valid(header, record->name) ||
+           !pod_manifest_cache_string_valid(header, record->image) ||
+           (record->args != POD_MANIFEST_CACHE_NO_STRING &&
+            !pod_manifest_cache_string_valid(header, record->args)) ||
+           (record->health_check != POD_MANIFEST_CACHE_NO_STRING &&
+            !pod_manifest_cache_string_valid(header, record->health_check))) {
+            // Caller keeps ownership of the blob on failure
+            free(volume_mounts);
+            free(manifest->containers);
+            free(manifest);
+            return NULL;
+        }
+
+        if(record->volume_mount_count) {
+            // First spec with mounts owns the whole array
+            spec->volume_mounts = volume_mounts;
+            spec->volume_mount_count = record->volume_mount_count;
+            volume_string = record->volume_mounts;
+            for(uint8_t j = 0; j < record->volume_mount_count; j++) {
+                VolumeMountSpec* volume = &volume_mounts[j];
+                volume->name = strings + volume_string;
+                volume_string += strlen(volume->name) + 1;
+                volume->mount_path = strings + volume_string;
+                volume_string += strlen(volume->mount_path) + 1;
+                volume->read_only = record->volume_read_only & (1 << j);
+            }
+            volume_mounts += record->volume_mount_count;
+        }
+
+        spec->name = strings + record->name;
+        spec->image = strings + record->image;
+        if(record->args != POD_MANIFEST_CACHE_NO_STRING) spec->args = strings + record->args;
+        spec->resources.max_memory = record->max_memory;
+        spec->resources.cpu_time_share = record->cpu_time_share;
+        spec->resources.max_threads = record->max_threads;
+        spec->resources.io_bytes_per_second = record->io_bytes_per_second;
+        spec->restart_policy = record->restart_policy;
+        spec->system_privileges = record->system_privileges;
+        spec->warm_restart = record->warm_restart;
+        spec->priority_class = record->priority_class;
+        if(record->health_check != POD_MANIFEST_CACHE_NO_STRING) {
+            spec->health_check.type = record->health_check_type;
+            spec->health_check.command = strings + record->health_check;
+            spec->health_check.initial_delay_ms = record->initial_delay_ms;
+            spec->health_check.period_ms = record->period_ms;
+            spec->health_check.timeout_ms = record->timeout_ms;
+            spec->health_check.success_threshold = record->success_threshold;
+            spec->health_check.failure_threshold = record->failure_threshold;
+        }
+    }
+
+    return manifest;
+}
+
+static PodManifest* pod_manifest_cache_load(
+    Storage* storage,
+    const char* cache_path,
+    uint32_t source_timestamp,
+    uint32_t source_size) {
+    File* file = storage_file_alloc(storage);
+    PodManifest* manifest = NULL;
+    uint8_t* blob = NULL;
+
+    do {
+        if(!storage_file_open(file, cache_path, FSAM_READ, FSOM_OPEN_EXISTING)) break;
+
+        const uint64_t size = storage_file_size(file);
+        if(size < sizeof(PodManifestCacheHeader) || size > UINT16_MAX) break;
+
+        // Whole cache in one read
+        blob = malloc(size);
+        if(storage_file_read(file, blob, size) != size) break;
+
+        const PodManifestCacheHeader* header = (const PodManifestCacheHeader*)blob;
+        if(header->magic != POD_MANIFEST_CACHE_MAGIC ||
+           header->version != POD_MANIFEST_CACHE_VERSION ||
+           header->source_timestamp != source_timestamp || header->source_size != source_size) {
+            FURI_LOG_D(TAG, "Cache %s is stale", cache_path);
+            break;
+        }
+
+        manifest = pod_manifest_cache_map(blob, size);
+        if(!manifest) {
+            FURI_LOG_W(TAG, "Cache %s is corrupted", cache_path);
+        }
+    } while(false);
+
+    if(!manifest) free(blob);
+
+    storage_file_free(file);
+    return manifest;
+}
+
+static uint32_t
+    pod_manifest_cache_add_string(char* strings, uint32_t* strings_size, const char* value) {
+    const uint32_t offset = *strings_size;
+    const size_t length = strlen(value) + 1;
+    memcpy(strings + offset, value, length);
+    *strings_size += length;
+    return offset;
+}
+
+static bool pod_manifest_cache_save(
+    Storage* storage,
+    const PodManifest* manifest,
+    const char* cache_path,
+    uint32_t source_timestamp,
+    uint32_t source_size) {
+    const size_t records_size = manifest->container_count * sizeof(PodManifestCacheRecord);
+    size_t strings_size = strlen(manifest->name) + strlen(manifest->namespace) + 2;
+    for(uint32_t i = 0; i < manifest->container_count; i++) {
+        strings_size += strlen(manifest->containers[i].name) + 1;
+        strings_size += strlen(manifest->containers[i].image) + 1;
+        // Only JSON manifests set args, always to a string
+        if(manifest->containers[i].args) strings_size += strlen(manifest->containers[i].args) + 1;
+        if(manifest->containers[i].health_check.type != HealthCheckTypeNone) {
+            strings_size += strlen(manifest->containers[i].health_check.command) + 1;
+        }
+        for(uint32_t j = 0; j < manifest->containers[i].volume_mount_count; j++) {
+            strings_size += strlen(manifest->containers[i].volume_mounts[j].name) + 1;
+            strings_size += strlen(manifest->containers[i].volume_mounts[j].mount_path) + 1;
+        }
+    }
+
+    // Built in memory and written at once, exactly as it will be read back
+    const size_t size = sizeof(PodManifestCacheHeader) + records_size + strings_size;
+    uint8_t* blob = malloc(size);
+    memset(blob, 0, size);
+
+    PodManifestCacheHeader* header = (PodManifestCacheHeader*)blob;
+    PodManifestCacheRecord* records =
+        (PodManifestCacheRecord*)(blob + sizeof(PodManifestCacheHeader));
+    char* strings = (char*)blob + sizeof(PodManifestCacheHeader) + records_size;
+
+    header->magic = POD_MANIFEST_CACHE_MAGIC;
+    header->version = POD_MANIFEST_CACHE_VERSION;
+    header->container_count = manifest->container_count;
+    header->source_timestamp = source_timestamp;
+    header->source_size = source_size;
+    header->name = pod_manifest_cache_add_string(strings, &header->strings_size, manifest->name);
+    header->namespace =
+        pod_manifest_cache_add_string(strings, &header->strings_size, manifest->namespace);
+
+    for(uint32_t i = 0; i < manifest->container_count; i++) {
+        const PodContainerSpec* spec = &manifest->containers[i];
+        PodManifestCacheRecord* record = &records[i];
+
+        record->name = pod_manifest_cache_add_string(strings, &header->strings_size, spec->name);
+        record->image = pod_manifest_cache_add_string(strings, &header->strings_size, spec->image);
+        record->args = spec->args ?
+                           pod_manifest_cache_add_string(strings, &header->strings_size, spec->args) :
+                           POD_MANIFEST_CACHE_NO_STRING;
+        record->max_memory = spec->resources.max_memory;
+        record->cpu_time_share = spec->resources.cpu_time_share;
+        record->max_threads = spec->resources.max_threads;
+        record->io_bytes_per_second = spec->resources.io_bytes_per_second;
+        record->restart_policy = spec->restart_policy;
+        record->system_privileges = spec->system_privileges;
+        record->warm_restart = spec->warm_restart;
+        record->priority_class = spec->priority_class;
+        record->health_check = POD_MANIFEST_CACHE_NO_STRING;
+        if(spec->health_check.type != HealthCheckTypeNone) {
+            record->health_check_type = spec->health_check.type;
+            record->health_check = pod_manifest_cache_add_string(
+                strings, &header->strings_size, spec->health_check.command);
+            record->initial_delay_ms = spec->health_check.initial_delay_ms;
+            record->period_ms = spec->health_check.period_ms;
+            record->timeout_ms = spec->health_check.timeout_ms;
+            record->success_threshold = spec->health_check.success_threshold;
+            record->failure_threshold = spec->health_check.failure_threshold;
+        }
+        record->volume_mounts = header->strings_size;
+        record->volume_mount_count = spec->volume_mount_count;
+        for(uint32_t j = 0; j < spec->volume_mount_count; j++) {
+            const VolumeMountSpec* volume = &spec->volume_mounts[j];
+            pod_manifest_cache_add_string(strings, &header->strings_size, volume->name);
+            pod_manifest_cache_add_string(strings, &header->strings_size, volume->mount_path);
+            if(volume->read_only) record->volume_read_only |= 1 << j;
+        }
+    }
+
+    File* file = storage_file_alloc(storage);
+    bool success = storage_file_open(file, cache_path, FSAM_WRITE, FSOM_CREATE_ALWAYS) &&
+                   storage_file_write(file, blob, size) == size;
+    storage_file_free(file);
+
+    // Partially written cache would only be rejected on every boot
+    if(!success) {
+        FURI_LOG_W(TAG, "Failed to write cache %s", cache_path);
+        storage_simply_remove(storage, cache_path);
+    }
+
+    free(blob);
+    return success;
+}
+
+PodManifest* pod_manifest_load_cached(const char* path, const char* cache_path) {
+    furi_check(path);
+    furi_check(cache_path);
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    PodManifest* manifest = NULL;
+
+    do {
+        uint32_t timestamp = 0;
+        FileInfo file_info;
+        if(storage_common_stat(storage, path, &file_info) != FSE_OK ||
+           storage_common_timestamp(storage, path, &timestamp) != FSE_OK) {
+            FURI_LOG_E(TAG, "Failed to stat %s", path);
+            break;
+        }
+
+        manifest = pod_manifest_cache_load(storage, cache_path, timestamp, file_info.size);
+        if(manifest) {
+            FURI_LOG_I(TAG, "Loaded %s from cache", path);
+            break;
+        }
+
+        manifest = pod_manifest_load_from_file(path);
+        if(!manifest) break;
+
+        if(!pod_manifest_validate(manifest)) {
+            pod_manifest_free(manifest);
+            manifest = NULL;
+            break;
+        }
+
+        pod_manifest_cache_save(storage, manifest, cache_path, timestamp, file_info.size);
+    } while(false);
+
+    furi_record_close(RECORD_STORAGE);
+    return manifest;
+}
+
 void pod_manifest_free(PodManifest* manifest) {
     if(!manifest) return;
+
+    // Strings of a cached manifest live in its blob
+    if(manifest->blob) {
+        // Volume mounts of all containers share the array of the first one
+        for(uint32_t i = 0; i < manifest->container_count; i++) {
+            if(manifest->containers[i].volume_mounts) {
+                free(manifest->containers[i].volume_mounts);
+                break;
+            }
+        }
+        free(manifest->blob);
+        free(manifest->containers);
+        free(manifest);
+        return;
+    }
     
     free(manifest->name);
     free(manifest->namespace);
@@ -239,15 +1346,9 @@ void pod_manifest_free(PodManifest* manifest) {
             
             free((void*)spec->name);
             free((void*)spec->image);
+            free(spec->args);
             
-            // Free volume mounts if any
-            if(spec->volume_mounts) {
-                for(uint32_t j = 0; j < spec->volume_mount_count; j++) {
-                    free((void*)spec->volume_mounts[j].name);
-                    free((void*)spec->volume_mounts[j].mount_path);
-                }
-                free(spec->volume_mounts);
-            }
+            pod_manifest_free_volume_mounts(spec->volume_mounts, spec->volume_mount_count);
             
             // Free health check data if any
             if(spec->health_check.type == HealthCheckTypeCommand) {
@@ -285,7 +1386,215 @@ uint32_t pod_manifest_get_containers(
     return manifest->container_count;
 }
 
-// Ultra lean container instantiation
+static void pod_manifest_container_config(
+    const PodManifest* manifest,
+    const PodContainerSpec* spec,
+    ContainerConfig* config) {
+    // Direct reference to spec strings to avoid allocation
+    *config = (ContainerConfig){
+        .name = spec->name,
+        .pod = manifest->name,
+        .volume_mounts = spec->volume_mounts,
+        .volume_mount_count = spec->volume_mount_count,
+        .image = spec->image,
+        .args = spec->args,
+        .restart_policy = spec->restart_policy,
+        .system_container = spec->system_privileges,
+        .warm_restart = spec->warm_restart,
+        .priority_class = spec->priority_class,
+        .health_check = spec->health_check,
+        .resource_limits = {
+            .max_memory = spec->resources.max_memory > 0 ? 
+                spec->resources.max_memory : 8192,  // 8K default - even more minimal
+            .cpu_time_share = spec->resources.cpu_time_share > 0 ? 
+                spec->resources.cpu_time_share : 10,  // 10% default - more conservative
+            .max_threads = spec->resources.max_threads > 0 ? 
+                spec->resources.max_threads : 1,   // 1 thread default - most minimal
+            .io_bytes_per_second = spec->resources.io_bytes_per_second,
+        },
+    };
+}
+
+/** Container image prepared by the apply worker */
+typedef struct {
+    FlipperApplication* fap; // Preloaded image, NULL for built-ins
+    bool ready; // Image exists and can be mapped
+} PodManifestPreparedImage;
+
+typedef struct {
+    PodManifest* const* manifests;
+    size_t count;
+    FuriMessageQueue* queue;
+    uint32_t prepare_ms; // Time spent by the worker
+} PodManifestApplyPipeline;
+
+// Opens each image once and reads its ELF headers and manifest while the
+// previous containers are being mapped and started
+static int32_t pod_manifest_apply_worker(void* context) {
+    PodManifestApplyPipeline* pipeline = context;
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+
+    for(size_t m = 0; m < pipeline->count; m++) {
+        const PodManifest* manifest = pipeline->manifests[m];
+        for(uint32_t i = 0; i < manifest->container_count; i++) {
+            const PodContainerSpec* spec = &manifest->containers[i];
+            PodManifestPreparedImage prepared = {.fap = NULL, .ready = true};
+            const uint32_t start = furi_get_tick();
+
+            // Built-ins always exist
+            if(strstr(spec->image, ".fap")) {
+                prepared.fap = flipper_application_alloc(storage, firmware_api_interface);
+                if(spec->warm_restart) {
+                    flipper_application_record_warm_image(prepared.fap);
+                }
+                FlipperApplicationPreloadStatus status =
+                    flipper_application_preload(prepared.fap, spec->image);
+                if(status != FlipperApplicationPreloadStatusSuccess) {
+                    FURI_LOG_E(
+                        TAG,
+                        "Container %s: %s: %s",
+                        spec->name,
+                        spec->image,
+                        flipper_application_preload_status_to_string(status));
+                    flipper_application_free(prepared.fap);
+                    prepared.fap = NULL;
+                    prepared.ready = false;
+                }
+            }
+
+            pipeline->prepare_ms += furi_get_tick() - start;
+            furi_message_queue_put(pipeline->queue, &prepared, FuriWaitForever);
+        }
+    }
+
+    furi_record_close(RECORD_STORAGE);
+    return 0;
+}
+
+// Instantiate prepared containers of one manifest, deletes its already created
+// containers if any of them fails
+static Container** pod_manifest_apply_one(
+    ContainerRuntime* runtime,
+    const PodManifest* manifest,
+    PodManifestApplyPipeline* pipeline,
+    PodManifestApplyStats* stats) {
+    if(manifest->container_count == 0) return NULL;
+
+    Container** containers = malloc(sizeof(Container*) * manifest->container_count);
+    memset(containers, 0, sizeof(Container*) * manifest->container_count);
+    bool success = true;
+
+    // Every prepared image is taken from the queue, even after a failure
+    for(uint32_t i = 0; i < manifest->container_count; i++) {
+        PodManifestPreparedImage prepared;
+        uint32_t start = furi_get_tick();
+        furi_check(
+            furi_message_queue_get(pipeline->queue, &prepared, FuriWaitForever) ==
+            FuriStatusOk);
+        stats->wait_ms += furi_get_tick() - start;
+
+        if(!success || !prepared.ready) {
+            if(prepared.fap) flipper_application_free(prepared.fap);
+            success = false;
+            continue;
+        }
+
+        ContainerConfig config;
+        pod_manifest_container_config(manifest, &manifest->containers[i], &config);
+
+        start = furi_get_tick();
+        containers[i] = container_create_preloaded(runtime, &config, prepared.fap);
+        stats->create_ms += furi_get_tick() - start;
+        if(!containers[i]) {
+            if(prepared.fap) flipper_application_free(prepared.fap);
+            success = false;
+            continue;
+        }
+
+        start = furi_get_tick();
+        success = container_start(containers[i]);
+        stats->start_ms += furi_get_tick() - start;
+        if(success) {
+            stats->containers++;
+        } else {
+            // Started by the runtime once preempted containers release their memory
+            ContainerStatus status;
+            container_get_status(containers[i], &status);
+            success = status.admission_pending;
+        }
+    }
+
+    if(!success) {
+        // Names stay taken until the records are deleted
+        for(uint32_t i = 0; i < manifest->container_count; i++) {
+            if(containers[i]) container_delete(containers[i]);
+        }
+        free(containers);
+        containers = NULL;
+    }
+
+    return containers;
+}
+
+// Applies manifests one after another while the worker prepares images ahead,
+// results receives per manifest container arrays or NULL for failed ones
+static size_t pod_manifest_apply(
+    ContainerRuntime* runtime,
+    PodManifest* const* manifests,
+    size_t count,
+    Container*** results,
+    PodManifestApplyStats* stats) {
+    PodManifestApplyStats local_stats;
+    if(!stats) stats = &local_stats;
+    memset(stats, 0, sizeof(PodManifestApplyStats));
+
+    const uint32_t start = furi_get_tick();
+    size_t applied = 0;
+
+    PodManifestApplyPipeline pipeline = {
+        .manifests = manifests,
+        .count = count,
+        .queue = furi_message_queue_alloc(
+            POD_MANIFEST_APPLY_LOOKAHEAD, sizeof(PodManifestPreparedImage)),
+    };
+    FuriThread* worker = furi_thread_alloc_ex(
+        "PodApplyWorker", POD_MANIFEST_APPLY_STACK_SIZE, pod_manifest_apply_worker, &pipeline);
+    furi_thread_start(worker);
+
+    for(size_t m = 0; m < count; m++) {
+        Container** containers = pod_manifest_apply_one(runtime, manifests[m], &pipeline, stats);
+        if(containers) applied++;
+
+        if(results) {
+            results[m] = containers;
+        } else {
+            free(containers);
+        }
+    }
+
+    furi_thread_join(worker);
+    furi_thread_free(worker);
+    furi_message_queue_free(pipeline.queue);
+
+    stats->prepare_ms = pipeline.prepare_ms;
+    stats->total_ms = furi_get_tick() - start;
+
+    FURI_LOG_I(
+        TAG,
+        "Applied %zu/%zu pods, %lu containers: "
+        "prepare %lums, wait %lums, create %lums, start %lums, total %lums",
+        applied,
+        count,
+        stats->containers,
+        stats->prepare_ms,
+        stats->wait_ms,
+        stats->create_ms,
+        stats->start_ms,
+        stats->total_ms);
+
+    return applied;
+}
+
 Container** pod_manifest_instantiate(
     ContainerRuntime* runtime,
     const PodManifest* manifest) {
@@ -296,43 +1605,245 @@ Container** pod_manifest_instantiate(
     if(manifest->container_count == 0) {
         return NULL;
     }
-    
-    // Verify all FAPs exist before proceeding
-    if(!pod_manifest_validate((PodManifest*)manifest)) {
-        return NULL;
+
+    // Image existence is checked by preloading, no separate validation pass
+    Container** containers = NULL;
+    PodManifest* manifests[] = {(PodManifest*)manifest};
+    pod_manifest_apply(runtime, manifests, 1, &containers, NULL);
+
+    return containers;
+}
+
+int pod_manifest_batch_apply_ex(
+    ContainerRuntime* runtime,
+    PodManifest** manifests,
+    size_t count,
+    PodManifestApplyStats* stats) {
+    furi_check(runtime);
+    furi_check(manifests);
+
+    for(size_t i = 0; i < count; i++) {
+        furi_check(manifests[i]);
     }
-    
-    // Minimal container array allocation
-    Container** containers = malloc(sizeof(Container*) * manifest->container_count);
-    if(!containers) return NULL;
-    
-    // Create containers with direct string references to avoid copies
-    for(uint8_t i = 0; i < manifest->container_count; i++) {
-        const PodContainerSpec* spec = &manifest->containers[i];
-        
-        // Direct reference to spec strings to avoid allocation
-        ContainerConfig config = {
-            .name = spec->name,
-            .image = spec->image,
-            .args = spec->args,
-            .restart_on_crash = spec->restart_on_crash,
-            .system_container = spec->system_privileges,
-            .resource_limits = {
-                .max_memory = spec->resources.max_memory > 0 ? 
-                    spec->resources.max_memory : 8192,  // 8K default - even more minimal
-                .cpu_time_share = spec->resources.cpu_time_share > 0 ? 
-                    spec->resources.cpu_time_share : 10,  // 10% default - more conservative
-                .max_threads = spec->resources.max_threads > 0 ? 
-                    spec->resources.max_threads : 1,   // 1 thread default - most minimal
-            },
-        };
-        
-        // Create and immediately start container
-        containers[i] = container_create(runtime, &config);
-        if(containers[i]) {
-            container_start(containers[i]);
+
+    return pod_manifest_apply(runtime, manifests, count, NULL, stats);
+}
+
+int pod_manifest_batch_apply(PodManifest** manifests, size_t count) {
+    ContainerRuntime* runtime = furi_get_container_runtime();
+    if(!runtime) {
+        FURI_LOG_E(TAG, "Container runtime not initialized");
+        return 0;
+    }
+
+    return pod_manifest_batch_apply_ex(runtime, manifests, count, NULL);
+}
+
+/** Frozen printer writing straight to a stream */
+typedef struct {
+    struct json_out out; // Must be first, passed to frozen
+    Stream* stream;
+    bool pretty;
+    uint8_t depth;
+    bool failed;
+} PodManifestJsonWriter;
+
+static int pod_manifest_json_printer(struct json_out* out, const char* str, size_t len) {
+    PodManifestJsonWriter* writer = (PodManifestJsonWriter*)out;
+    const size_t written = stream_write(writer->stream, (const uint8_t*)str, len);
+    if(written != len) writer->failed = true;
+    return written;
+}
+
+static void pod_manifest_json_indent(PodManifestJsonWriter* writer) {
+    if(!writer->pretty) return;
+    writer->out.printer(&writer->out, "\n", 1);
+    for(uint8_t i = 0; i < writer->depth; i++) {
+        writer->out.printer(&writer->out, "  ", 2);
+    }
+}
+
+static void pod_manifest_json_open(PodManifestJsonWriter* writer, const char* bracket) {
+    writer->out.printer(&writer->out, bracket, 1);
+    writer->depth++;
+}
+
+static void pod_manifest_json_close(PodManifestJsonWriter* writer, const char* bracket) {
+    writer->depth--;
+    pod_manifest_json_indent(writer);
+    writer->out.printer(&writer->out, bracket, 1);
+}
+
+// Starts an array element or, with a key, an object member
+static void
+    pod_manifest_json_member(PodManifestJsonWriter* writer, const char* key, bool first) {
+    if(!first) writer->out.printer(&writer->out, ",", 1);
+    pod_manifest_json_indent(writer);
+    if(key) {
+        json_printf(&writer->out, "%Q:", key);
+        if(writer->pretty) writer->out.printer(&writer->out, " ", 1);
+    }
+}
+
+static void pod_manifest_json_write_probe(
+    PodManifestJsonWriter* writer,
+    const HealthCheckSpec* health_check) {
+    struct json_out* out = &writer->out;
+
+    pod_manifest_json_member(writer, "livenessProbe", false);
+    pod_manifest_json_open(writer, "{");
+    if(health_check->type == HealthCheckTypeCommand) {
+        pod_manifest_json_member(writer, "exec", true);
+        pod_manifest_json_open(writer, "{");
+        pod_manifest_json_member(writer, "command", true);
+        pod_manifest_json_open(writer, "[");
+        // One element per word, as the parser joins them
+        const char* word = health_check->command;
+        for(bool first = true; *word; first = false) {
+            const char* end = strchr(word, ' ');
+            const int length = end ? end - word : (int)strlen(word);
+            pod_manifest_json_member(writer, NULL, first);
+            json_printf(out, "%.*Q", length, word);
+            word += length;
+            while(*word == ' ') word++;
         }
+        pod_manifest_json_close(writer, "]");
+        pod_manifest_json_close(writer, "}");
+    } else {
+        pod_manifest_json_member(writer, "httpGet", true);
+        pod_manifest_json_open(writer, "{");
+        pod_manifest_json_member(writer, "path", true);
+        json_printf(out, "%Q", health_check->endpoint);
+        pod_manifest_json_close(writer, "}");
     }
-    
-    return containers;
+
+    const struct {
+        const char* name;
+        uint32_t value;
+    } fields[] = {
+        {"initialDelaySeconds", health_check->initial_delay_ms / 1000},
+        {"periodSeconds", health_check->period_ms / 1000},
+        {"timeoutSeconds", health_check->timeout_ms / 1000},
+        {"successThreshold", health_check->success_threshold},
+        {"failureThreshold", health_check->failure_threshold},
+    };
+    for(size_t i = 0; i < COUNT_OF(fields); i++) {
+        if(!fields[i].value) continue;
+        pod_manifest_json_member(writer, fields[i].name, false);
+        json_printf(out, "%u", (unsigned)fields[i].value);
+    }
+    pod_manifest_json_close(writer, "}");
+}
+
+static void pod_manifest_json_write_container(
+    PodManifestJsonWriter* writer,
+    const PodContainerSpec* spec) {
+    struct json_out* out = &writer->out;
+
+    pod_manifest_json_open(writer, "{");
+    pod_manifest_json_member(writer, "name", true);
+    json_printf(out, "%Q", spec->name);
+    pod_manifest_json_member(writer, "image", false);
+    json_printf(out, "%Q", spec->image);
+    if(spec->args) {
+        pod_manifest_json_member(writer, "args", false);
+        json_printf(out, "%Q", (const char*)spec->args);
+    }
+
+    pod_manifest_json_member(writer, "resources", false);
+    pod_manifest_json_open(writer, "{");
+    pod_manifest_json_member(writer, "limits", true);
+    pod_manifest_json_open(writer, "{");
+    pod_manifest_json_member(writer, "memory", true);
+    json_printf(out, "%u", (unsigned)spec->resources.max_memory);
+    pod_manifest_json_member(writer, "cpu", false);
+    json_printf(out, "%u", (unsigned)spec->resources.cpu_time_share);
+    pod_manifest_json_member(writer, "threads", false);
+    json_printf(out, "%u", (unsigned)spec->resources.max_threads);
+    if(spec->resources.io_bytes_per_second) {
+        pod_manifest_json_member(writer, "io", false);
+        json_printf(out, "%u", (unsigned)spec->resources.io_bytes_per_second);
+    }
+    pod_manifest_json_close(writer, "}");
+    pod_manifest_json_close(writer, "}");
+
+    pod_manifest_json_member(writer, "securityContext", false);
+    pod_manifest_json_open(writer, "{");
+    pod_manifest_json_member(writer, "privileged", true);
+    json_printf(out, "%B", spec->system_privileges);
+    pod_manifest_json_close(writer, "}");
+
+    if(spec->health_check.type != HealthCheckTypeNone) {
+        pod_manifest_json_write_probe(writer, &spec->health_check);
+    }
+
+    if(spec->volume_mount_count) {
+        pod_manifest_json_member(writer, "volumeMounts", false);
+        pod_manifest_json_open(writer, "[");
+        for(uint32_t i = 0; i < spec->volume_mount_count; i++) {
+            const VolumeMountSpec* volume = &spec->volume_mounts[i];
+            pod_manifest_json_member(writer, NULL, i == 0);
+            pod_manifest_json_open(writer, "{");
+            pod_manifest_json_member(writer, "name", true);
+            json_printf(out, "%Q", volume->name);
+            pod_manifest_json_member(writer, "mountPath", false);
+            json_printf(out, "%Q", volume->mount_path);
+            if(volume->read_only) {
+                pod_manifest_json_member(writer, "readOnly", false);
+                json_printf(out, "%B", volume->read_only);
+            }
+            pod_manifest_json_close(writer, "}");
+        }
+        pod_manifest_json_close(writer, "]");
+    }
+
+    pod_manifest_json_member(writer, "restartPolicy", false);
+    json_printf(out, "%Q", pod_manifest_restart_policies[spec->restart_policy]);
+    pod_manifest_json_member(writer, "warmRestart", false);
+    json_printf(out, "%B", spec->warm_restart);
+    pod_manifest_json_member(writer, "priorityClassName", false);
+    json_printf(out, "%Q", pod_manifest_priority_classes[spec->priority_class]);
+    pod_manifest_json_close(writer, "}");
+}
+
+bool pod_manifest_to_json(const PodManifest* manifest, Stream* stream, bool pretty) {
+    furi_check(manifest);
+    furi_check(stream);
+
+    PodManifestJsonWriter writer = {
+        .out = {.printer = pod_manifest_json_printer},
+        .stream = stream,
+        .pretty = pretty,
+    };
+    struct json_out* out = &writer.out;
+
+    pod_manifest_json_open(&writer, "{");
+    pod_manifest_json_member(&writer, "apiVersion", true);
+    json_printf(out, "%Q", "v1");
+    pod_manifest_json_member(&writer, "kind", false);
+    json_printf(out, "%Q", "Pod");
+
+    pod_manifest_json_member(&writer, "metadata", false);
+    pod_manifest_json_open(&writer, "{");
+    pod_manifest_json_member(&writer, "name", true);
+    json_printf(out, "%Q", manifest->name);
+    pod_manifest_json_member(&writer, "namespace", false);
+    json_printf(out, "%Q", manifest->namespace);
+    pod_manifest_json_close(&writer, "}");
+
+    // Containers are written one at a time, the document never exists in memory
+    pod_manifest_json_member(&writer, "spec", false);
+    pod_manifest_json_open(&writer, "{");
+    pod_manifest_json_member(&writer, "containers", true);
+    pod_manifest_json_open(&writer, "[");
+    for(uint32_t i = 0; i < manifest->container_count && !writer.failed; i++) {
+        pod_manifest_json_member(&writer, NULL, i == 0);
+        pod_manifest_json_write_container(&writer, &manifest->containers[i]);
+    }
+    pod_manifest_json_close(&writer, "]");
+    pod_manifest_json_close(&writer, "}");
+    pod_manifest_json_close(&writer, "}");
+    if(pretty) out->printer(out, "\n", 1);
+
+    return !writer.failed;
 }
@@ -17,34 +17,6 @@ extern "C" {
 typedef struct PodManifest PodManifest;
 typedef struct PodSpec PodSpec;
 
-/** Pod health check type */
-typedef enum {
-    HealthCheckTypeNone,
-    HealthCheckTypeCommand,
-    HealthCheckTypeHttp,
-} HealthCheckType;
-
-/** Pod health check */
-typedef struct {
-    HealthCheckType type;
-    union {
-        const char* command;
-        const char* endpoint;
-    };
-    uint32_t initial_delay_ms;
-    uint32_t period_ms;
-    uint32_t timeout_ms;
-    uint32_t success_threshold;
-    uint32_t failure_threshold;
-} HealthCheckSpec;
-
-/** Volume mount */
-typedef struct {
-    const char* name;
-    const char* mount_path;
-    bool read_only;
-} VolumeMountSpec;
-
 /** Container spec within a pod */
 typedef struct {
     const char* name;
@@ -53,22 +25,48 @@ typedef struct {
     HealthCheckSpec health_check;
     VolumeMountSpec* volume_mounts;
     uint32_t volume_mount_count;
-    bool restart_on_crash;
+    ContainerRestartPolicy restart_policy; // Always unless set
     bool system_privileges;
-    void* args;
+    bool warm_restart; // Keep parsed image between runs for faster restarts
+    ContainerPriorityClass priority_class; // Normal unless set with PriorityClass<N>
+    void* args; // String from JSON manifests, owned by the manifest
 } PodContainerSpec;
 
+/** Per-stage timings of applying pod manifests */
+typedef struct {
+    uint32_t prepare_ms; // Opening images, reading ELF headers and manifests, done ahead
+    uint32_t wait_ms;    // Instantiation stalled waiting for prepared images
+    uint32_t create_ms;  // Creating containers
+    uint32_t start_ms;   // Mapping images and starting containers
+    uint32_t total_ms;
+    uint32_t containers; // Containers started
+} PodManifestApplyStats;
+
 /**
  * @brief Load a pod manifest from file
  * 
  * Loads and parses a pod manifest file with containers definition.
- * Similar to 'kubectl apply -f' in Kubernetes.
+ * Similar to 'kubectl apply -f' in Kubernetes. Files starting with '{' are
+ * read as JSON, anything else as FlipperFormat.
  * 
  * @param path Path to manifest file
  * @return PodManifest* or NULL if loading failed
  */
 PodManifest* pod_manifest_load_from_file(const char* path);
 
+/**
+ * @brief Load a pod manifest through its compiled cache
+ * 
+ * Uses the binary cache when it was compiled from the current revision of the
+ * manifest, with a single read and no validation. Otherwise the manifest is
+ * parsed and validated, then compiled to the cache for the next load.
+ * 
+ * @param path Path to manifest file
+ * @param cache_path Path to compiled manifest cache
+ * @return PodManifest* or NULL if loading or validation failed
+ */
+PodManifest* pod_manifest_load_cached(const char* path, const char* cache_path);
+
 /**
  * @brief Validate that a pod manifest can be deployed
  * 
@@ -116,11 +114,13 @@ bool pod_manifest_apply_taints(PodManifest* manifest, const PodTaint* taints, si
 /**
  * @brief Memory-optimized pod manifest loading
  * 
- * Uses streaming JSON parser to minimize memory usage while loading manifests.
+ * Streams a Kubernetes style JSON Pod manifest straight into container specs.
+ * Only one container object at a time is held in the buffer, unknown members
+ * are skipped without being buffered.
  * 
- * @param path Path to manifest file
+ * @param path Path to JSON manifest file
  * @param buffer Working buffer for parsing
- * @param buffer_size Size of working buffer
+ * @param buffer_size Size of working buffer, bounds the size of a container object
  * @return PodManifest* Newly created pod manifest or NULL on failure 
  */
 PodManifest* pod_manifest_load_from_file_buffered(
@@ -137,8 +137,30 @@ PodManifest* pod_manifest_load_from_file_buffered(
  */
 int pod_manifest_batch_apply(PodManifest** manifests, size_t count);
 
+/**
+ * @brief Batch apply multiple pod manifests with timings
+ * 
+ * Images are opened and preloaded by a worker thread ahead of instantiation,
+ * so each image is read from storage once. Containers of a manifest that
+ * failed to apply are stopped.
+ * 
+ * @param runtime Container runtime
+ * @param manifests Array of pod manifests
+ * @param count Number of manifests in array
+ * @param stats Per-stage timings, can be NULL
+ * @return int Number of successfully applied manifests
+ */
+int pod_manifest_batch_apply_ex(
+    ContainerRuntime* runtime,
+    PodManifest** manifests,
+    size_t count,
+    PodManifestApplyStats* stats);
+
 /**
  * @brief Create a memory-efficient pod manifest from JSON
+ * 
+ * Parses the string in place, see pod_manifest_load_from_file_buffered.
+ * 
  * @param json_data JSON string containing manifest data
  * @return PodManifest* Newly created pod manifest or NULL on failure
  */
@@ -186,7 +208,7 @@ uint32_t pod_manifest_get_containers(
  * 
  * @param runtime The container runtime
  * @param manifest The manifest with container definitions
- * @return Container** Array of created containers
+ * @return Container** Array of created containers, NULL if any failed to start
  */
 Container** pod_manifest_instantiate(
     ContainerRuntime* runtime,
@@ -220,13 +242,15 @@ bool pod_manifest_apply_resource_quota(PodManifest* manifest, const ResourceQuot
  * @brief Convert a pod manifest to JSON
  * 
  * Serializes a pod manifest to JSON format,
- * similar to 'kubectl get pod -o json'.
+ * similar to 'kubectl get pod -o json'. Output is written as it is
+ * generated, pod_manifest_create_from_json reads it back.
  * 
  * @param manifest The pod manifest to convert
+ * @param stream Stream to write to
  * @param pretty Whether to format the JSON for readability
- * @return char* JSON string (must be freed by caller)
+ * @return bool true if everything was written
  */
-char* pod_manifest_to_json(const PodManifest* manifest, bool pretty);
+bool pod_manifest_to_json(const PodManifest* manifest, Stream* stream, bool pretty);
 
 #ifdef __cplusplus
 }
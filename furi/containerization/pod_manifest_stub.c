@@ -1,31 +0,0 @@
-#include "include/pod_manifest.h"
-#include <stdlib.h>
-#include <string.h>
-
-// Minimal stub implementation
-PodManifest* pod_manifest_load_from_file(const char* path) {
-    return NULL; // Stub implementation
-}
-
-bool pod_manifest_validate(PodManifest* manifest) {
-    return false; // Stub implementation
-}
-
-void pod_manifest_free(PodManifest* manifest) {
-    // Stub implementation
-}
-
-const char* pod_manifest_get_name(const PodManifest* manifest) {
-    return "stub_manifest"; // Stub implementation
-}
-
-const char* pod_manifest_get_namespace(const PodManifest* manifest) {
-    return "default"; // Stub implementation
-}
-
-uint32_t pod_manifest_get_containers(
-    const PodManifest* manifest,
-    const PodContainerSpec** containers) {
-    *containers = NULL;
-    return 0; // Stub implementation
-}
@@ -1,32 +1,533 @@
-#include "include/service_registry.h"
+#include "service_registry.h"
+#include <furi.h>
+#include <furi/core/mutex.h>
+#include <furi/core/record.h>
+#include <furi/core/log.h>
 #include <stdlib.h>
+#include <string.h>
 
-typedef struct ServiceRegistry {
-    void* placeholder;
-} ServiceRegistry;
+#define TAG "ServiceRegistry"
+
+// Maximum number of registered services
+#define SERVICE_REGISTRY_CAPACITY 16
+
+// Hash table size, power of two and twice the capacity to keep probe chains short
+#define SERVICE_REGISTRY_TABLE_SIZE 32
+#define SERVICE_REGISTRY_TABLE_MASK (SERVICE_REGISTRY_TABLE_SIZE - 1)
+#define SERVICE_REGISTRY_TABLE_EMPTY 0xFF
+
+// Each service owns at most 3 copied strings: name, namespace and protocol
+#define SERVICE_REGISTRY_STRING_CAPACITY (SERVICE_REGISTRY_CAPACITY * 3)
+
+#define SERVICE_REGISTRY_DEFAULT_NAMESPACE "default"
+
+// Buffer references in flight per direction of a channel
+#define SERVICE_CHANNEL_DEPTH 8
+#define SERVICE_CHANNEL_SIZE  (SERVICE_CHANNEL_DEPTH * sizeof(ServiceBuffer*))
+
+static_assert(SERVICE_REGISTRY_CAPACITY < SERVICE_REGISTRY_TABLE_EMPTY);
+static_assert((SERVICE_REGISTRY_TABLE_SIZE & SERVICE_REGISTRY_TABLE_MASK) == 0);
+
+typedef struct ServiceBufferPool ServiceBufferPool;
+
+struct ServiceBuffer {
+    ServiceBufferPool* pool;
+    size_t size;
+    uint8_t data[];
+};
+
+// Outlives its endpoint until every buffer in flight is released
+struct ServiceBufferPool {
+    FuriMessageQueue* free; // ServiceBuffer* ready to be acquired
+    uint8_t* memory;
+    size_t buffer_size;
+    uint32_t references; // Endpoint and acquired buffers
+};
+
+// Slot stays taken until the last lookup reference is released
+struct ServiceEndpoint {
+    ServiceDescriptor descriptor; // Strings are either interned or caller owned persistent
+    ServiceRegistry* registry;
+    ServiceBufferPool* pool; // External services with buffer_count only
+    uint32_t hash; // Hash of (namespace, name)
+    uint16_t references; // Registration and lookups
+    bool registered; // In the table, cleared by unregister
+};
+
+// Copied string shared by every service that registered the same value
+typedef struct {
+    char* value;
+    uint16_t references;
+} ServiceRegistryString;
+
+struct ServiceRegistry {
+    FuriMutex* mutex;
+    ServiceEndpoint endpoints[SERVICE_REGISTRY_CAPACITY];
+    uint8_t table[SERVICE_REGISTRY_TABLE_SIZE]; // Endpoint indexes, open addressed
+    ServiceRegistryString strings[SERVICE_REGISTRY_STRING_CAPACITY];
+    size_t count;
+};
+
+// FNV-1a over "namespace\0name"
+static uint32_t service_registry_hash(const char* namespace, const char* name) {
+    uint32_t hash = 2166136261UL;
+
+    for(const char* c = namespace; *c; c++) {
+        hash = (hash ^ (uint8_t)*c) * 16777619UL;
+    }
+    hash = (hash ^ 0) * 16777619UL;
+    for(const char* c = name; *c; c++) {
+        hash = (hash ^ (uint8_t)*c) * 16777619UL;
+    }
+
+    return hash;
+}
+
+static const char* service_registry_intern(ServiceRegistry* registry, const char* value) {
+    ServiceRegistryString* free_string = NULL;
+
+    for(size_t i = 0; i < SERVICE_REGISTRY_STRING_CAPACITY; i++) {
+        ServiceRegistryString* string = &registry->strings[i];
+        if(string->references == 0) {
+            if(!free_string) free_string = string;
+        } else if(strcmp(string->value, value) == 0) {
+            string->references++;
+            return string->value;
+        }
+    }
+
+    // Capacity covers every string of a full registry
+    furi_check(free_string);
+    free_string->value = strdup(value);
+    free_string->references = 1;
+
+    return free_string->value;
+}
+
+static void service_registry_release(ServiceRegistry* registry, const char* value) {
+    for(size_t i = 0; i < SERVICE_REGISTRY_STRING_CAPACITY; i++) {
+        ServiceRegistryString* string = &registry->strings[i];
+        if(string->references && string->value == value) {
+            if(--string->references == 0) {
+                free(string->value);
+                string->value = NULL;
+            }
+            return;
+        }
+    }
+}
+
+static const char* service_registry_store_string(
+    ServiceRegistry* registry,
+    const char* value,
+    bool persistent) {
+    if(!value) return NULL;
+    return persistent ? value : service_registry_intern(registry, value);
+}
+
+static void service_registry_drop_string(
+    ServiceRegistry* registry,
+    const char* value,
+    bool persistent) {
+    if(value && !persistent) {
+        service_registry_release(registry, value);
+    }
+}
+
+// Find table bucket holding the service, or the empty bucket terminating its probe chain
+static size_t service_registry_find_bucket(
+    const ServiceRegistry* registry,
+    uint32_t hash,
+    const char* namespace,
+    const char* name) {
+    size_t bucket = hash & SERVICE_REGISTRY_TABLE_MASK;
+
+    // Load factor is at most 1/2, so an empty bucket is always reached
+    while(registry->table[bucket] != SERVICE_REGISTRY_TABLE_EMPTY) {
+        const ServiceEndpoint* endpoint = &registry->endpoints[registry->table[bucket]];
+        if(endpoint->hash == hash && strcmp(endpoint->descriptor.name, name) == 0 &&
+           strcmp(endpoint->descriptor.namespace, namespace) == 0) {
+            break;
+        }
+        bucket = (bucket + 1) & SERVICE_REGISTRY_TABLE_MASK;
+    }
+
+    return bucket;
+}
+
+// Backward shift deletion: keeps probe chains intact without tombstones
+static void service_registry_remove_bucket(ServiceRegistry* registry, size_t bucket) {
+    size_t hole = bucket;
+    size_t next = bucket;
+
+    registry->table[hole] = SERVICE_REGISTRY_TABLE_EMPTY;
+
+    while(true) {
+        next = (next + 1) & SERVICE_REGISTRY_TABLE_MASK;
+        if(registry->table[next] == SERVICE_REGISTRY_TABLE_EMPTY) break;
+
+        size_t home = registry->endpoints[registry->table[next]].hash &
+                      SERVICE_REGISTRY_TABLE_MASK;
+        // Entry can only move back if its home bucket is not within (hole, next]
+        size_t distance_to_home = (next - home) & SERVICE_REGISTRY_TABLE_MASK;
+        size_t distance_to_hole = (next - hole) & SERVICE_REGISTRY_TABLE_MASK;
+        if(distance_to_home >= distance_to_hole) {
+            registry->table[hole] = registry->table[next];
+            registry->table[next] = SERVICE_REGISTRY_TABLE_EMPTY;
+            hole = next;
+        }
+    }
+}
+
+static ServiceBufferPool* service_buffer_pool_alloc(size_t buffer_size, size_t buffer_count) {
+    ServiceBufferPool* pool = malloc(sizeof(ServiceBufferPool));
+    // Keep payloads 8 byte aligned for sample batches
+    const size_t stride = (sizeof(ServiceBuffer) + buffer_size + 7) & ~(size_t)7;
+
+    pool->free = furi_message_queue_alloc(buffer_count, sizeof(ServiceBuffer*));
+    pool->memory = malloc(stride * buffer_count);
+    pool->buffer_size = buffer_size;
+    pool->references = 1;
+
+    for(size_t i = 0; i < buffer_count; i++) {
+        ServiceBuffer* buffer = (ServiceBuffer*)(pool->memory + stride * i);
+        buffer->pool = pool;
+        buffer->size = 0;
+        furi_check(furi_message_queue_put(pool->free, &buffer, 0) == FuriStatusOk);
+    }
+
+    return pool;
+}
+
+static void service_buffer_pool_unref(ServiceBufferPool* pool) {
+    FURI_CRITICAL_ENTER();
+    const bool last = --pool->references == 0;
+    FURI_CRITICAL_EXIT();
+
+    if(last) {
+        furi_message_queue_free(pool->free);
+        free(pool->memory);
+        free(pool);
+    }
+}
+
+// Must be called with the lock held
+static void service_endpoint_unref(ServiceRegistry* registry, ServiceEndpoint* endpoint) {
+    if(--endpoint->references) return;
+
+    const ServiceDescriptor* descriptor = &endpoint->descriptor;
+    service_registry_drop_string(registry, descriptor->name, descriptor->name_persistent);
+    service_registry_drop_string(
+        registry, descriptor->namespace, descriptor->namespace_persistent);
+    service_registry_drop_string(registry, descriptor->protocol, descriptor->protocol_persistent);
+
+    // Buffers still in flight keep the pool alive
+    if(endpoint->pool) service_buffer_pool_unref(endpoint->pool);
+
+    memset(endpoint, 0, sizeof(ServiceEndpoint));
+    registry->count--;
+}
 
 ServiceRegistry* service_registry_alloc(void) {
-    return calloc(1, sizeof(ServiceRegistry));
+    ServiceRegistry* registry = malloc(sizeof(ServiceRegistry));
+
+    registry->mutex = furi_mutex_alloc(FuriMutexTypeNormal);
+    memset(registry->table, SERVICE_REGISTRY_TABLE_EMPTY, sizeof(registry->table));
+
+    return registry;
 }
 
 void service_registry_free(ServiceRegistry* registry) {
+    furi_check(registry);
+
+    for(size_t i = 0; i < SERVICE_REGISTRY_STRING_CAPACITY; i++) {
+        if(registry->strings[i].references) {
+            free(registry->strings[i].value);
+        }
+    }
+
+    for(size_t i = 0; i < SERVICE_REGISTRY_CAPACITY; i++) {
+        if(registry->endpoints[i].pool) {
+            service_buffer_pool_unref(registry->endpoints[i].pool);
+        }
+    }
+
+    furi_mutex_free(registry->mutex);
     free(registry);
 }
 
-bool service_registry_register(ServiceRegistry* registry, const char* service_name, void* service_impl) {
-    (void)registry;
-    (void)service_name;
-    (void)service_impl;
-    return false;
+ServiceEndpoint* service_registry_register(
+    ServiceRegistry* registry,
+    const ServiceDescriptor* descriptor) {
+    furi_check(registry);
+    furi_check(descriptor);
+    furi_check(descriptor->name);
+
+    const char* namespace =
+        descriptor->namespace ? descriptor->namespace : SERVICE_REGISTRY_DEFAULT_NAMESPACE;
+    const uint32_t hash = service_registry_hash(namespace, descriptor->name);
+    ServiceEndpoint* endpoint = NULL;
+
+    furi_check(furi_mutex_acquire(registry->mutex, FuriWaitForever) == FuriStatusOk);
+
+    do {
+        if(registry->count >= SERVICE_REGISTRY_CAPACITY) {
+            FURI_LOG_E(TAG, "Registry full, can't add %s/%s", namespace, descriptor->name);
+            break;
+        }
+
+        size_t bucket = service_registry_find_bucket(registry, hash, namespace, descriptor->name);
+        if(registry->table[bucket] != SERVICE_REGISTRY_TABLE_EMPTY) {
+            FURI_LOG_E(TAG, "%s/%s already registered", namespace, descriptor->name);
+            break;
+        }
+
+        size_t index = 0;
+        while(registry->endpoints[index].references) {
+            index++;
+        }
+
+        endpoint = &registry->endpoints[index];
+        endpoint->descriptor = *descriptor;
+        endpoint->descriptor.name = service_registry_store_string(
+            registry, descriptor->name, descriptor->name_persistent);
+        endpoint->descriptor.namespace = service_registry_store_string(
+            registry,
+            namespace,
+            descriptor->namespace_persistent || !descriptor->namespace);
+        endpoint->descriptor.namespace_persistent =
+            descriptor->namespace_persistent || !descriptor->namespace;
+        endpoint->descriptor.protocol = service_registry_store_string(
+            registry, descriptor->protocol, descriptor->protocol_persistent);
+        if(descriptor->type == ServiceTypeExternal && descriptor->buffer_count) {
+            furi_check(descriptor->buffer_size);
+            endpoint->pool =
+                service_buffer_pool_alloc(descriptor->buffer_size, descriptor->buffer_count);
+        }
+        endpoint->registry = registry;
+        endpoint->hash = hash;
+        endpoint->references = 1;
+        endpoint->registered = true;
+
+        registry->table[bucket] = index;
+        registry->count++;
+    } while(false);
+
+    furi_mutex_release(registry->mutex);
+
+    return endpoint;
+}
+
+void service_registry_unregister(ServiceRegistry* registry, ServiceEndpoint* endpoint) {
+    furi_check(registry);
+    furi_check(endpoint);
+    furi_check(endpoint->registry == registry);
+
+    furi_check(furi_mutex_acquire(registry->mutex, FuriWaitForever) == FuriStatusOk);
+
+    furi_check(endpoint->registered);
+    const ServiceDescriptor* descriptor = &endpoint->descriptor;
+    size_t bucket = service_registry_find_bucket(
+        registry, endpoint->hash, descriptor->namespace, descriptor->name);
+    furi_check(registry->table[bucket] == (uint8_t)(endpoint - registry->endpoints));
+    service_registry_remove_bucket(registry, bucket);
+
+    // Lookups still holding the endpoint keep its slot and strings
+    endpoint->registered = false;
+    service_endpoint_unref(registry, endpoint);
+
+    furi_mutex_release(registry->mutex);
+}
+
+ServiceEndpoint* service_registry_lookup(
+    ServiceRegistry* registry,
+    const char* name,
+    const char* namespace) {
+    furi_check(registry);
+    furi_check(name);
+
+    if(!namespace) namespace = SERVICE_REGISTRY_DEFAULT_NAMESPACE;
+    const uint32_t hash = service_registry_hash(namespace, name);
+    ServiceEndpoint* endpoint = NULL;
+
+    furi_check(furi_mutex_acquire(registry->mutex, FuriWaitForever) == FuriStatusOk);
+
+    size_t bucket = service_registry_find_bucket(registry, hash, namespace, name);
+    if(registry->table[bucket] != SERVICE_REGISTRY_TABLE_EMPTY) {
+        endpoint = &registry->endpoints[registry->table[bucket]];
+        furi_check(endpoint->references < UINT16_MAX);
+        endpoint->references++;
+    }
+
+    furi_mutex_release(registry->mutex);
+
+    return endpoint;
+}
+
+void service_endpoint_release(ServiceEndpoint* endpoint) {
+    furi_check(endpoint);
+
+    ServiceRegistry* registry = endpoint->registry;
+    furi_check(furi_mutex_acquire(registry->mutex, FuriWaitForever) == FuriStatusOk);
+    furi_check(endpoint->references > (endpoint->registered ? 1 : 0));
+    service_endpoint_unref(registry, endpoint);
+    furi_mutex_release(registry->mutex);
+}
+
+const ServiceDescriptor* service_endpoint_get_descriptor(const ServiceEndpoint* endpoint) {
+    furi_check(endpoint);
+    return &endpoint->descriptor;
+}
+
+static PipeSide* service_endpoint_open_channel(ServiceEndpoint* endpoint) {
+    const ServiceDescriptor* descriptor = &endpoint->descriptor;
+
+    if(!descriptor->accept_callback) {
+        FURI_LOG_W(TAG, "%s doesn't accept connections", descriptor->name);
+        return NULL;
+    }
+
+    // Capacity is a multiple of the reference size, so references are never split
+    PipeSideBundle bundle =
+        pipe_alloc(SERVICE_CHANNEL_SIZE, sizeof(ServiceBuffer*));
+    descriptor->accept_callback(bundle.bobs_side, descriptor->accept_context);
+
+    return bundle.alices_side;
 }
 
-void* service_registry_get_service(ServiceRegistry* registry, const char* service_name) {
-    (void)registry;
-    (void)service_name;
+void* service_endpoint_connect(ServiceEndpoint* endpoint) {
+    furi_check(endpoint);
+
+    if(!endpoint->registered) return NULL;
+
+    switch(endpoint->descriptor.type) {
+    case ServiceTypeInternal:
+    case ServiceTypeSystem:
+        // Backed by a furi record of the same name
+        return furi_record_open(endpoint->descriptor.name);
+    case ServiceTypeExternal:
+        return service_endpoint_open_channel(endpoint);
+    }
+
     return NULL;
 }
 
-void service_registry_unregister(ServiceRegistry* registry, const char* service_name) {
-    (void)registry;
-    (void)service_name;
+void service_endpoint_disconnect(ServiceEndpoint* endpoint, void* handle) {
+    furi_check(endpoint);
+
+    if(!handle) return;
+
+    switch(endpoint->descriptor.type) {
+    case ServiceTypeInternal:
+    case ServiceTypeSystem:
+        furi_record_close(endpoint->descriptor.name);
+        break;
+    case ServiceTypeExternal:
+        service_channel_free(handle);
+        break;
+    }
+}
+
+bool service_endpoint_probe(ServiceEndpoint* endpoint, const char* args) {
+    furi_check(endpoint);
+    furi_check(args);
+
+    if(!endpoint->registered) return false;
+
+    const ServiceProbeCallback callback = endpoint->descriptor.probe_callback;
+    return callback && callback(args, endpoint->descriptor.probe_context);
+}
+
+ServiceBuffer* service_buffer_acquire(ServiceEndpoint* endpoint, FuriWait timeout) {
+    furi_check(endpoint);
+    furi_check(endpoint->pool);
+
+    ServiceBufferPool* pool = endpoint->pool;
+    ServiceBuffer* buffer = NULL;
+
+    if(furi_message_queue_get(pool->free, &buffer, timeout) != FuriStatusOk) {
+        return NULL;
+    }
+
+    FURI_CRITICAL_ENTER();
+    pool->references++;
+    FURI_CRITICAL_EXIT();
+
+    buffer->size = 0;
+    return buffer;
+}
+
+void service_buffer_release(ServiceBuffer* buffer) {
+    furi_check(buffer);
+
+    ServiceBufferPool* pool = buffer->pool;
+    // Queue holds every buffer of the pool, so there is always room
+    furi_check(furi_message_queue_put(pool->free, &buffer, 0) == FuriStatusOk);
+    service_buffer_pool_unref(pool);
+}
+
+uint8_t* service_buffer_get_data(ServiceBuffer* buffer) {
+    furi_check(buffer);
+    return buffer->data;
+}
+
+size_t service_buffer_get_capacity(const ServiceBuffer* buffer) {
+    furi_check(buffer);
+    return buffer->pool->buffer_size;
+}
+
+void service_buffer_set_size(ServiceBuffer* buffer, size_t size) {
+    furi_check(buffer);
+    furi_check(size <= buffer->pool->buffer_size);
+    buffer->size = size;
+}
+
+size_t service_buffer_get_size(const ServiceBuffer* buffer) {
+    furi_check(buffer);
+    return buffer->size;
+}
+
+bool service_channel_send(PipeSide* channel, ServiceBuffer* buffer, FuriWait timeout) {
+    furi_check(channel);
+    furi_check(buffer);
+
+    // Nobody would release a buffer sent to a freed side
+    if(pipe_state(channel) == PipeStateBroken) return false;
+
+    // Sends are all or nothing, a failed one leaves the buffer with the caller
+    if(pipe_send(channel, &buffer, sizeof(ServiceBuffer*), timeout) != sizeof(ServiceBuffer*)) {
+        return false;
+    }
+
+    // The peer may have drained and freed its side while we were sending. With a
+    // single sender per side, anything left in the pipe then includes our buffer.
+    if(pipe_state(channel) == PipeStateBroken &&
+       pipe_spaces_available(channel) < SERVICE_CHANNEL_SIZE) {
+        service_buffer_release(buffer);
+    }
+
+    return true;
+}
+
+ServiceBuffer* service_channel_receive(PipeSide* channel, FuriWait timeout) {
+    furi_check(channel);
+
+    ServiceBuffer* buffer = NULL;
+    if(pipe_receive(channel, &buffer, sizeof(ServiceBuffer*), timeout) !=
+       sizeof(ServiceBuffer*)) {
+        return NULL;
+    }
+
+    return buffer;
+}
+
+void service_channel_free(PipeSide* channel) {
+    furi_check(channel);
+
+    ServiceBuffer* buffer;
+    while((buffer = service_channel_receive(channel, 0))) {
+        service_buffer_release(buffer);
+    }
+
+    pipe_free(channel);
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <furi.h>
+#include <toolbox/pipe.h>
 #include <stdbool.h>
 #include <stdint.h>
 
@@ -16,6 +17,7 @@ extern "C" {
 
 typedef struct ServiceRegistry ServiceRegistry;
 typedef struct ServiceEndpoint ServiceEndpoint;
+typedef struct ServiceBuffer ServiceBuffer;
 
 /** Service type */
 typedef enum {
@@ -24,6 +26,31 @@ typedef enum {
     ServiceTypeSystem,   // System-level service
 } ServiceType;
 
+/**
+ * @brief New connection callback of an external service
+ * 
+ * Called from the connecting thread. The provider owns the channel and frees
+ * it with service_channel_free, event loop subscriptions have to be made from
+ * the provider thread, e.g. through furi_event_loop_pend_callback.
+ * 
+ * @param channel provider side of the channel
+ * @param context accept_context of the descriptor
+ */
+typedef void (*ServiceAcceptCallback)(PipeSide* channel, void* context);
+
+/**
+ * @brief Health check callback of a service
+ * 
+ * Called from the probe executor thread, which supervises every container
+ * on a 2 KB stack. Must not block: the probe timeout is only checked once the
+ * callback returns, and until then no container is health checked.
+ * 
+ * @param args health check command after the service name, empty if none
+ * @param context probe_context of the descriptor
+ * @return true if the service is healthy
+ */
+typedef bool (*ServiceProbeCallback)(const char* args, void* context);
+
 /** Service descriptor */
 typedef struct {
     const char* name;        // Service name
@@ -31,7 +58,17 @@ typedef struct {
     ServiceType type;        // Service type
     uint32_t port;           // Service port (for protocols that need it)
     const char* protocol;    // Service protocol (e.g., "rpc", "serial")
-    
+
+    // External services only
+    ServiceAcceptCallback accept_callback; // Takes the provider side of new channels
+    void* accept_context;
+    size_t buffer_size;      // Payload capacity of each pooled buffer
+    size_t buffer_count;     // Buffers shared by every channel of the service
+
+    // Health check of the providing container, optional
+    ServiceProbeCallback probe_callback;
+    void* probe_context;
+
     // Optimization flags - set these to true if strings are guaranteed to persist
     bool name_persistent;
     bool namespace_persistent;
@@ -43,7 +80,7 @@ typedef struct {
  * 
  * @return ServiceRegistry* 
  */
-ServiceRegistry* service_registry_alloc();
+ServiceRegistry* service_registry_alloc(void);
 
 /**
  * @brief Free a service registry
@@ -57,7 +94,7 @@ void service_registry_free(ServiceRegistry* registry);
  * 
  * @param registry 
  * @param descriptor 
- * @return ServiceEndpoint* 
+ * @return ServiceEndpoint* owned by the registry until unregistered, or NULL
  */
 ServiceEndpoint* service_registry_register(
     ServiceRegistry* registry, 
@@ -66,14 +103,21 @@ ServiceEndpoint* service_registry_register(
 /**
  * @brief Unregister a service
  * 
+ * The service can't be found anymore and new connections and probes fail.
+ * Lookups still holding the endpoint keep it valid until they release it,
+ * callbacks they started before may still be running when this returns.
+ * 
  * @param registry 
- * @param endpoint 
+ * @param endpoint returned by service_registry_register
  */
 void service_registry_unregister(ServiceRegistry* registry, ServiceEndpoint* endpoint);
 
 /**
  * @brief Look up a service by name and namespace
  * 
+ * The endpoint stays valid, even if the service is unregistered meanwhile,
+ * until it is released with service_endpoint_release.
+ * 
  * @param registry 
  * @param name 
  * @param namespace 
@@ -84,6 +128,13 @@ ServiceEndpoint* service_registry_lookup(
     const char* name, 
     const char* namespace);
 
+/**
+ * @brief Release an endpoint returned by service_registry_lookup
+ * 
+ * @param endpoint 
+ */
+void service_endpoint_release(ServiceEndpoint* endpoint);
+
 /**
  * @brief Get the service descriptor
  * 
@@ -95,8 +146,12 @@ const ServiceDescriptor* service_endpoint_get_descriptor(const ServiceEndpoint*
 /**
  * @brief Connect to a service endpoint
  * 
+ * Internal and system services return their furi record. External services
+ * return the client side of a new channel, PipeSide*, and hand the other side
+ * to the accept_callback of the service.
+ * 
  * @param endpoint 
- * @return void* Handle to the service connection
+ * @return void* Handle to the service connection or NULL
  */
 void* service_endpoint_connect(ServiceEndpoint* endpoint);
 
@@ -108,6 +163,100 @@ void* service_endpoint_connect(ServiceEndpoint* endpoint);
  */
 void service_endpoint_disconnect(ServiceEndpoint* endpoint, void* handle);
 
+/**
+ * @brief Run the health check of a service
+ * 
+ * @param endpoint 
+ * @param args passed to the probe callback
+ * @return false if the service has no probe callback or is unhealthy
+ */
+bool service_endpoint_probe(ServiceEndpoint* endpoint, const char* args);
+
+/**
+ * @brief Take a buffer from the pool of an external service
+ * 
+ * Blocks while every buffer is in flight, which throttles fast producers.
+ * 
+ * @param endpoint external service with buffer_count > 0
+ * @param timeout 
+ * @return ServiceBuffer* owned by the caller or NULL on timeout
+ */
+ServiceBuffer* service_buffer_acquire(ServiceEndpoint* endpoint, FuriWait timeout);
+
+/**
+ * @brief Return a buffer to its pool
+ * 
+ * @param buffer buffer owned by the caller
+ */
+void service_buffer_release(ServiceBuffer* buffer);
+
+/**
+ * @brief Get buffer payload
+ * 
+ * @param buffer 
+ * @return uint8_t* service buffer_size bytes
+ */
+uint8_t* service_buffer_get_data(ServiceBuffer* buffer);
+
+/**
+ * @brief Get buffer payload capacity
+ * 
+ * @param buffer 
+ * @return size_t buffer_size of the service
+ */
+size_t service_buffer_get_capacity(const ServiceBuffer* buffer);
+
+/**
+ * @brief Set number of payload bytes in use
+ * 
+ * @param buffer 
+ * @param size at most the capacity
+ */
+void service_buffer_set_size(ServiceBuffer* buffer, size_t size);
+
+/**
+ * @brief Get number of payload bytes in use
+ * 
+ * @param buffer 
+ * @return size_t 
+ */
+size_t service_buffer_get_size(const ServiceBuffer* buffer);
+
+/**
+ * @brief Pass a buffer to the other side of a channel
+ * 
+ * Only the buffer reference goes through the pipe, the payload is not copied.
+ * Channels can be attached to an event loop with pipe_attach_to_event_loop.
+ * Only one thread may send on each side of a channel. A buffer sent after the
+ * peer freed its side is released here.
+ * 
+ * @param channel 
+ * @param buffer buffer owned by the caller
+ * @param timeout 
+ * @return true if the caller doesn't own the buffer anymore, false if it still does
+ */
+bool service_channel_send(PipeSide* channel, ServiceBuffer* buffer, FuriWait timeout);
+
+/**
+ * @brief Take a buffer sent by the other side of a channel
+ * 
+ * @param channel 
+ * @param timeout 
+ * @return ServiceBuffer* owned by the caller or NULL on timeout
+ */
+ServiceBuffer* service_channel_receive(PipeSide* channel, FuriWait timeout);
+
+/**
+ * @brief Free the provider side of a channel
+ * 
+ * Buffers that were not received yet go back to their pool. A buffer the
+ * consumer sends between that drain and the free is left in the pipe, so free
+ * the provider side once the consumer has freed its own (pipe broken).
+ * 
+ * @param channel channel detached from its event loop
+ */
+void service_channel_free(PipeSide* channel);
+
 #ifdef __cplusplus
 }
 #endif
@@ -58,9 +58,8 @@ FuriEventLoop* furi_event_loop_alloc(void) {
 
     FuriEventLoopTree_init(instance->tree);
     WaitingList_init(instance->waiting_list);
-    TimerList_init(instance->timer_list);
+    TimerHeap_init(instance->timer_heap);
     TimerQueue_init(instance->timer_queue);
-    PendingQueue_init(instance->pending_queue);
 
     // Clear notification state and value
     TaskHandle_t task = (TaskHandle_t)instance->thread_id;
@@ -76,11 +75,11 @@ void furi_event_loop_free(FuriEventLoop* instance) {
     furi_check(instance->state == FuriEventLoopStateStopped);
 
     furi_event_loop_process_timer_queue(instance);
-    furi_check(TimerList_empty_p(instance->timer_list));
+    furi_check(TimerHeap_empty_p(instance->timer_heap));
     furi_check(WaitingList_empty_p(instance->waiting_list));
 
     FuriEventLoopTree_clear(instance->tree);
-    PendingQueue_clear(instance->pending_queue);
+    TimerHeap_clear(instance->timer_heap);
 
     uint32_t flags = 0;
     BaseType_t ret = xTaskNotifyWaitIndexed(
@@ -189,14 +188,6 @@ static void furi_event_loop_process_waiting_list(FuriEventLoop* instance) {
     furi_event_loop_sync_flags(instance);
 }
 
-static void furi_event_loop_process_pending_callbacks(FuriEventLoop* instance) {
-    for(; !PendingQueue_empty_p(instance->pending_queue);
-        PendingQueue_pop_back(NULL, instance->pending_queue)) {
-        const FuriEventLoopPendingQueueItem* item = PendingQueue_back(instance->pending_queue);
-        item->callback(item->context);
-    }
-}
-
 static void furi_event_loop_restore_flags(FuriEventLoop* instance, uint32_t flags) {
     if(flags) {
         xTaskNotifyIndexed(
@@ -204,6 +195,46 @@ static void furi_event_loop_restore_flags(FuriEventLoop* instance, uint32_t flag
     }
 }
 
+static bool furi_event_loop_pending_queue_pop(
+    FuriEventLoopPendingQueue* queue,
+    FuriEventLoopPendingQueueItem* item) {
+    bool popped = false;
+
+    FURI_CRITICAL_ENTER();
+    if(queue->head != queue->tail) {
+        *item = queue->items[queue->head % FURI_EVENT_LOOP_PENDING_QUEUE_SIZE];
+        queue->head++;
+        popped = true;
+    }
+    FURI_CRITICAL_EXIT();
+
+    return popped;
+}
+
+static void furi_event_loop_process_pending_callbacks(FuriEventLoop* instance) {
+    FuriEventLoopPendingQueue* queue = &instance->pending_queue;
+    FuriEventLoopPendingQueueItem item;
+    size_t count = 0;
+    bool drained = false;
+
+    while(!queue->batch_size || count < queue->batch_size) {
+        if(!furi_event_loop_pending_queue_pop(queue, &item)) {
+            drained = true;
+            break;
+        }
+        item.callback(item.context);
+        count++;
+    }
+
+    if(count) queue->stats.wakeups++;
+
+    // Callbacks left over the batch wait for the next wakeup, letting other events in first
+    if(!drained && queue->head != queue->tail) {
+        queue->stats.deferred++;
+        furi_event_loop_restore_flags(instance, FuriEventLoopFlagPending);
+    }
+}
+
 void furi_event_loop_run(FuriEventLoop* instance) {
     furi_check(instance);
     furi_check(instance->thread_id == furi_thread_get_current_id());
@@ -286,22 +317,56 @@ void furi_event_loop_stop(FuriEventLoop* instance) {
  * Public deferred function call API
  */
 
-void furi_event_loop_pend_callback(
+bool furi_event_loop_pend_callback(
     FuriEventLoop* instance,
     FuriEventLoopPendingCallback callback,
     void* context) {
     furi_check(instance);
-    furi_check(instance->thread_id == furi_thread_get_current_id());
     furi_check(callback);
 
-    const FuriEventLoopPendingQueueItem item = {
-        .callback = callback,
-        .context = context,
-    };
+    FuriEventLoopPendingQueue* queue = &instance->pending_queue;
+
+    FURI_CRITICAL_ENTER();
+    const uint32_t count = queue->tail - queue->head;
+    const bool full = count >= FURI_EVENT_LOOP_PENDING_QUEUE_SIZE;
+    if(!full) {
+        FuriEventLoopPendingQueueItem* item =
+            &queue->items[queue->tail % FURI_EVENT_LOOP_PENDING_QUEUE_SIZE];
+        item->callback = callback;
+        item->context = context;
+        queue->tail++;
+
+        queue->stats.pended++;
+        queue->stats.peak = MAX(queue->stats.peak, count + 1);
+        if(count) queue->stats.coalesced++;
+    } else {
+        queue->stats.dropped++;
+    }
+    FURI_CRITICAL_EXIT();
+
+    if(full) return false;
+
+    // A non-empty queue already has a wakeup on the way
+    if(!count) furi_event_loop_notify(instance, FuriEventLoopFlagPending);
+    return true;
+}
+
+void furi_event_loop_set_pending_batch_size(FuriEventLoop* instance, size_t batch_size) {
+    furi_check(instance);
+    furi_check(instance->thread_id == furi_thread_get_current_id());
+
+    instance->pending_queue.batch_size = batch_size;
+}
 
-    PendingQueue_push_front(instance->pending_queue, item);
+void furi_event_loop_get_pending_stats(
+    const FuriEventLoop* instance,
+    FuriEventLoopPendingStats* stats) {
+    furi_check(instance);
+    furi_check(stats);
 
-    furi_event_loop_notify(instance, FuriEventLoopFlagPending);
+    FURI_CRITICAL_ENTER();
+    *stats = instance->pending_queue.stats;
+    FURI_CRITICAL_EXIT();
 }
 
 /*
@@ -380,6 +445,18 @@ void furi_event_loop_subscribe_message_queue(
         instance, message_queue, &furi_message_queue_event_loop_contract, event, callback, context);
 }
 
+void furi_event_loop_subscribe_message_pool(
+    FuriEventLoop* instance,
+    FuriMessagePool* message_pool,
+    FuriEventLoopEvent event,
+    FuriEventLoopEventCallback callback,
+    void* context) {
+    extern const FuriEventLoopContract furi_message_pool_event_loop_contract;
+
+    furi_event_loop_object_subscribe(
+        instance, message_pool, &furi_message_pool_event_loop_contract, event, callback, context);
+}
+
 void furi_event_loop_subscribe_stream_buffer(
     FuriEventLoop* instance,
     FuriStreamBuffer* stream_buffer,
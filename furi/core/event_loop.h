@@ -13,7 +13,9 @@
  *             limitations from our side.
  *
  * @warning Only ONE instance of FuriEventLoop per thread is possible. ALL FuriEventLoop
- * funcitons MUST be called from the same thread that the instance was created in.
+ * funcitons MUST be called from the same thread that the instance was created in,
+ * except furi_event_loop_stop(), furi_event_loop_pend_callback() and
+ * furi_event_loop_get_pending_stats().
  */
 #pragma once
 
@@ -38,6 +40,7 @@ typedef enum {
      *
      * In events occur on the following conditions:
      * - One or more items were inserted into a FuriMessageQueue,
+     * - One or more messages were put into a FuriMessagePool,
      * - Enough data has been written to a FuriStreamBuffer,
      * - A FuriSemaphore has been released at least once,
      * - A FuriMutex has been released.
@@ -48,6 +51,7 @@ typedef enum {
      *
      * Out events occur on the following conditions:
      * - One or more items were removed from a FuriMessageQueue,
+     * - One or more slots were released to a FuriMessagePool,
      * - Any amount of data has been read out of a FuriStreamBuffer,
      * - A FuriSemaphore has been acquired at least once,
      * - A FuriMutex has been acquired.
@@ -65,12 +69,14 @@ typedef enum {
      *
      * In events:
      * - a FuriMessageQueue contains one or more items,
+     * - a FuriMessagePool has one or more messages queued,
      * - a FuriStreamBuffer contains one or more bytes,
      * - a FuriSemaphore can be acquired at least once,
      * - a FuriMutex can be acquired.
      *
      * Out events:
      * - a FuriMessageQueue has at least one item of free space,
+     * - a FuriMessagePool has at least one free slot,
      * - a FuriStreamBuffer has at least one byte of free space,
      * - a FuriSemaphore has been acquired at least once,
      * - a FuriMutex has been acquired.
@@ -176,20 +182,63 @@ void furi_event_loop_tick_set(
  */
 typedef void (*FuriEventLoopPendingCallback)(void* context);
 
+/**
+ * @brief Pending callback statistics, see furi_event_loop_get_pending_stats()
+ */
+typedef struct {
+    uint32_t pended; /**< Callbacks queued */
+    uint32_t wakeups; /**< Event loop wakeups that called pending callbacks */
+    uint32_t coalesced; /**< Callbacks queued behind others, sharing their wakeup */
+    uint32_t deferred; /**< Wakeups that stopped at the batch size with callbacks left */
+    uint32_t peak; /**< Most callbacks queued at once */
+    uint32_t dropped; /**< Callbacks refused, the queue was full */
+} FuriEventLoopPendingStats;
+
 /**
  * @brief Call a function when all preceding timer commands are processed
  *
  * This function may be useful to call another function when the event loop has been started.
  *
+ * Can be called from any thread or interrupt. Callbacks are kept in a fixed size queue
+ * without allocating memory and are called in order on the event loop thread. Callbacks
+ * pended while others are waiting share their wakeup.
+ *
+ * A full queue refuses the callback instead of waiting, so a producer outpacing the event
+ * loop can back off, retry later or drop its work.
+ *
  * @param[in,out] instance pointer to the current FuriEventLoop instance
  * @param[in] callback pointer to the callback to be executed when previous commands have been processed
  * @param[in,out] context pointer to a user-specific object (will be passed to the callback)
+ * @return true if the callback was queued, false if the queue was full
  */
-void furi_event_loop_pend_callback(
+bool furi_event_loop_pend_callback(
     FuriEventLoop* instance,
     FuriEventLoopPendingCallback callback,
     void* context);
 
+/**
+ * @brief Limit the number of pending callbacks called per wakeup
+ *
+ * The rest of the callbacks are called on the next wakeup, after the events and timers
+ * that came in meanwhile. By default all pending callbacks are called at once.
+ *
+ * @param[in,out] instance pointer to the current FuriEventLoop instance
+ * @param[in] batch_size callbacks per wakeup, 0 for all
+ */
+void furi_event_loop_set_pending_batch_size(FuriEventLoop* instance, size_t batch_size);
+
+/**
+ * @brief Get pending callback statistics
+ *
+ * Can be called from any thread.
+ *
+ * @param[in] instance pointer to a FuriEventLoop instance
+ * @param[out] stats pointer to the statistics to fill in
+ */
+void furi_event_loop_get_pending_stats(
+    const FuriEventLoop* instance,
+    FuriEventLoopPendingStats* stats);
+
 /*
  * Event subscription/notification APIs
  */
@@ -244,6 +293,28 @@ void furi_event_loop_subscribe_message_queue(
     FuriEventLoopEventCallback callback,
     void* context);
 
+/** Opaque message pool type */
+typedef struct FuriMessagePool FuriMessagePool;
+
+/** Subscribe to message pool events
+ *
+ * In events come with messages in the queue, Out events with free slots in the pool.
+ *
+ * @warning you can only have one subscription for one event type.
+ *
+ * @param      instance       The Event Loop instance
+ * @param      message_pool   The message pool to add
+ * @param[in]  event          The Event Loop event to trigger on
+ * @param[in]  callback       The callback to call on event
+ * @param      context        The context for callback
+ */
+void furi_event_loop_subscribe_message_pool(
+    FuriEventLoop* instance,
+    FuriMessagePool* message_pool,
+    FuriEventLoopEvent event,
+    FuriEventLoopEventCallback callback,
+    void* context);
+
 /** Opaque stream buffer type */
 typedef struct FuriStreamBuffer FuriStreamBuffer;
 
@@ -5,7 +5,6 @@
 #include "event_loop_timer_i.h"
 #include "event_loop_tick_i.h"
 
-#include <m-list.h>
 #include <m-bptree.h>
 #include <m-i-list.h>
 
@@ -67,12 +66,25 @@ typedef enum {
     FuriEventLoopStateRunning,
 } FuriEventLoopState;
 
+#define FURI_EVENT_LOOP_PENDING_QUEUE_SIZE (32)
+
+_Static_assert(
+    (FURI_EVENT_LOOP_PENDING_QUEUE_SIZE & (FURI_EVENT_LOOP_PENDING_QUEUE_SIZE - 1)) == 0,
+    "Pending queue size must be a power of two");
+
 typedef struct {
     FuriEventLoopPendingCallback callback;
     void* context;
 } FuriEventLoopPendingQueueItem;
 
-LIST_DUAL_PUSH_DEF(PendingQueue, FuriEventLoopPendingQueueItem, M_POD_OPLIST)
+// Filled by any thread or interrupt, drained by the event loop thread
+typedef struct {
+    FuriEventLoopPendingQueueItem items[FURI_EVENT_LOOP_PENDING_QUEUE_SIZE];
+    uint32_t head; // Next item to call, free running
+    uint32_t tail; // Next free slot, free running
+    size_t batch_size; // Callbacks per wakeup, 0 for all
+    FuriEventLoopPendingStats stats;
+} FuriEventLoopPendingQueue;
 
 struct FuriEventLoop {
     // Only works if all operations are done from the same thread
@@ -86,12 +98,13 @@ struct FuriEventLoop {
     FuriEventLoopTree_t tree;
     WaitingList_t waiting_list;
 
-    // Active timer list
-    TimerList_t timer_list;
+    // Active timer heap
+    TimerHeap_t timer_heap;
+    uint32_t timer_sequence;
     // Timer request queue
     TimerQueue_t timer_queue;
     // Pending callback queue
-    PendingQueue_t pending_queue;
+    FuriEventLoopPendingQueue pending_queue;
     // Tick event
     FuriEventLoopTick tick;
 };
@@ -23,31 +23,99 @@ static inline bool furi_event_loop_timer_is_expired(const FuriEventLoopTimer* ti
     return furi_event_loop_timer_get_elapsed_time(timer) >= timer->interval;
 }
 
-static void furi_event_loop_schedule_timer(FuriEventLoop* instance, FuriEventLoopTimer* timer) {
-    FuriEventLoopTimer* timer_pos = NULL;
+/*
+ * The heap is ordered by the time left until expiration, negative once
+ * expired. It shrinks at the same pace for every timer, so the order of the
+ * heap stays valid as time passes and any tick can be used to compare. Timers
+ * expiring together run in the order they were armed.
+ */
 
-    FURI_CRITICAL_ENTER();
+static inline int64_t
+    furi_event_loop_timer_get_heap_key(const FuriEventLoopTimer* timer, uint32_t now) {
+    return (int64_t)timer->interval - (uint32_t)(now - timer->start_time);
+}
 
-    const uint32_t remaining_time = furi_event_loop_timer_get_remaining_time_private(timer);
+static inline bool furi_event_loop_timer_is_before(
+    const FuriEventLoopTimer* timer,
+    const FuriEventLoopTimer* other,
+    uint32_t now) {
+    const int64_t key = furi_event_loop_timer_get_heap_key(timer, now);
+    const int64_t other_key = furi_event_loop_timer_get_heap_key(other, now);
+    return key < other_key ||
+           (key == other_key && (int32_t)(timer->sequence - other->sequence) < 0);
+}
 
-    TimerList_it_t it;
-    for(TimerList_it_last(it, instance->timer_list); !TimerList_end_p(it);
-        TimerList_previous(it)) {
-        FuriEventLoopTimer* tmp = TimerList_ref(it);
-        if(remaining_time >= furi_event_loop_timer_get_remaining_time_private(tmp)) {
-            timer_pos = tmp;
-            break;
-        }
+static inline void furi_event_loop_timer_heap_set(
+    FuriEventLoop* instance,
+    size_t index,
+    FuriEventLoopTimer* timer) {
+    *TimerHeap_get(instance->timer_heap, index) = timer;
+    timer->heap_index = index;
+}
+
+static void
+    furi_event_loop_timer_heap_sift_up(FuriEventLoop* instance, size_t index, uint32_t now) {
+    FuriEventLoopTimer* timer = *TimerHeap_get(instance->timer_heap, index);
+
+    while(index > 0) {
+        const size_t parent_index = (index - 1) / 2;
+        FuriEventLoopTimer* parent = *TimerHeap_get(instance->timer_heap, parent_index);
+        if(!furi_event_loop_timer_is_before(timer, parent, now)) break;
+
+        furi_event_loop_timer_heap_set(instance, index, parent);
+        index = parent_index;
     }
 
-    FURI_CRITICAL_EXIT();
+    furi_event_loop_timer_heap_set(instance, index, timer);
+}
 
-    if(timer_pos) {
-        TimerList_push_after(timer_pos, timer);
-    } else {
-        TimerList_push_front(instance->timer_list, timer);
+static void
+    furi_event_loop_timer_heap_sift_down(FuriEventLoop* instance, size_t index, uint32_t now) {
+    const size_t count = TimerHeap_size(instance->timer_heap);
+    FuriEventLoopTimer* timer = *TimerHeap_get(instance->timer_heap, index);
+
+    while(index * 2 + 1 < count) {
+        size_t child_index = index * 2 + 1;
+        FuriEventLoopTimer* child = *TimerHeap_get(instance->timer_heap, child_index);
+
+        if(child_index + 1 < count) {
+            FuriEventLoopTimer* right = *TimerHeap_get(instance->timer_heap, child_index + 1);
+            if(furi_event_loop_timer_is_before(right, child, now)) {
+                child_index++;
+                child = right;
+            }
+        }
+
+        if(!furi_event_loop_timer_is_before(child, timer, now)) break;
+
+        furi_event_loop_timer_heap_set(instance, index, child);
+        index = child_index;
     }
-    // At this point, TimerList_front() points to the first timer to expire
+
+    furi_event_loop_timer_heap_set(instance, index, timer);
+}
+
+static void furi_event_loop_schedule_timer(FuriEventLoop* instance, FuriEventLoopTimer* timer) {
+    timer->sequence = instance->timer_sequence++;
+    TimerHeap_push_back(instance->timer_heap, timer);
+    furi_event_loop_timer_heap_sift_up(
+        instance, TimerHeap_size(instance->timer_heap) - 1, xTaskGetTickCount());
+    // At this point, the first timer of the heap is the first to expire
+}
+
+static void furi_event_loop_unschedule_timer(FuriEventLoop* instance, FuriEventLoopTimer* timer) {
+    const size_t index = timer->heap_index;
+    furi_check(*TimerHeap_get(instance->timer_heap, index) == timer);
+
+    FuriEventLoopTimer* last;
+    TimerHeap_pop_back(&last, instance->timer_heap);
+    if(last == timer) return;
+
+    // The last timer takes the freed place and moves whichever way it has to
+    const uint32_t now = xTaskGetTickCount();
+    furi_event_loop_timer_heap_set(instance, index, last);
+    furi_event_loop_timer_heap_sift_up(instance, index, now);
+    furi_event_loop_timer_heap_sift_down(instance, last->heap_index, now);
 }
 
 static void furi_event_loop_timer_enqueue_request(
@@ -78,8 +146,8 @@ static void furi_event_loop_timer_enqueue_request(
 uint32_t furi_event_loop_get_timer_wait_time(const FuriEventLoop* instance) {
     uint32_t wait_time = FuriWaitForever;
 
-    if(!TimerList_empty_p(instance->timer_list)) {
-        FuriEventLoopTimer* timer = TimerList_front(instance->timer_list);
+    if(!TimerHeap_empty_p(instance->timer_heap)) {
+        FuriEventLoopTimer* timer = *TimerHeap_cget(instance->timer_heap, 0);
         wait_time = furi_event_loop_timer_get_remaining_time_private(timer);
     }
 
@@ -91,7 +159,7 @@ void furi_event_loop_process_timer_queue(FuriEventLoop* instance) {
         FuriEventLoopTimer* timer = TimerQueue_pop_front(instance->timer_queue);
 
         if(timer->active) {
-            TimerList_unlink(timer);
+            furi_event_loop_unschedule_timer(instance, timer);
         }
 
         if(timer->request == FuriEventLoopTimerRequestStart) {
@@ -116,26 +184,27 @@ void furi_event_loop_process_timer_queue(FuriEventLoop* instance) {
 }
 
 bool furi_event_loop_process_expired_timers(FuriEventLoop* instance) {
-    if(TimerList_empty_p(instance->timer_list)) {
+    if(TimerHeap_empty_p(instance->timer_heap)) {
         return false;
     }
-    // The front() element contains the earliest-expiring timer
-    FuriEventLoopTimer* timer = TimerList_front(instance->timer_list);
+    // The first element of the heap is the earliest-expiring timer
+    FuriEventLoopTimer* timer = *TimerHeap_cget(instance->timer_heap, 0);
 
     if(!furi_event_loop_timer_is_expired(timer)) {
         return false;
     }
 
-    TimerList_unlink(timer);
-
     if(timer->periodic) {
         const uint32_t num_events =
             furi_event_loop_timer_get_elapsed_time(timer) / timer->interval;
 
+        // Rearmed in place, it can only move down the heap
         timer->start_time += timer->interval * num_events;
-        furi_event_loop_schedule_timer(instance, timer);
+        timer->sequence = instance->timer_sequence++;
+        furi_event_loop_timer_heap_sift_down(instance, 0, xTaskGetTickCount());
 
     } else {
+        furi_event_loop_unschedule_timer(instance, timer);
         timer->active = false;
     }
 
@@ -164,7 +233,6 @@ FuriEventLoopTimer* furi_event_loop_timer_alloc(
     timer->context = context;
     timer->periodic = (type == FuriEventLoopTimerTypePeriodic);
 
-    TimerList_init_field(timer);
     TimerQueue_init_field(timer);
 
     return timer;
@@ -2,6 +2,7 @@
 
 #include "event_loop_timer.h"
 
+#include <m-array.h>
 #include <m-i-list.h>
 
 typedef enum {
@@ -21,8 +22,10 @@ struct FuriEventLoopTimer {
     uint32_t start_time;
     uint32_t next_interval;
 
-    // Interface for the active timer list
-    ILIST_INTERFACE(TimerList, FuriEventLoopTimer);
+    // Position in the active timer heap while active
+    size_t heap_index;
+    // Arming order, breaks ties between timers expiring together
+    uint32_t sequence;
 
     // Interface for the timer request queue
     ILIST_INTERFACE(TimerQueue, FuriEventLoopTimer);
@@ -33,7 +36,8 @@ struct FuriEventLoopTimer {
     bool periodic;
 };
 
-ILIST_DEF(TimerList, FuriEventLoopTimer, M_POD_OPLIST)
+// Active timers as a binary min-heap by remaining time, the first one expires first
+ARRAY_DEF(TimerHeap, FuriEventLoopTimer*, M_PTR_OPLIST) // NOLINT
 ILIST_DEF(TimerQueue, FuriEventLoopTimer, M_POD_OPLIST)
 
 uint32_t furi_event_loop_get_timer_wait_time(const FuriEventLoop* instance);
@@ -1,4 +1,5 @@
 #include "memmgr.h"
+#include "memmgr_heap_i.h"
 #include <string.h>
 #include <furi_hal_memory.h>
 #include <FreeRTOS.h>
@@ -48,11 +49,11 @@ char* strdup(const char* s) {
 }
 
 size_t memmgr_get_free_heap(void) {
-    return xPortGetFreeHeapSize();
+    return xPortGetFreeHeapSize() + memmgr_heap_slab_get_free_size();
 }
 
 size_t memmgr_get_total_heap(void) {
-    return configTOTAL_HEAP_SIZE;
+    return configTOTAL_HEAP_SIZE + MEMMGR_HEAP_SLAB_ARENA_SIZE;
 }
 
 size_t memmgr_get_minimum_free_heap(void) {
@@ -18,12 +18,17 @@ extern "C" {
 #define FURI_MEMMGR_GUARD 1
 
 /** Get free heap size
+ *
+ * Includes free space of the slabs, which only serve allocations of up to
+ * 128 bytes. Use memmgr_heap_get_max_free_block() to check for large blocks.
  *
  * @return     free heap size in bytes
  */
 size_t memmgr_get_free_heap(void);
 
 /** Get total heap size
+ *
+ * Includes the slab arena.
  *
  * @return     total heap size in bytes
  */
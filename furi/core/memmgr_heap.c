@@ -27,6 +27,8 @@
  */
 
 /*
+ * Default heap, see memmgr_heap_tlsf.c for the HEAP=tlsf build option.
+ *
  * A sample implementation of pvPortMalloc() and vPortFree() that combines
  * (coalescences) adjacent memory blocks as they are freed, and in so doing
  * limits memory fragmentation.
@@ -35,7 +37,7 @@
  * memory management pages of https://www.FreeRTOS.org for more information.
  */
 
-#include "memmgr_heap.h"
+#include "memmgr_heap_i.h"
 #include "check.h"
 #include <stdlib.h>
 #include <string.h>
@@ -58,6 +60,8 @@
 
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
+#ifndef FURI_HEAP_TLSF
+
 #if(configSUPPORT_DYNAMIC_ALLOCATION == 0)
 #error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
 #endif
@@ -175,114 +179,13 @@ PRIVILEGED_DATA static size_t xMinimumEverFreeBytesRemaining = (size_t)0U;
 PRIVILEGED_DATA static size_t xNumberOfSuccessfulAllocations = (size_t)0U;
 PRIVILEGED_DATA static size_t xNumberOfSuccessfulFrees = (size_t)0U;
 
-/* Furi heap extension */
-#include <m-dict.h>
-
-/* Allocation tracking types */
-DICT_DEF2(MemmgrHeapAllocDict, uint32_t, uint32_t) //-V1048
-
-DICT_DEF2( //-V1048
-    MemmgrHeapThreadDict,
-    uint32_t,
-    M_DEFAULT_OPLIST,
-    MemmgrHeapAllocDict_t,
-    DICT_OPLIST(MemmgrHeapAllocDict))
-
-/* Thread allocation tracing storage */
-static MemmgrHeapThreadDict_t memmgr_heap_thread_dict = {0};
-static volatile uint32_t memmgr_heap_thread_trace_depth = 0;
-
-/* Initialize tracing storage on start */
-void memmgr_heap_init(void) {
-    MemmgrHeapThreadDict_init(memmgr_heap_thread_dict);
-}
-
-void memmgr_heap_enable_thread_trace(FuriThreadId thread_id) {
-    vTaskSuspendAll();
-    {
-        memmgr_heap_thread_trace_depth++;
-        furi_check(MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id) == NULL);
-        MemmgrHeapAllocDict_t alloc_dict;
-        MemmgrHeapAllocDict_init(alloc_dict);
-        MemmgrHeapThreadDict_set_at(memmgr_heap_thread_dict, (uint32_t)thread_id, alloc_dict);
-        MemmgrHeapAllocDict_clear(alloc_dict);
-        memmgr_heap_thread_trace_depth--;
-    }
-    (void)xTaskResumeAll();
-}
-
-void memmgr_heap_disable_thread_trace(FuriThreadId thread_id) {
-    vTaskSuspendAll();
-    {
-        memmgr_heap_thread_trace_depth++;
-        furi_check(MemmgrHeapThreadDict_erase(memmgr_heap_thread_dict, (uint32_t)thread_id));
-        memmgr_heap_thread_trace_depth--;
-    }
-    (void)xTaskResumeAll();
-}
-
-size_t memmgr_heap_get_thread_memory(FuriThreadId thread_id) {
-    size_t leftovers = MEMMGR_HEAP_UNKNOWN;
-    vTaskSuspendAll();
-    {
-        memmgr_heap_thread_trace_depth++;
-        MemmgrHeapAllocDict_t* alloc_dict =
-            MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id);
-        if(alloc_dict) {
-            leftovers = 0;
-            MemmgrHeapAllocDict_it_t alloc_dict_it;
-            for(MemmgrHeapAllocDict_it(alloc_dict_it, *alloc_dict);
-                !MemmgrHeapAllocDict_end_p(alloc_dict_it);
-                MemmgrHeapAllocDict_next(alloc_dict_it)) {
-                MemmgrHeapAllocDict_itref_t* data = MemmgrHeapAllocDict_ref(alloc_dict_it);
-                if(data->key != 0) {
-                    uint8_t* puc = (uint8_t*)data->key;
-                    puc -= xHeapStructSize;
-                    BlockLink_t* pxLink = (void*)puc;
-
-                    if((pxLink->xBlockSize & heapBLOCK_ALLOCATED_BITMASK) &&
-                       pxLink->pxNextFreeBlock == NULL) {
-                        leftovers += data->value;
-                    }
-                }
-            }
-        }
-        memmgr_heap_thread_trace_depth--;
-    }
-    (void)xTaskResumeAll();
-    return leftovers;
-}
-
-#undef traceMALLOC
-static inline void traceMALLOC(void* pointer, size_t size) {
-    FuriThreadId thread_id = furi_thread_get_current_id();
-    if(thread_id && memmgr_heap_thread_trace_depth == 0) {
-        memmgr_heap_thread_trace_depth++;
-        MemmgrHeapAllocDict_t* alloc_dict =
-            MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id);
-        if(alloc_dict) {
-            MemmgrHeapAllocDict_set_at(*alloc_dict, (uint32_t)pointer, (uint32_t)size);
-        }
-        memmgr_heap_thread_trace_depth--;
-    }
-}
-
-#undef traceFREE
-static inline void traceFREE(void* pointer, size_t size) {
-    UNUSED(size);
-    FuriThreadId thread_id = furi_thread_get_current_id();
-    if(thread_id && memmgr_heap_thread_trace_depth == 0) {
-        memmgr_heap_thread_trace_depth++;
-        MemmgrHeapAllocDict_t* alloc_dict =
-            MemmgrHeapThreadDict_get(memmgr_heap_thread_dict, (uint32_t)thread_id);
-        if(alloc_dict) {
-            // In some cases thread may want to release memory that was not allocated by it
-            const bool res = MemmgrHeapAllocDict_erase(*alloc_dict, (uint32_t)pointer);
-            UNUSED(res);
-        }
-        memmgr_heap_thread_trace_depth--;
-    }
-}
+/* Furi heap extension: allocated blocks carry the heap trace owner of the
+ * allocation in the size bits right below the allocated bit. */
+#define heapSET_BLOCK_OWNER(pxBlock, ucOwner) \
+    ((pxBlock->xBlockSize) |= (size_t)(ucOwner) << MEMMGR_HEAP_OWNER_SHIFT)
+#define heapGET_BLOCK_OWNER(pxBlock) \
+    ((uint8_t)(((pxBlock->xBlockSize) & MEMMGR_HEAP_OWNER_MASK) >> MEMMGR_HEAP_OWNER_SHIFT))
+#define heapCLEAR_BLOCK_OWNER(pxBlock) ((pxBlock->xBlockSize) &= ~MEMMGR_HEAP_OWNER_MASK)
 
 size_t memmgr_heap_get_max_free_block(void) {
     HeapStats_t heap_stats;
@@ -295,15 +198,36 @@ void memmgr_heap_printf_free_blocks(void) {
     //can be enabled once we can do printf with a locked scheduler
     //vTaskSuspendAll();
 
-    pxBlock = xStart.pxNextFreeBlock;
-    while(pxBlock->pxNextFreeBlock != NULL) {
+    if(pxEnd == NULL) return;
+
+    pxBlock = heapPROTECT_BLOCK_POINTER(xStart.pxNextFreeBlock);
+    while(pxBlock != pxEnd) {
+        heapVALIDATE_BLOCK_POINTER(pxBlock);
         printf("A %p S %lu\r\n", (void*)pxBlock, (uint32_t)pxBlock->xBlockSize);
-        pxBlock = pxBlock->pxNextFreeBlock;
+        pxBlock = heapPROTECT_BLOCK_POINTER(pxBlock->pxNextFreeBlock);
     }
 
     //xTaskResumeAll();
 }
 
+void memmgr_heap_walk(MemmgrHeapBlockCallback callback, void* context) {
+    if(pxEnd == NULL) return;
+
+    /* Blocks tile the heap from its aligned start up to pxEnd, see prvHeapInit. */
+    portPOINTER_SIZE_TYPE uxAddress = ((portPOINTER_SIZE_TYPE)ucHeap + portBYTE_ALIGNMENT_MASK) &
+                                      ~((portPOINTER_SIZE_TYPE)portBYTE_ALIGNMENT_MASK);
+    while(uxAddress < (portPOINTER_SIZE_TYPE)pxEnd) {
+        BlockLink_t* pxBlock = (BlockLink_t*)uxAddress;
+        const bool xAllocated = heapBLOCK_IS_ALLOCATED(pxBlock) != 0;
+        const size_t xBlockSize =
+            pxBlock->xBlockSize & ~(heapBLOCK_ALLOCATED_BITMASK | MEMMGR_HEAP_OWNER_MASK);
+        furi_check(xBlockSize >= xHeapStructSize, "heap block corrupted");
+
+        callback(xBlockSize, xAllocated, xAllocated ? heapGET_BLOCK_OWNER(pxBlock) : 0, context);
+        uxAddress += xBlockSize;
+    }
+}
+
 /*-----------------------------------------------------------*/
 
 void* pvPortMalloc(size_t xWantedSize) {
@@ -319,6 +243,14 @@ void* pvPortMalloc(size_t xWantedSize) {
         furi_crash("memmgt in ISR");
     }
 
+    const uint8_t ucOwner = memmgr_heap_trace_get_owner();
+
+    /* Small requests go to the size class slabs first */
+    void* pvSlab = memmgr_heap_slab_alloc(xWantedSize, ucOwner);
+    if(pvSlab != NULL) {
+        return memset(pvSlab, 0, xWantedSize);
+    }
+
     if(xWantedSize > 0) {
         /* The wanted size must be increased so it can contain a BlockLink_t
          * structure in addition to the requested amount of bytes. */
@@ -353,7 +285,6 @@ void* pvPortMalloc(size_t xWantedSize) {
          * initialisation to setup the list of free blocks. */
         if(pxEnd == NULL) {
             prvHeapInit();
-            memmgr_heap_init();
         } else {
             mtCOVERAGE_TEST_MARKER();
         }
@@ -430,8 +361,10 @@ void* pvPortMalloc(size_t xWantedSize) {
                     /* The block is being returned - it is allocated and owned
                      * by the application and has no "next" block. */
                     heapALLOCATE_BLOCK(pxBlock);
+                    heapSET_BLOCK_OWNER(pxBlock, ucOwner);
                     pxBlock->pxNextFreeBlock = heapPROTECT_BLOCK_POINTER(NULL);
                     xNumberOfSuccessfulAllocations++;
+                    memmgr_heap_trace_malloc(ucOwner, xAllocatedBlockSize);
                 } else {
                     mtCOVERAGE_TEST_MARKER();
                 }
@@ -470,11 +403,16 @@ void* pvPortMalloc(size_t xWantedSize) {
 void vPortFree(void* pv) {
     uint8_t* puc = (uint8_t*)pv;
     BlockLink_t* pxLink;
+    uint8_t ucOwner;
 
     if(FURI_IS_IRQ_MODE()) {
         furi_crash("memmgt in ISR");
     }
 
+    if(memmgr_heap_slab_free(pv)) {
+        return;
+    }
+
     if(pv != NULL) {
         /* The memory being freed will have an BlockLink_t structure immediately
          * before it. */
@@ -492,6 +430,8 @@ void vPortFree(void* pv) {
                 /* The block is being returned to the heap - it is no longer
                  * allocated. */
                 heapFREE_BLOCK(pxLink);
+                ucOwner = heapGET_BLOCK_OWNER(pxLink);
+                heapCLEAR_BLOCK_OWNER(pxLink);
 #if(configHEAP_CLEAR_MEMORY_ON_FREE == 1)
                 {
                     /* Check for underflow as this can occur if xBlockSize is
@@ -513,6 +453,7 @@ void vPortFree(void* pv) {
                     /* Add this block to the list of free blocks. */
                     xFreeBytesRemaining += pxLink->xBlockSize;
                     traceFREE(pv, pxLink->xBlockSize);
+                    memmgr_heap_trace_free(ucOwner, pxLink->xBlockSize);
                     prvInsertBlockIntoFreeList(((BlockLink_t*)pxLink));
                     xNumberOfSuccessfulFrees++;
                 }
@@ -732,3 +673,5 @@ void vPortHeapResetState(void) {
     xNumberOfSuccessfulFrees = (size_t)0U;
 }
 /*-----------------------------------------------------------*/
+
+#endif /* FURI_HEAP_TLSF */
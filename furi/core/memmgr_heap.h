@@ -14,11 +14,66 @@ extern "C" {
 
 #define MEMMGR_HEAP_UNKNOWN 0xFFFFFFFF
 
+/** Number of size classes served by slabs in front of the heap */
+#define MEMMGR_HEAP_SLAB_COUNT 4
+
+/** Bytes per slab page, pages are shared by all size classes */
+#define MEMMGR_HEAP_SLAB_PAGE_SIZE 512
+
+/** Usage of one slab size class */
+typedef struct {
+    size_t object_size; /**< Bytes per object, allocations are rounded up to it */
+    size_t pages; /**< Pages owned by the class */
+    size_t used; /**< Objects allocated now */
+    size_t peak; /**< Most objects allocated at once */
+    size_t allocations; /**< Allocations served by the class */
+    size_t fallbacks; /**< Allocations passed on to the heap, no page was free */
+} MemmgrHeapSlabStats;
+
+/** Version of the MemmgrHeapReport layout, bumped on every change */
+#define MEMMGR_HEAP_REPORT_VERSION 1
+
+/** Log2 bins of block size histograms, bin n counts blocks of 2^n up to 2^(n+1)-1 bytes */
+#define MEMMGR_HEAP_REPORT_BINS 18
+
+/** Owners with their own allocated block histogram in a heap report */
+#define MEMMGR_HEAP_REPORT_OWNERS 8
+
+/** Allocated blocks of one owner in a heap report */
+typedef struct {
+    uint32_t thread_id; /**< Traced thread, 0 for untraced blocks and owners not listed */
+    uint32_t size; /**< Bytes in blocks, headers included */
+    uint16_t blocks; /**< Block count */
+    uint16_t histogram[MEMMGR_HEAP_REPORT_BINS]; /**< Block count by log2 of the size */
+} MemmgrHeapReportOwner;
+
+/** Heap snapshot, fixed width fields only so it can be stored and sent as is */
+typedef struct {
+    uint8_t version; /**< MEMMGR_HEAP_REPORT_VERSION */
+    uint8_t owner_count; /**< Entries used in owners */
+    uint16_t fragmentation; /**< Per mille of free memory outside the largest free block */
+    uint32_t tick; /**< Taken at this system tick */
+    uint32_t free_size; /**< Bytes in free blocks */
+    uint32_t min_free_size; /**< Fewest bytes ever free */
+    uint32_t largest_free_block; /**< Bytes in the largest free block */
+    uint16_t free_blocks; /**< Free block count */
+    uint16_t free_histogram[MEMMGR_HEAP_REPORT_BINS]; /**< Free block count by log2 of the size */
+    /** Untraced blocks and owners not listed first, then the traced threads holding the most
+     * memory. Slab objects count for their owners too. */
+    MemmgrHeapReportOwner owners[MEMMGR_HEAP_REPORT_OWNERS];
+} MemmgrHeapReport;
+
 /** Memmgr heap enable thread allocation tracking
+ *
+ * Allocations of the thread are counted for it until they are freed, by any
+ * thread. Up to 127 threads are tracked at once, including stopped ones whose
+ * allocations are not freed yet. Later ones stay untracked, which is logged.
  *
  * @param      thread_id  - thread id to track
+ *
+ * @return     true if tracked, false if no tracking slot was free
  */
-void memmgr_heap_enable_thread_trace(FuriThreadId thread_id);
+bool memmgr_heap_enable_thread_trace(FuriThreadId thread_id);
 
 /** Memmgr heap disable thread allocation tracking
  *
@@ -30,7 +85,7 @@ void memmgr_heap_disable_thread_trace(FuriThreadId thread_id);
  *
  * @param      thread_id  - thread id to track
  *
- * @return     bytes allocated right now
+ * @return     bytes allocated right now, MEMMGR_HEAP_UNKNOWN if not tracked
  */
 size_t memmgr_heap_get_thread_memory(FuriThreadId thread_id);
 
@@ -44,6 +99,36 @@ size_t memmgr_heap_get_max_free_block(void);
  */
 void memmgr_heap_printf_free_blocks(void);
 
+/** Memmgr heap take a snapshot of the heap layout
+ *
+ * Walks all blocks with the scheduler suspended, so the report is consistent.
+ * Takes a few milliseconds on a busy heap.
+ *
+ * @param      report  - where to store the snapshot
+ */
+void memmgr_heap_get_report(MemmgrHeapReport* report);
+
+/** Memmgr heap get the number of slab size classes
+ *
+ * @return     MEMMGR_HEAP_SLAB_COUNT, 0 if the firmware is built without slabs
+ */
+size_t memmgr_heap_get_slab_count(void);
+
+/** Memmgr heap get usage of a slab size class
+ *
+ * Classes are ordered by object size, starting with 16 bytes.
+ *
+ * @param      index  - size class, below memmgr_heap_get_slab_count()
+ * @param      stats  - where to store the usage
+ */
+void memmgr_heap_get_slab_stats(size_t index, MemmgrHeapSlabStats* stats);
+
+/** Memmgr heap get the number of slab pages not owned by any size class
+ *
+ * @return     free pages of MEMMGR_HEAP_SLAB_PAGE_SIZE bytes
+ */
+size_t memmgr_heap_get_slab_free_pages(void);
+
 #ifdef __cplusplus
 }
 #endif
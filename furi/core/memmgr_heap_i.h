@@ -0,0 +1,79 @@
+#pragma once
+
+#include "memmgr_heap.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Shared by the heap backends: heap_4 in memmgr_heap.c and TLSF in
+ * memmgr_heap_tlsf.c, selected with the HEAP build option. */
+
+/* Allocated blocks keep the owner of the allocation in the size word, below
+ * the allocated bit of heap_4 and well above any heap size. Owner 0 is
+ * untraced, slabs keep owners in a side table. */
+#define MEMMGR_HEAP_OWNER_COUNT 128
+#define MEMMGR_HEAP_OWNER_SHIFT 24
+#define MEMMGR_HEAP_OWNER_MASK  ((size_t)(MEMMGR_HEAP_OWNER_COUNT - 1) << MEMMGR_HEAP_OWNER_SHIFT)
+
+/* Owner of allocations made by the current thread, read before taking locks */
+uint8_t memmgr_heap_trace_get_owner(void);
+
+/* Called with the scheduler suspended or in a critical section */
+void memmgr_heap_trace_malloc(uint8_t owner, size_t size);
+
+void memmgr_heap_trace_free(uint8_t owner, size_t size);
+
+/* Thread of an owner, NULL if free or no longer traced */
+FuriThreadId memmgr_heap_trace_get_owner_thread(uint8_t owner);
+
+size_t memmgr_heap_trace_get_owner_size(uint8_t owner);
+
+/* Block walks for heap reports, called with the scheduler suspended */
+typedef void (*MemmgrHeapBlockCallback)(size_t size, bool allocated, uint8_t owner, void* context);
+
+/* Every block of the heap in address order, implemented by the backend */
+void memmgr_heap_walk(MemmgrHeapBlockCallback callback, void* context);
+
+/* Size class slabs tried by both backends before the heap, built with the
+ * HEAP_SLAB build option, see memmgr_heap_slab.c */
+#ifdef FURI_HEAP_SLAB_PAGES
+
+#define MEMMGR_HEAP_SLAB_ARENA_SIZE (FURI_HEAP_SLAB_PAGES * MEMMGR_HEAP_SLAB_PAGE_SIZE)
+
+void* memmgr_heap_slab_alloc(size_t size, uint8_t owner);
+
+/* False if the pointer isn't from the slabs */
+bool memmgr_heap_slab_free(void* pointer);
+
+/* Allocated slab objects */
+void memmgr_heap_slab_walk(MemmgrHeapBlockCallback callback, void* context);
+
+/* Bytes of the arena not held by objects, in free pages and free objects */
+size_t memmgr_heap_slab_get_free_size(void);
+
+#else
+
+#define MEMMGR_HEAP_SLAB_ARENA_SIZE 0
+
+static inline void* memmgr_heap_slab_alloc(size_t size, uint8_t owner) {
+    UNUSED(size);
+    UNUSED(owner);
+    return NULL;
+}
+
+static inline bool memmgr_heap_slab_free(void* pointer) {
+    UNUSED(pointer);
+    return false;
+}
+
+static inline void memmgr_heap_slab_walk(MemmgrHeapBlockCallback callback, void* context) {
+    UNUSED(callback);
+    UNUSED(context);
+}
+
+static inline size_t memmgr_heap_slab_get_free_size(void) {
+    return 0;
+}
+
+#endif
@@ -0,0 +1,96 @@
+#include "memmgr_heap_i.h"
+#include "check.h"
+#include "kernel.h"
+#include <string.h>
+#include <core/common_defines.h>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+typedef struct {
+    MemmgrHeapReport* report;
+    uint8_t owner_index[MEMMGR_HEAP_OWNER_COUNT]; // Report entry of every owner
+} MemmgrHeapReportWalk;
+
+static inline size_t memmgr_heap_report_get_bin(size_t size) {
+    const size_t bin = size ? 31 - __builtin_clz(size) : 0;
+    return MIN(bin, (size_t)MEMMGR_HEAP_REPORT_BINS - 1);
+}
+
+static void memmgr_heap_report_block(size_t size, bool allocated, uint8_t owner, void* context) {
+    MemmgrHeapReportWalk* walk = context;
+    MemmgrHeapReport* report = walk->report;
+    const size_t bin = memmgr_heap_report_get_bin(size);
+
+    if(allocated) {
+        MemmgrHeapReportOwner* report_owner = &report->owners[walk->owner_index[owner]];
+        report_owner->size += size;
+        report_owner->blocks++;
+        report_owner->histogram[bin]++;
+    } else {
+        report->free_size += size;
+        report->free_blocks++;
+        report->free_histogram[bin]++;
+        report->largest_free_block = MAX(report->largest_free_block, size);
+    }
+}
+
+// Traced owners holding the most memory get their own entries, the rest go to the first one
+static void memmgr_heap_report_pick_owners(MemmgrHeapReportWalk* walk) {
+    MemmgrHeapReport* report = walk->report;
+    size_t sizes[MEMMGR_HEAP_REPORT_OWNERS] = {0};
+    uint8_t owners[MEMMGR_HEAP_REPORT_OWNERS] = {0};
+    size_t count = 1;
+
+    for(size_t owner = 1; owner < MEMMGR_HEAP_OWNER_COUNT; owner++) {
+        if(!memmgr_heap_trace_get_owner_thread(owner)) continue;
+
+        const size_t size = memmgr_heap_trace_get_owner_size(owner);
+        if(count < MEMMGR_HEAP_REPORT_OWNERS) {
+            count++;
+        } else if(size <= sizes[count - 1]) {
+            continue;
+        }
+
+        // Insert sorted by size, dropping the smallest when full
+        size_t index = count - 1;
+        for(; index > 1 && sizes[index - 1] < size; index--) {
+            sizes[index] = sizes[index - 1];
+            owners[index] = owners[index - 1];
+        }
+        sizes[index] = size;
+        owners[index] = owner;
+    }
+
+    for(size_t index = 1; index < count; index++) {
+        walk->owner_index[owners[index]] = index;
+        report->owners[index].thread_id =
+            (uint32_t)memmgr_heap_trace_get_owner_thread(owners[index]);
+    }
+    report->owner_count = count;
+}
+
+void memmgr_heap_get_report(MemmgrHeapReport* report) {
+    furi_check(report);
+
+    // On the stack, so the snapshot doesn't see blocks of its own
+    MemmgrHeapReportWalk walk = {.report = report};
+
+    memset(report, 0, sizeof(MemmgrHeapReport));
+    report->version = MEMMGR_HEAP_REPORT_VERSION;
+    report->tick = furi_get_tick();
+
+    vTaskSuspendAll();
+    {
+        memmgr_heap_report_pick_owners(&walk);
+        memmgr_heap_walk(memmgr_heap_report_block, &walk);
+        memmgr_heap_slab_walk(memmgr_heap_report_block, &walk);
+        report->min_free_size = xPortGetMinimumEverFreeHeapSize();
+    }
+    (void)xTaskResumeAll();
+
+    if(report->free_size) {
+        report->fragmentation =
+            1000 - (uint64_t)report->largest_free_block * 1000 / report->free_size;
+    }
+}
@@ -0,0 +1,263 @@
+/*
+ * Size class slabs in front of the heap, built with `./fbt HEAP_SLAB=<pages>`.
+ *
+ * Requests up to 128 bytes are rounded up to 16, 32, 64 or 128 bytes and
+ * served from 512 byte pages of a static arena, every page holding objects of
+ * one class. Objects have no header, a page that becomes empty goes back to
+ * the arena for any class. Small long-lived objects stay packed in the arena
+ * instead of scattering holes across the heap, so the largest free block of
+ * the heap stays big. A class without free objects and pages falls back to
+ * the heap.
+ *
+ * Both operations take a short critical section and never walk a list.
+ *
+ * The arena and its side tables are static, so they come out of the heap:
+ * 568 bytes per page. Free slab space counts as free heap.
+ */
+
+#include "memmgr_heap_i.h"
+#include "check.h"
+#include <string.h>
+#include <core/common_defines.h>
+
+#include <FreeRTOS.h>
+
+#ifndef configHEAP_CLEAR_MEMORY_ON_FREE
+#define configHEAP_CLEAR_MEMORY_ON_FREE 0
+#endif
+
+#ifdef FURI_HEAP_SLAB_PAGES
+
+#define MEMMGR_HEAP_SLAB_PAGE_COUNT FURI_HEAP_SLAB_PAGES
+#define MEMMGR_HEAP_SLAB_MIN_LOG2   4
+#define MEMMGR_HEAP_SLAB_MIN_SIZE   (1UL << MEMMGR_HEAP_SLAB_MIN_LOG2)
+#define MEMMGR_HEAP_SLAB_MAX_SIZE   (MEMMGR_HEAP_SLAB_MIN_SIZE << (MEMMGR_HEAP_SLAB_COUNT - 1))
+#define MEMMGR_HEAP_SLAB_UNITS      (MEMMGR_HEAP_SLAB_ARENA_SIZE >> MEMMGR_HEAP_SLAB_MIN_LOG2)
+#define MEMMGR_HEAP_SLAB_PAGES_ALL  (UINT32_MAX >> (32 - MEMMGR_HEAP_SLAB_PAGE_COUNT))
+
+_Static_assert(
+    MEMMGR_HEAP_SLAB_PAGE_COUNT > 0 && MEMMGR_HEAP_SLAB_PAGE_COUNT <= 32,
+    "One bit per page in a word");
+
+typedef struct MemmgrHeapSlabPage {
+    void* free; // Freed objects, linked through their first word
+    struct MemmgrHeapSlabPage* next; // Pages of the same class with free objects
+    struct MemmgrHeapSlabPage* prev;
+    uint16_t used;
+    uint16_t carved; // Objects taken from the untouched end of the page
+    uint8_t size_class;
+} MemmgrHeapSlabPage;
+
+typedef struct {
+    MemmgrHeapSlabPage* partial; // Pages with free objects
+    MemmgrHeapSlabStats stats;
+} MemmgrHeapSlabClass;
+
+typedef struct {
+    uint8_t arena[MEMMGR_HEAP_SLAB_ARENA_SIZE] __attribute__((aligned(portBYTE_ALIGNMENT)));
+    MemmgrHeapSlabPage pages[MEMMGR_HEAP_SLAB_PAGE_COUNT];
+    MemmgrHeapSlabClass classes[MEMMGR_HEAP_SLAB_COUNT];
+    uint32_t used_pages;
+    size_t used_size; // Bytes in allocated objects
+    uint32_t allocated[MEMMGR_HEAP_SLAB_UNITS / 32]; // Set for the first unit of every object
+    uint8_t owners[MEMMGR_HEAP_SLAB_UNITS]; // Heap trace owner by first unit
+} MemmgrHeapSlab;
+
+static MemmgrHeapSlab memmgr_heap_slab = {0};
+
+static inline size_t memmgr_heap_slab_get_class(size_t size) {
+    if(size <= MEMMGR_HEAP_SLAB_MIN_SIZE) return 0;
+    return 32 - __builtin_clz(size - 1) - MEMMGR_HEAP_SLAB_MIN_LOG2;
+}
+
+static inline size_t memmgr_heap_slab_get_unit(const void* pointer) {
+    return ((const uint8_t*)pointer - memmgr_heap_slab.arena) >> MEMMGR_HEAP_SLAB_MIN_LOG2;
+}
+
+static void memmgr_heap_slab_unlink(MemmgrHeapSlabClass* slab_class, MemmgrHeapSlabPage* page) {
+    if(page->prev) {
+        page->prev->next = page->next;
+    } else {
+        slab_class->partial = page->next;
+    }
+    if(page->next) page->next->prev = page->prev;
+    page->next = NULL;
+    page->prev = NULL;
+}
+
+static void memmgr_heap_slab_link(MemmgrHeapSlabClass* slab_class, MemmgrHeapSlabPage* page) {
+    page->prev = NULL;
+    page->next = slab_class->partial;
+    if(page->next) page->next->prev = page;
+    slab_class->partial = page;
+}
+
+static MemmgrHeapSlabPage* memmgr_heap_slab_take_page(size_t size_class) {
+    const uint32_t free_pages = ~memmgr_heap_slab.used_pages & MEMMGR_HEAP_SLAB_PAGES_ALL;
+    if(!free_pages) return NULL;
+
+    const size_t index = __builtin_ctz(free_pages);
+    memmgr_heap_slab.used_pages |= 1UL << index;
+
+    MemmgrHeapSlabPage* page = &memmgr_heap_slab.pages[index];
+    memset(page, 0, sizeof(MemmgrHeapSlabPage));
+    page->size_class = size_class;
+
+    MemmgrHeapSlabClass* slab_class = &memmgr_heap_slab.classes[size_class];
+    memmgr_heap_slab_link(slab_class, page);
+    slab_class->stats.pages++;
+
+    return page;
+}
+
+static inline bool memmgr_heap_slab_contains(const void* pointer) {
+    return (const uint8_t*)pointer >= memmgr_heap_slab.arena &&
+           (const uint8_t*)pointer < memmgr_heap_slab.arena + MEMMGR_HEAP_SLAB_ARENA_SIZE;
+}
+
+void* memmgr_heap_slab_alloc(size_t size, uint8_t owner) {
+    if(size == 0 || size > MEMMGR_HEAP_SLAB_MAX_SIZE) return NULL;
+
+    const size_t size_class = memmgr_heap_slab_get_class(size);
+    const size_t object_size = MEMMGR_HEAP_SLAB_MIN_SIZE << size_class;
+    MemmgrHeapSlabClass* slab_class = &memmgr_heap_slab.classes[size_class];
+    uint8_t* object = NULL;
+
+    FURI_CRITICAL_ENTER();
+
+    MemmgrHeapSlabPage* page = slab_class->partial;
+    if(!page) page = memmgr_heap_slab_take_page(size_class);
+
+    if(page) {
+        if(page->free) {
+            object = page->free;
+            page->free = *(void**)object;
+        } else {
+            const size_t index = page - memmgr_heap_slab.pages;
+            object = &memmgr_heap_slab.arena[index * MEMMGR_HEAP_SLAB_PAGE_SIZE] +
+                     page->carved * object_size;
+            page->carved++;
+        }
+
+        page->used++;
+        if(page->used == MEMMGR_HEAP_SLAB_PAGE_SIZE / object_size) {
+            memmgr_heap_slab_unlink(slab_class, page);
+        }
+
+        const size_t unit = memmgr_heap_slab_get_unit(object);
+        memmgr_heap_slab.allocated[unit / 32] |= 1UL << (unit % 32);
+        memmgr_heap_slab.owners[unit] = owner;
+        memmgr_heap_slab.used_size += object_size;
+        memmgr_heap_trace_malloc(owner, object_size);
+
+        slab_class->stats.used++;
+        slab_class->stats.peak = MAX(slab_class->stats.peak, slab_class->stats.used);
+        slab_class->stats.allocations++;
+    } else {
+        slab_class->stats.fallbacks++;
+    }
+
+    FURI_CRITICAL_EXIT();
+
+    return object;
+}
+
+bool memmgr_heap_slab_free(void* pointer) {
+    if(!memmgr_heap_slab_contains(pointer)) return false;
+
+    const size_t offset = (uint8_t*)pointer - memmgr_heap_slab.arena;
+    const size_t unit = offset >> MEMMGR_HEAP_SLAB_MIN_LOG2;
+    MemmgrHeapSlabPage* page = &memmgr_heap_slab.pages[offset / MEMMGR_HEAP_SLAB_PAGE_SIZE];
+
+    FURI_CRITICAL_ENTER();
+
+    const size_t object_size = MEMMGR_HEAP_SLAB_MIN_SIZE << page->size_class;
+    furi_check(
+        (offset & (object_size - 1)) == 0 &&
+            (memmgr_heap_slab.allocated[unit / 32] & (1UL << (unit % 32))),
+        "slab free of an unallocated object");
+    memmgr_heap_slab.allocated[unit / 32] &= ~(1UL << (unit % 32));
+    memmgr_heap_slab.used_size -= object_size;
+    memmgr_heap_trace_free(memmgr_heap_slab.owners[unit], object_size);
+
+#if(configHEAP_CLEAR_MEMORY_ON_FREE == 1)
+    memset(pointer, 0, object_size);
+#endif
+
+    MemmgrHeapSlabClass* slab_class = &memmgr_heap_slab.classes[page->size_class];
+    if(page->used == MEMMGR_HEAP_SLAB_PAGE_SIZE / object_size) {
+        memmgr_heap_slab_link(slab_class, page);
+    }
+
+    *(void**)pointer = page->free;
+    page->free = pointer;
+    page->used--;
+    slab_class->stats.used--;
+
+    // Empty pages go back to the arena for any class
+    if(!page->used) {
+        memmgr_heap_slab_unlink(slab_class, page);
+        memmgr_heap_slab.used_pages &= ~(1UL << (page - memmgr_heap_slab.pages));
+        slab_class->stats.pages--;
+    }
+
+    FURI_CRITICAL_EXIT();
+
+    return true;
+}
+
+void memmgr_heap_slab_walk(MemmgrHeapBlockCallback callback, void* context) {
+    for(size_t word = 0; word < COUNT_OF(memmgr_heap_slab.allocated); word++) {
+        for(uint32_t bits = memmgr_heap_slab.allocated[word]; bits; bits &= bits - 1) {
+            const size_t unit = word * 32 + __builtin_ctz(bits);
+            const MemmgrHeapSlabPage* page = &memmgr_heap_slab.pages
+                [(unit << MEMMGR_HEAP_SLAB_MIN_LOG2) / MEMMGR_HEAP_SLAB_PAGE_SIZE];
+            callback(
+                MEMMGR_HEAP_SLAB_MIN_SIZE << page->size_class,
+                true,
+                memmgr_heap_slab.owners[unit],
+                context);
+        }
+    }
+}
+
+size_t memmgr_heap_slab_get_free_size(void) {
+    return MEMMGR_HEAP_SLAB_ARENA_SIZE - memmgr_heap_slab.used_size;
+}
+
+size_t memmgr_heap_get_slab_count(void) {
+    return MEMMGR_HEAP_SLAB_COUNT;
+}
+
+void memmgr_heap_get_slab_stats(size_t index, MemmgrHeapSlabStats* stats) {
+    furi_check(index < MEMMGR_HEAP_SLAB_COUNT);
+    furi_check(stats);
+
+    FURI_CRITICAL_ENTER();
+    *stats = memmgr_heap_slab.classes[index].stats;
+    FURI_CRITICAL_EXIT();
+
+    stats->object_size = MEMMGR_HEAP_SLAB_MIN_SIZE << index;
+}
+
+size_t memmgr_heap_get_slab_free_pages(void) {
+    return MEMMGR_HEAP_SLAB_PAGE_COUNT - __builtin_popcount(memmgr_heap_slab.used_pages);
+}
+
+#else
+
+size_t memmgr_heap_get_slab_count(void) {
+    return 0;
+}
+
+void memmgr_heap_get_slab_stats(size_t index, MemmgrHeapSlabStats* stats) {
+    UNUSED(index);
+    UNUSED(stats);
+    furi_crash("Built without slabs");
+}
+
+size_t memmgr_heap_get_slab_free_pages(void) {
+    return 0;
+}
+
+#endif /* FURI_HEAP_SLAB_PAGES */
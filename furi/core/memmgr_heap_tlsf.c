@@ -0,0 +1,488 @@
+/*
+ * TLSF (two-level segregated fit) heap, built instead of memmgr_heap.c with
+ * `./fbt HEAP=tlsf`.
+ *
+ * Free blocks are kept in one list per size class. The first level splits
+ * sizes by power of two, the second level splits every power of two into 16
+ * classes, and two bitmaps tell which lists are non-empty. Malloc rounds the
+ * request up to the next class and takes the head of the first non-empty list
+ * from there, free merges with both physical neighbours through the previous
+ * block pointer in the header. Neither walks the heap, so both take the same
+ * time on a fragmented heap as on a fresh one.
+ *
+ * Blocks have the same 8 byte header as heap_4, sizes include the header and
+ * free space is accounted the same way, so heap stats, canary and trace hooks
+ * behave the same in both builds.
+ */
+
+#include "memmgr_heap_i.h"
+#include "check.h"
+#include <string.h>
+#include <stdio.h>
+#include <stm32wbxx.h>
+#include <stm32wb55_linker.h>
+#include <core/common_defines.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#ifdef FURI_HEAP_TLSF
+
+#ifndef configHEAP_CLEAR_MEMORY_ON_FREE
+#define configHEAP_CLEAR_MEMORY_ON_FREE 0
+#endif
+
+// 16 classes per power of two, below 128 bytes every 8 byte step has its own class
+#define MEMMGR_TLSF_SL_LOG2    4
+#define MEMMGR_TLSF_SL_COUNT   (1UL << MEMMGR_TLSF_SL_LOG2)
+#define MEMMGR_TLSF_ALIGN_LOG2 3
+#define MEMMGR_TLSF_FL_SHIFT   (MEMMGR_TLSF_SL_LOG2 + MEMMGR_TLSF_ALIGN_LOG2)
+#define MEMMGR_TLSF_SMALL_SIZE (1UL << MEMMGR_TLSF_FL_SHIFT)
+
+// Blocks below 256KB, more than SRAM1 and SRAM2 together
+#define MEMMGR_TLSF_FL_MAX   18
+#define MEMMGR_TLSF_FL_COUNT (MEMMGR_TLSF_FL_MAX - MEMMGR_TLSF_FL_SHIFT + 1)
+
+#define MEMMGR_TLSF_BLOCK_FREE ((size_t)1)
+#define MEMMGR_TLSF_SIZE_MASK  (~(size_t)portBYTE_ALIGNMENT_MASK)
+
+_Static_assert(portBYTE_ALIGNMENT == (1 << MEMMGR_TLSF_ALIGN_LOG2), "Unsupported alignment");
+
+typedef struct MemmgrTlsfBlock {
+    struct MemmgrTlsfBlock* prev_phys; // Block right before this one, NULL for the first
+    size_t size; // Including the header, MEMMGR_TLSF_BLOCK_FREE set while free
+    // Free blocks only, overlap the user data of allocated blocks
+    struct MemmgrTlsfBlock* next_free;
+    struct MemmgrTlsfBlock* prev_free;
+} MemmgrTlsfBlock;
+
+#define MEMMGR_TLSF_HEADER_SIZE    (offsetof(MemmgrTlsfBlock, next_free))
+#define MEMMGR_TLSF_MIN_BLOCK_SIZE (sizeof(MemmgrTlsfBlock))
+
+// Allocated blocks keep the heap trace owner above the size
+#define MEMMGR_TLSF_BLOCK_SIZE(block) \
+    ((block)->size & MEMMGR_TLSF_SIZE_MASK & ~MEMMGR_HEAP_OWNER_MASK)
+#define MEMMGR_TLSF_BLOCK_IS_FREE(block) (((block)->size & MEMMGR_TLSF_BLOCK_FREE) != 0)
+#define MEMMGR_TLSF_BLOCK_NEXT(block) \
+    ((MemmgrTlsfBlock*)((uint8_t*)(block) + MEMMGR_TLSF_BLOCK_SIZE(block)))
+
+#if(configENABLE_HEAP_PROTECTOR == 1)
+
+extern void vApplicationGetRandomHeapCanary(portPOINTER_SIZE_TYPE* pxHeapCanary);
+
+/* Pointers stored in blocks are XORed with the canary like in heap_4, an
+ * overflow into a header turns them into garbage caught by the bounds check. */
+static portPOINTER_SIZE_TYPE memmgr_tlsf_canary;
+
+#define MEMMGR_TLSF_PROTECT(block) \
+    ((MemmgrTlsfBlock*)(((portPOINTER_SIZE_TYPE)(block)) ^ memmgr_tlsf_canary))
+#else
+
+#define MEMMGR_TLSF_PROTECT(block) (block)
+
+#endif /* configENABLE_HEAP_PROTECTOR */
+
+#define MEMMGR_TLSF_VALIDATE(block)                           \
+    configASSERT(                                             \
+        ((uint8_t*)(block) >= (uint8_t*)memmgr_tlsf.first) && \
+        ((uint8_t*)(block) <= (uint8_t*)memmgr_tlsf.sentinel))
+
+typedef struct {
+    uint32_t fl_bitmap;
+    uint32_t sl_bitmap[MEMMGR_TLSF_FL_COUNT];
+    MemmgrTlsfBlock* lists[MEMMGR_TLSF_FL_COUNT][MEMMGR_TLSF_SL_COUNT];
+    MemmgrTlsfBlock* first;
+    MemmgrTlsfBlock* sentinel; // Zero sized allocated block at the end, NULL before init
+    size_t free_bytes;
+    size_t min_free_bytes;
+    size_t allocations;
+    size_t frees;
+} MemmgrTlsf;
+
+static MemmgrTlsf memmgr_tlsf = {0};
+
+static inline void memmgr_tlsf_mapping(size_t size, uint32_t* fl, uint32_t* sl) {
+    if(size < MEMMGR_TLSF_SMALL_SIZE) {
+        *fl = 0;
+        *sl = size >> MEMMGR_TLSF_ALIGN_LOG2;
+    } else {
+        const uint32_t msb = 31 - __builtin_clz(size);
+        *fl = msb - (MEMMGR_TLSF_FL_SHIFT - 1);
+        *sl = (size >> (msb - MEMMGR_TLSF_SL_LOG2)) ^ MEMMGR_TLSF_SL_COUNT;
+    }
+}
+
+static void memmgr_tlsf_insert(MemmgrTlsfBlock* block) {
+    uint32_t fl, sl;
+    memmgr_tlsf_mapping(MEMMGR_TLSF_BLOCK_SIZE(block), &fl, &sl);
+
+    MemmgrTlsfBlock* head = memmgr_tlsf.lists[fl][sl];
+    block->next_free = MEMMGR_TLSF_PROTECT(head);
+    block->prev_free = MEMMGR_TLSF_PROTECT(NULL);
+    if(head) head->prev_free = MEMMGR_TLSF_PROTECT(block);
+
+    memmgr_tlsf.lists[fl][sl] = block;
+    memmgr_tlsf.fl_bitmap |= 1UL << fl;
+    memmgr_tlsf.sl_bitmap[fl] |= 1UL << sl;
+}
+
+static void memmgr_tlsf_remove(MemmgrTlsfBlock* block) {
+    uint32_t fl, sl;
+    memmgr_tlsf_mapping(MEMMGR_TLSF_BLOCK_SIZE(block), &fl, &sl);
+
+    MemmgrTlsfBlock* next = MEMMGR_TLSF_PROTECT(block->next_free);
+    MemmgrTlsfBlock* prev = MEMMGR_TLSF_PROTECT(block->prev_free);
+
+    if(next) {
+        MEMMGR_TLSF_VALIDATE(next);
+        next->prev_free = MEMMGR_TLSF_PROTECT(prev);
+    }
+
+    if(prev) {
+        MEMMGR_TLSF_VALIDATE(prev);
+        prev->next_free = MEMMGR_TLSF_PROTECT(next);
+    } else {
+        memmgr_tlsf.lists[fl][sl] = next;
+        if(!next) {
+            memmgr_tlsf.sl_bitmap[fl] &= ~(1UL << sl);
+            if(!memmgr_tlsf.sl_bitmap[fl]) memmgr_tlsf.fl_bitmap &= ~(1UL << fl);
+        }
+    }
+}
+
+static MemmgrTlsfBlock* memmgr_tlsf_find(size_t size) {
+    uint32_t fl, sl;
+
+    // Round up to the next class, so any block from there on fits
+    size_t search = size;
+    if(search >= MEMMGR_TLSF_SMALL_SIZE) {
+        search += (1UL << (31 - __builtin_clz(search) - MEMMGR_TLSF_SL_LOG2)) - 1;
+    }
+    memmgr_tlsf_mapping(search, &fl, &sl);
+
+    if(fl < MEMMGR_TLSF_FL_COUNT) {
+        uint32_t sl_map = memmgr_tlsf.sl_bitmap[fl] & (~0UL << sl);
+        if(!sl_map) {
+            const uint32_t fl_map = memmgr_tlsf.fl_bitmap & (~0UL << (fl + 1));
+            if(fl_map) {
+                fl = __builtin_ctz(fl_map);
+                sl_map = memmgr_tlsf.sl_bitmap[fl];
+            }
+        }
+        if(sl_map) return memmgr_tlsf.lists[fl][__builtin_ctz(sl_map)];
+    }
+
+    // Nothing in the larger classes, a block in the class of the size itself may still fit.
+    // Keeps requests close to memmgr_heap_get_max_free_block working like with heap_4.
+    memmgr_tlsf_mapping(size, &fl, &sl);
+    if(fl >= MEMMGR_TLSF_FL_COUNT) return NULL;
+
+    for(MemmgrTlsfBlock* block = memmgr_tlsf.lists[fl][sl]; block;
+        block = MEMMGR_TLSF_PROTECT(block->next_free)) {
+        MEMMGR_TLSF_VALIDATE(block);
+        if(MEMMGR_TLSF_BLOCK_SIZE(block) >= size) return block;
+    }
+
+    return NULL;
+}
+
+static void memmgr_tlsf_split(MemmgrTlsfBlock* block, size_t size) {
+    const size_t block_size = MEMMGR_TLSF_BLOCK_SIZE(block);
+
+    if(block_size - size >= MEMMGR_TLSF_MIN_BLOCK_SIZE) {
+        MemmgrTlsfBlock* rest = (MemmgrTlsfBlock*)((uint8_t*)block + size);
+        rest->prev_phys = MEMMGR_TLSF_PROTECT(block);
+        rest->size = (block_size - size) | MEMMGR_TLSF_BLOCK_FREE;
+        MEMMGR_TLSF_BLOCK_NEXT(rest)->prev_phys = MEMMGR_TLSF_PROTECT(rest);
+        memmgr_tlsf_insert(rest);
+        block->size = size;
+    } else {
+        block->size = block_size;
+    }
+}
+
+static MemmgrTlsfBlock* memmgr_tlsf_merge(MemmgrTlsfBlock* block) {
+    MemmgrTlsfBlock* prev = MEMMGR_TLSF_PROTECT(block->prev_phys);
+    if(prev) {
+        MEMMGR_TLSF_VALIDATE(prev);
+        if(MEMMGR_TLSF_BLOCK_IS_FREE(prev)) {
+            memmgr_tlsf_remove(prev);
+            prev->size += MEMMGR_TLSF_BLOCK_SIZE(block);
+            block = prev;
+        }
+    }
+
+    MemmgrTlsfBlock* next = MEMMGR_TLSF_BLOCK_NEXT(block);
+    MEMMGR_TLSF_VALIDATE(next);
+    if(MEMMGR_TLSF_BLOCK_IS_FREE(next)) {
+        memmgr_tlsf_remove(next);
+        block->size += MEMMGR_TLSF_BLOCK_SIZE(next);
+    }
+
+    block->size |= MEMMGR_TLSF_BLOCK_FREE;
+    MEMMGR_TLSF_BLOCK_NEXT(block)->prev_phys = MEMMGR_TLSF_PROTECT(block);
+
+    return block;
+}
+
+static void memmgr_tlsf_init(void) {
+    const size_t start =
+        ((size_t)&__heap_start__ + portBYTE_ALIGNMENT_MASK) & MEMMGR_TLSF_SIZE_MASK;
+    const size_t end = ((size_t)&__heap_start__ + configTOTAL_HEAP_SIZE - MEMMGR_TLSF_HEADER_SIZE) &
+                       MEMMGR_TLSF_SIZE_MASK;
+    furi_check(end - start < (1UL << MEMMGR_TLSF_FL_MAX), "heap too large for TLSF");
+
+#if(configENABLE_HEAP_PROTECTOR == 1)
+    vApplicationGetRandomHeapCanary(&memmgr_tlsf_canary);
+#endif
+
+    memmgr_tlsf.first = (MemmgrTlsfBlock*)start;
+    memmgr_tlsf.first->prev_phys = MEMMGR_TLSF_PROTECT(NULL);
+    memmgr_tlsf.first->size = (end - start) | MEMMGR_TLSF_BLOCK_FREE;
+
+    memmgr_tlsf.sentinel = (MemmgrTlsfBlock*)end;
+    memmgr_tlsf.sentinel->prev_phys = MEMMGR_TLSF_PROTECT(memmgr_tlsf.first);
+    memmgr_tlsf.sentinel->size = 0;
+
+    memmgr_tlsf_insert(memmgr_tlsf.first);
+    memmgr_tlsf.free_bytes = end - start;
+    memmgr_tlsf.min_free_bytes = memmgr_tlsf.free_bytes;
+}
+
+/* Furi heap extension */
+size_t memmgr_heap_get_max_free_block(void) {
+    size_t max_size = 0;
+
+    vTaskSuspendAll();
+    {
+        // Only the highest non-empty class can hold the largest block
+        if(memmgr_tlsf.fl_bitmap) {
+            const uint32_t fl = 31 - __builtin_clz(memmgr_tlsf.fl_bitmap);
+            const uint32_t sl = 31 - __builtin_clz(memmgr_tlsf.sl_bitmap[fl]);
+            for(MemmgrTlsfBlock* block = memmgr_tlsf.lists[fl][sl]; block;
+                block = MEMMGR_TLSF_PROTECT(block->next_free)) {
+                max_size = MAX(max_size, MEMMGR_TLSF_BLOCK_SIZE(block));
+            }
+        }
+    }
+    (void)xTaskResumeAll();
+
+    return max_size;
+}
+
+void memmgr_heap_printf_free_blocks(void) {
+    //can be enabled once we can do printf with a locked scheduler
+    //vTaskSuspendAll();
+
+    MemmgrTlsfBlock* block = memmgr_tlsf.first;
+    while(block && block != memmgr_tlsf.sentinel) {
+        if(MEMMGR_TLSF_BLOCK_IS_FREE(block)) {
+            printf("A %p S %lu\r\n", (void*)block, (uint32_t)MEMMGR_TLSF_BLOCK_SIZE(block));
+        }
+        block = MEMMGR_TLSF_BLOCK_NEXT(block);
+    }
+
+    //xTaskResumeAll();
+}
+
+void memmgr_heap_walk(MemmgrHeapBlockCallback callback, void* context) {
+    MemmgrTlsfBlock* block = memmgr_tlsf.first;
+    while(block && block != memmgr_tlsf.sentinel) {
+        const bool allocated = !MEMMGR_TLSF_BLOCK_IS_FREE(block);
+        const uint8_t owner =
+            allocated ? (block->size & MEMMGR_HEAP_OWNER_MASK) >> MEMMGR_HEAP_OWNER_SHIFT : 0;
+        callback(MEMMGR_TLSF_BLOCK_SIZE(block), allocated, owner, context);
+        block = MEMMGR_TLSF_BLOCK_NEXT(block);
+    }
+}
+
+void* pvPortMalloc(size_t xWantedSize) {
+    void* pvReturn = NULL;
+    size_t xToWipe = xWantedSize;
+    size_t size = 0;
+
+    if(FURI_IS_IRQ_MODE()) {
+        furi_crash("memmgt in ISR");
+    }
+
+    const uint8_t owner = memmgr_heap_trace_get_owner();
+
+    /* Small requests go to the size class slabs first */
+    void* pvSlab = memmgr_heap_slab_alloc(xWantedSize, owner);
+    if(pvSlab != NULL) {
+        return memset(pvSlab, 0, xWantedSize);
+    }
+
+    // Sizes that can't be a block stay 0 and fail below
+    if(xWantedSize > 0 && xWantedSize < (1UL << MEMMGR_TLSF_FL_MAX)) {
+        size = (xWantedSize + MEMMGR_TLSF_HEADER_SIZE + portBYTE_ALIGNMENT_MASK) &
+               MEMMGR_TLSF_SIZE_MASK;
+        size = MAX(size, MEMMGR_TLSF_MIN_BLOCK_SIZE);
+    }
+
+    vTaskSuspendAll();
+    {
+        if(memmgr_tlsf.sentinel == NULL) {
+            memmgr_tlsf_init();
+        }
+
+        MemmgrTlsfBlock* block = NULL;
+        if(size > 0 && size <= memmgr_tlsf.free_bytes) block = memmgr_tlsf_find(size);
+
+        if(block) {
+            MEMMGR_TLSF_VALIDATE(block);
+            memmgr_tlsf_remove(block);
+            memmgr_tlsf_split(block, size);
+
+            memmgr_tlsf.free_bytes -= block->size;
+            if(memmgr_tlsf.free_bytes < memmgr_tlsf.min_free_bytes) {
+                memmgr_tlsf.min_free_bytes = memmgr_tlsf.free_bytes;
+            }
+            memmgr_tlsf.allocations++;
+
+            memmgr_heap_trace_malloc(owner, block->size);
+            block->size |= (size_t)owner << MEMMGR_HEAP_OWNER_SHIFT;
+
+            pvReturn = (uint8_t*)block + MEMMGR_TLSF_HEADER_SIZE;
+        }
+    }
+    (void)xTaskResumeAll();
+
+#if(configUSE_MALLOC_FAILED_HOOK == 1)
+    if(pvReturn == NULL) {
+        vApplicationMallocFailedHook();
+    }
+#endif
+
+    furi_check(pvReturn, xWantedSize ? "out of memory" : "malloc(0)");
+    pvReturn = memset(pvReturn, 0, xToWipe);
+    return pvReturn;
+}
+
+void vPortFree(void* pv) {
+    if(FURI_IS_IRQ_MODE()) {
+        furi_crash("memmgt in ISR");
+    }
+
+    if(memmgr_heap_slab_free(pv)) {
+        return;
+    }
+
+    if(pv == NULL) return;
+
+    MemmgrTlsfBlock* block = (MemmgrTlsfBlock*)((uint8_t*)pv - MEMMGR_TLSF_HEADER_SIZE);
+    MEMMGR_TLSF_VALIDATE(block);
+    configASSERT(!MEMMGR_TLSF_BLOCK_IS_FREE(block));
+
+    // Double free, ignored like heap_4 does in release builds
+    if(MEMMGR_TLSF_BLOCK_IS_FREE(block)) return;
+
+    const uint8_t owner = (block->size & MEMMGR_HEAP_OWNER_MASK) >> MEMMGR_HEAP_OWNER_SHIFT;
+    block->size &= ~MEMMGR_HEAP_OWNER_MASK;
+
+#if(configHEAP_CLEAR_MEMORY_ON_FREE == 1)
+    if(MEMMGR_TLSF_BLOCK_SIZE(block) > MEMMGR_TLSF_HEADER_SIZE) {
+        memset(pv, 0, MEMMGR_TLSF_BLOCK_SIZE(block) - MEMMGR_TLSF_HEADER_SIZE);
+    }
+#endif
+
+    vTaskSuspendAll();
+    {
+        furi_assert((size_t)pv >= SRAM_BASE);
+        furi_assert((size_t)pv < SRAM_BASE + 1024 * 256);
+        furi_assert(block->size >= MEMMGR_TLSF_MIN_BLOCK_SIZE);
+        furi_assert((block->size - MEMMGR_TLSF_HEADER_SIZE) < 1024 * 256);
+
+        memmgr_tlsf.free_bytes += block->size;
+        memmgr_heap_trace_free(owner, block->size);
+        memmgr_tlsf_insert(memmgr_tlsf_merge(block));
+        memmgr_tlsf.frees++;
+    }
+    (void)xTaskResumeAll();
+}
+
+size_t xPortGetFreeHeapSize(void) {
+    return memmgr_tlsf.free_bytes;
+}
+
+size_t xPortGetMinimumEverFreeHeapSize(void) {
+    return memmgr_tlsf.min_free_bytes;
+}
+
+void xPortResetHeapMinimumEverFreeHeapSize(void) {
+    memmgr_tlsf.min_free_bytes = memmgr_tlsf.free_bytes;
+}
+
+void vPortInitialiseBlocks(void) {
+    /* This just exists to keep the linker quiet. */
+}
+
+void* pvPortCalloc(size_t xNum, size_t xSize) {
+    void* pv = NULL;
+
+    if(xNum == 0 || xSize <= SIZE_MAX / xNum) {
+        pv = pvPortMalloc(xNum * xSize);
+    }
+
+    return pv;
+}
+
+void vPortGetHeapStats(HeapStats_t* pxHeapStats) {
+    size_t blocks = 0;
+    size_t max_size = 0;
+    size_t min_size = portMAX_DELAY;
+
+    vTaskSuspendAll();
+    {
+        uint32_t fl_map = memmgr_tlsf.fl_bitmap;
+        while(fl_map) {
+            const uint32_t fl = __builtin_ctz(fl_map);
+            fl_map &= fl_map - 1;
+
+            uint32_t sl_map = memmgr_tlsf.sl_bitmap[fl];
+            while(sl_map) {
+                const uint32_t sl = __builtin_ctz(sl_map);
+                sl_map &= sl_map - 1;
+
+                for(MemmgrTlsfBlock* block = memmgr_tlsf.lists[fl][sl]; block;
+                    block = MEMMGR_TLSF_PROTECT(block->next_free)) {
+                    const size_t block_size = MEMMGR_TLSF_BLOCK_SIZE(block);
+                    blocks++;
+                    max_size = MAX(max_size, block_size);
+                    min_size = MIN(min_size, block_size);
+                }
+            }
+        }
+    }
+    (void)xTaskResumeAll();
+
+    pxHeapStats->xSizeOfLargestFreeBlockInBytes = max_size;
+    pxHeapStats->xSizeOfSmallestFreeBlockInBytes = min_size;
+    pxHeapStats->xNumberOfFreeBlocks = blocks;
+
+    taskENTER_CRITICAL();
+    {
+        pxHeapStats->xAvailableHeapSpaceInBytes = memmgr_tlsf.free_bytes;
+        pxHeapStats->xNumberOfSuccessfulAllocations = memmgr_tlsf.allocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = memmgr_tlsf.frees;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = memmgr_tlsf.min_free_bytes;
+    }
+    taskEXIT_CRITICAL();
+}
+
+/*
+ * Reset the state in this file. This state is normally initialized at start up.
+ * This function must be called by the application before restarting the
+ * scheduler.
+ */
+void vPortHeapResetState(void) {
+    memset(&memmgr_tlsf, 0, sizeof(memmgr_tlsf));
+}
+
+#endif /* FURI_HEAP_TLSF */
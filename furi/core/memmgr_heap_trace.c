@@ -0,0 +1,119 @@
+/*
+ * Per-thread heap accounting.
+ *
+ * A traced thread gets an owner slot with a byte counter, the slot number is
+ * kept in a thread local storage pointer of the task. Allocations store the
+ * owner in their block and add to its counter, frees subtract from the owner
+ * stored in the block, whichever thread frees it. Both are a few instructions
+ * and never allocate, reading the memory of a thread is a counter read.
+ *
+ * A slot whose thread stops tracing with memory still allocated is kept until
+ * its blocks are freed, so a new thread never inherits them. Once every slot
+ * is busy, newly traced threads stay untraced and it is logged.
+ */
+
+#include "memmgr_heap_i.h"
+#include "check.h"
+#include "log.h"
+#include <core/common_defines.h>
+
+#include <FreeRTOS.h>
+#include <task.h>
+
+#define TAG "MemmgrHeapTrace"
+
+#define MEMMGR_HEAP_TRACE_TLS_INDEX 1
+
+typedef struct {
+    FuriThreadId thread_id; // NULL once tracing is disabled
+    size_t size;
+    bool busy;
+} MemmgrHeapOwner;
+
+static MemmgrHeapOwner memmgr_heap_owners[MEMMGR_HEAP_OWNER_COUNT] = {0};
+
+static inline uint8_t memmgr_heap_trace_get_thread_owner(FuriThreadId thread_id) {
+    return (uint32_t)pvTaskGetThreadLocalStoragePointer(
+        (TaskHandle_t)thread_id, MEMMGR_HEAP_TRACE_TLS_INDEX);
+}
+
+bool memmgr_heap_enable_thread_trace(FuriThreadId thread_id) {
+    furi_check(thread_id);
+    bool traced = false;
+
+    vTaskSuspendAll();
+    {
+        furi_check(memmgr_heap_trace_get_thread_owner(thread_id) == 0);
+        for(size_t owner = 1; owner < MEMMGR_HEAP_OWNER_COUNT; owner++) {
+            if(!memmgr_heap_owners[owner].busy) {
+                memmgr_heap_owners[owner].thread_id = thread_id;
+                memmgr_heap_owners[owner].size = 0;
+                memmgr_heap_owners[owner].busy = true;
+                vTaskSetThreadLocalStoragePointer(
+                    (TaskHandle_t)thread_id, MEMMGR_HEAP_TRACE_TLS_INDEX, (void*)owner);
+                traced = true;
+                break;
+            }
+        }
+    }
+    (void)xTaskResumeAll();
+
+    // Out of slots the thread reports unknown memory
+    if(!traced) {
+        FURI_LOG_W(
+            TAG, "Out of trace slots, %s untraced", pcTaskGetName((TaskHandle_t)thread_id));
+    }
+
+    return traced;
+}
+
+void memmgr_heap_disable_thread_trace(FuriThreadId thread_id) {
+    furi_check(thread_id);
+
+    vTaskSuspendAll();
+    {
+        const uint8_t owner = memmgr_heap_trace_get_thread_owner(thread_id);
+        if(owner) {
+            memmgr_heap_owners[owner].thread_id = NULL;
+            if(!memmgr_heap_owners[owner].size) memmgr_heap_owners[owner].busy = false;
+            vTaskSetThreadLocalStoragePointer(
+                (TaskHandle_t)thread_id, MEMMGR_HEAP_TRACE_TLS_INDEX, NULL);
+        }
+    }
+    (void)xTaskResumeAll();
+}
+
+size_t memmgr_heap_get_thread_memory(FuriThreadId thread_id) {
+    const uint8_t owner = memmgr_heap_trace_get_thread_owner(thread_id);
+    return owner ? memmgr_heap_owners[owner].size : MEMMGR_HEAP_UNKNOWN;
+}
+
+uint8_t memmgr_heap_trace_get_owner(void) {
+    // No task runs before the scheduler creates the first one
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+    return task ? memmgr_heap_trace_get_thread_owner(task) : 0;
+}
+
+void memmgr_heap_trace_malloc(uint8_t owner, size_t size) {
+    if(owner) memmgr_heap_owners[owner].size += size;
+}
+
+void memmgr_heap_trace_free(uint8_t owner, size_t size) {
+    if(!owner) return;
+
+    MemmgrHeapOwner* heap_owner = &memmgr_heap_owners[owner];
+    furi_assert(heap_owner->busy && heap_owner->size >= size);
+    heap_owner->size -= size;
+    // Last block of a thread that stopped tracing frees its slot
+    if(!heap_owner->size && !heap_owner->thread_id) heap_owner->busy = false;
+}
+
+FuriThreadId memmgr_heap_trace_get_owner_thread(uint8_t owner) {
+    furi_check(owner < MEMMGR_HEAP_OWNER_COUNT);
+    return memmgr_heap_owners[owner].thread_id;
+}
+
+size_t memmgr_heap_trace_get_owner_size(uint8_t owner) {
+    furi_check(owner < MEMMGR_HEAP_OWNER_COUNT);
+    return memmgr_heap_owners[owner].size;
+}
@@ -0,0 +1,251 @@
+#include "message_pool.h"
+
+#include <FreeRTOS.h>
+#include <queue.h>
+
+#include "kernel.h"
+#include "check.h"
+#include "common_defines.h"
+
+#include "event_loop_link_i.h"
+
+typedef enum {
+    FuriMessagePoolSlotFree,
+    FuriMessagePoolSlotAcquired,
+    FuriMessagePoolSlotQueued,
+} FuriMessagePoolSlot;
+
+struct FuriMessagePool {
+    StaticQueue_t free_container; // Indices of free slots
+    StaticQueue_t queue_container; // Indices of put slots, in order
+    FuriEventLoopLink event_loop_link;
+    uint32_t msg_count;
+    uint32_t msg_size;
+    uint32_t slot_size;
+    uint8_t* states; // FuriMessagePoolSlot of every slot
+    uint8_t slots[] __attribute__((aligned(portBYTE_ALIGNMENT)));
+};
+
+// IMPORTANT: slots MUST be the LAST struct member
+static_assert(offsetof(FuriMessagePool, slots) == sizeof(FuriMessagePool));
+
+FuriMessagePool* furi_message_pool_alloc(uint32_t msg_count, uint32_t msg_size) {
+    furi_check((furi_kernel_is_irq_or_masked() == 0U) && (msg_count > 0U) && (msg_size > 0U));
+    furi_check(msg_count <= UINT16_MAX);
+
+    // Slots stay aligned for any message type
+    const uint32_t slot_size = (msg_size + portBYTE_ALIGNMENT_MASK) & ~portBYTE_ALIGNMENT_MASK;
+    const size_t slots_size = msg_count * slot_size;
+    const size_t index_size = msg_count * sizeof(uint16_t);
+
+    // Slots, then both index buffers and the slot states
+    FuriMessagePool* instance =
+        malloc(sizeof(FuriMessagePool) + slots_size + index_size * 2 + msg_count);
+
+    uint8_t* free_buffer = instance->slots + slots_size;
+    uint8_t* queue_buffer = free_buffer + index_size;
+    instance->states = queue_buffer + index_size;
+    instance->msg_count = msg_count;
+    instance->msg_size = msg_size;
+    instance->slot_size = slot_size;
+
+    QueueHandle_t free_queue =
+        xQueueCreateStatic(msg_count, sizeof(uint16_t), free_buffer, &instance->free_container);
+    furi_check(free_queue == (void*)&instance->free_container);
+    furi_check(
+        xQueueCreateStatic(
+            msg_count, sizeof(uint16_t), queue_buffer, &instance->queue_container) ==
+        (void*)&instance->queue_container);
+
+    for(uint16_t index = 0; index < msg_count; index++) {
+        furi_check(xQueueSendToBack(free_queue, &index, 0) == pdPASS);
+    }
+
+    return instance;
+}
+
+void furi_message_pool_free(FuriMessagePool* instance) {
+    furi_check(furi_kernel_is_irq_or_masked() == 0U);
+    furi_check(instance);
+
+    // Event Loop must be disconnected
+    furi_check(!instance->event_loop_link.item_in);
+    furi_check(!instance->event_loop_link.item_out);
+
+    // Slots must be back in the pool
+    furi_check(
+        uxQueueMessagesWaiting((QueueHandle_t)&instance->free_container) == instance->msg_count);
+
+    vQueueDelete((QueueHandle_t)&instance->free_container);
+    vQueueDelete((QueueHandle_t)&instance->queue_container);
+    free(instance);
+}
+
+static uint16_t furi_message_pool_get_index(FuriMessagePool* instance, const void* msg) {
+    const size_t offset = (const uint8_t*)msg - instance->slots;
+    furi_check(
+        (const uint8_t*)msg >= instance->slots &&
+            offset < instance->msg_count * instance->slot_size &&
+            offset % instance->slot_size == 0,
+        "Message is not from this pool");
+
+    return offset / instance->slot_size;
+}
+
+// Same rules as furi_message_queue_get(), for slot indices
+static FuriStatus
+    furi_message_pool_receive(QueueHandle_t queue, uint16_t* index, uint32_t timeout) {
+    FuriStatus stat = FuriStatusOk;
+
+    if(furi_kernel_is_irq_or_masked() != 0U) {
+        if(timeout != 0U) {
+            stat = FuriStatusErrorParameter;
+        } else {
+            BaseType_t yield = pdFALSE;
+
+            if(xQueueReceiveFromISR(queue, index, &yield) != pdPASS) {
+                stat = FuriStatusErrorResource;
+            } else {
+                portYIELD_FROM_ISR(yield);
+            }
+        }
+    } else {
+        if(xQueueReceive(queue, index, (TickType_t)timeout) != pdPASS) {
+            if(timeout != 0U) {
+                stat = FuriStatusErrorTimeout;
+            } else {
+                stat = FuriStatusErrorResource;
+            }
+        }
+    }
+
+    return stat;
+}
+
+// Both queues have room for every slot, so sending never waits
+static void furi_message_pool_send(QueueHandle_t queue, uint16_t index) {
+    if(furi_kernel_is_irq_or_masked() != 0U) {
+        BaseType_t yield = pdFALSE;
+        furi_check(xQueueSendToBackFromISR(queue, &index, &yield) == pdTRUE);
+        portYIELD_FROM_ISR(yield);
+    } else {
+        furi_check(xQueueSendToBack(queue, &index, 0) == pdPASS);
+    }
+}
+
+FuriStatus furi_message_pool_acquire(FuriMessagePool* instance, void** msg_ptr, uint32_t timeout) {
+    furi_check(instance);
+    furi_check(msg_ptr);
+
+    uint16_t index;
+    FuriStatus stat =
+        furi_message_pool_receive((QueueHandle_t)&instance->free_container, &index, timeout);
+
+    if(stat == FuriStatusOk) {
+        furi_check(instance->states[index] == FuriMessagePoolSlotFree);
+        instance->states[index] = FuriMessagePoolSlotAcquired;
+        *msg_ptr = &instance->slots[index * instance->slot_size];
+    }
+
+    return stat;
+}
+
+void furi_message_pool_put(FuriMessagePool* instance, void* msg) {
+    furi_check(instance);
+
+    const uint16_t index = furi_message_pool_get_index(instance, msg);
+    furi_check(instance->states[index] == FuriMessagePoolSlotAcquired, "Message not acquired");
+    instance->states[index] = FuriMessagePoolSlotQueued;
+
+    furi_message_pool_send((QueueHandle_t)&instance->queue_container, index);
+    furi_event_loop_link_notify(&instance->event_loop_link, FuriEventLoopEventIn);
+}
+
+FuriStatus furi_message_pool_get(FuriMessagePool* instance, void** msg_ptr, uint32_t timeout) {
+    furi_check(instance);
+    furi_check(msg_ptr);
+
+    uint16_t index;
+    FuriStatus stat =
+        furi_message_pool_receive((QueueHandle_t)&instance->queue_container, &index, timeout);
+
+    if(stat == FuriStatusOk) {
+        furi_check(instance->states[index] == FuriMessagePoolSlotQueued);
+        instance->states[index] = FuriMessagePoolSlotAcquired;
+        *msg_ptr = &instance->slots[index * instance->slot_size];
+    }
+
+    return stat;
+}
+
+void furi_message_pool_release(FuriMessagePool* instance, void* msg) {
+    furi_check(instance);
+
+    const uint16_t index = furi_message_pool_get_index(instance, msg);
+    furi_check(instance->states[index] == FuriMessagePoolSlotAcquired, "Message not acquired");
+    instance->states[index] = FuriMessagePoolSlotFree;
+
+    furi_message_pool_send((QueueHandle_t)&instance->free_container, index);
+    furi_event_loop_link_notify(&instance->event_loop_link, FuriEventLoopEventOut);
+}
+
+uint32_t furi_message_pool_get_capacity(FuriMessagePool* instance) {
+    furi_check(instance);
+
+    return instance->msg_count;
+}
+
+uint32_t furi_message_pool_get_message_size(FuriMessagePool* instance) {
+    furi_check(instance);
+
+    return instance->msg_size;
+}
+
+static uint32_t furi_message_pool_get_waiting(QueueHandle_t queue) {
+    UBaseType_t count;
+
+    if(furi_kernel_is_irq_or_masked() != 0U) {
+        count = uxQueueMessagesWaitingFromISR(queue);
+    } else {
+        count = uxQueueMessagesWaiting(queue);
+    }
+
+    return (uint32_t)count;
+}
+
+uint32_t furi_message_pool_get_count(FuriMessagePool* instance) {
+    furi_check(instance);
+
+    return furi_message_pool_get_waiting((QueueHandle_t)&instance->queue_container);
+}
+
+uint32_t furi_message_pool_get_space(FuriMessagePool* instance) {
+    furi_check(instance);
+
+    return furi_message_pool_get_waiting((QueueHandle_t)&instance->free_container);
+}
+
+static FuriEventLoopLink* furi_message_pool_event_loop_get_link(FuriEventLoopObject* object) {
+    FuriMessagePool* instance = object;
+    furi_assert(instance);
+    return &instance->event_loop_link;
+}
+
+static bool
+    furi_message_pool_event_loop_get_level(FuriEventLoopObject* object, FuriEventLoopEvent event) {
+    FuriMessagePool* instance = object;
+    furi_assert(instance);
+
+    if(event == FuriEventLoopEventIn) {
+        return furi_message_pool_get_count(instance);
+    } else if(event == FuriEventLoopEventOut) {
+        return furi_message_pool_get_space(instance);
+    } else {
+        furi_crash();
+    }
+}
+
+const FuriEventLoopContract furi_message_pool_event_loop_contract = {
+    .get_link = furi_message_pool_event_loop_get_link,
+    .get_level = furi_message_pool_event_loop_get_level,
+};
@@ -0,0 +1,115 @@
+/**
+ * @file message_pool.h
+ * FuriMessagePool
+ *
+ * Fixed number of fixed size message slots with a queue passing them between
+ * threads. A producer acquires a free slot, fills it in place and puts it into
+ * the queue, the consumer gets the slot and releases it back to the pool when
+ * done. Only slot indices move through the queue, messages are never copied
+ * and no memory is allocated after furi_message_pool_alloc().
+ *
+ * A slot belongs to one side at a time: using a slot after putting or
+ * releasing it is an error.
+ */
+#pragma once
+
+#include "base.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct FuriMessagePool FuriMessagePool;
+
+/** Allocate furi message pool
+ *
+ * @param[in]  msg_count  The message slot count, up to 65535
+ * @param[in]  msg_size   The message size
+ *
+ * @return     pointer to FuriMessagePool instance
+ */
+FuriMessagePool* furi_message_pool_alloc(uint32_t msg_count, uint32_t msg_size);
+
+/** Free pool
+ *
+ * @warning all slots must be released
+ *
+ * @param      instance  pointer to FuriMessagePool instance
+ */
+void furi_message_pool_free(FuriMessagePool* instance);
+
+/** Take a free slot from the pool
+ *
+ * The slot contents are left from its previous message.
+ *
+ * @param      instance  pointer to FuriMessagePool instance
+ * @param[out] msg_ptr   pointer to the slot pointer to fill in
+ * @param[in]  timeout   The timeout to wait for a free slot
+ *
+ * @return     The furi status.
+ */
+FuriStatus furi_message_pool_acquire(FuriMessagePool* instance, void** msg_ptr, uint32_t timeout);
+
+/** Put an acquired slot into the queue, passing its ownership to the receiver
+ *
+ * Never waits: the queue has room for every slot.
+ *
+ * @param      instance  pointer to FuriMessagePool instance
+ * @param      msg       The slot from furi_message_pool_acquire()
+ */
+void furi_message_pool_put(FuriMessagePool* instance, void* msg);
+
+/** Get the next slot from the queue, taking its ownership
+ *
+ * @param      instance  pointer to FuriMessagePool instance
+ * @param[out] msg_ptr   pointer to the slot pointer to fill in
+ * @param[in]  timeout   The timeout to wait for a message
+ *
+ * @return     The furi status.
+ */
+FuriStatus furi_message_pool_get(FuriMessagePool* instance, void** msg_ptr, uint32_t timeout);
+
+/** Return a slot to the pool
+ *
+ * Both a received slot and an acquired one that was never put can be released.
+ *
+ * @param      instance  pointer to FuriMessagePool instance
+ * @param      msg       The slot to release
+ */
+void furi_message_pool_release(FuriMessagePool* instance, void* msg);
+
+/** Get pool capacity
+ *
+ * @param      instance  pointer to FuriMessagePool instance
+ *
+ * @return     capacity in slot count
+ */
+uint32_t furi_message_pool_get_capacity(FuriMessagePool* instance);
+
+/** Get message size
+ *
+ * @param      instance  pointer to FuriMessagePool instance
+ *
+ * @return     Message size in bytes
+ */
+uint32_t furi_message_pool_get_message_size(FuriMessagePool* instance);
+
+/** Get message count in queue
+ *
+ * @param      instance  pointer to FuriMessagePool instance
+ *
+ * @return     Message count
+ */
+uint32_t furi_message_pool_get_count(FuriMessagePool* instance);
+
+/** Get free slot count
+ *
+ * @param      instance  pointer to FuriMessagePool instance
+ *
+ * @return     Slot count
+ */
+uint32_t furi_message_pool_get_space(FuriMessagePool* instance);
+
+#ifdef __cplusplus
+}
+#endif
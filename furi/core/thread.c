@@ -57,6 +57,7 @@ struct FuriThread {
     char* appid;
 
     FuriThreadPriority priority;
+    uint32_t owner_tag;
 
     size_t stack_size;
     size_t heap_size;
@@ -68,6 +69,7 @@ struct FuriThread {
     // this ensures that the size of this structure is minimal
     bool is_service;
     bool heap_trace_enabled;
+    bool heap_untraced; // Trace enabled, but memmgr had no slot for it
 };
 
 // IMPORTANT: container MUST be the FIRST struct member
@@ -110,7 +112,7 @@ static void furi_thread_body(void* context) {
     furi_thread_set_state(thread, FuriThreadStateRunning);
 
     if(thread->heap_trace_enabled == true) {
-        memmgr_heap_enable_thread_trace((FuriThreadId)thread);
+        thread->heap_untraced = !memmgr_heap_enable_thread_trace((FuriThreadId)thread);
     }
 
     thread->ret = thread->callback(thread->context);
@@ -129,7 +131,7 @@ static void furi_thread_body(void* context) {
             stack_watermark);
     }
 
-    if(thread->heap_trace_enabled == true) {
+    if(thread->heap_trace_enabled == true && !thread->heap_untraced) {
         furi_delay_ms(33);
         thread->heap_size = memmgr_heap_get_thread_memory((FuriThreadId)thread);
         furi_log_print_format(
@@ -168,6 +170,10 @@ static void furi_thread_init_common(FuriThread* thread) {
         } else {
             furi_thread_set_appid(thread, "unknown");
         }
+
+        if(parent) {
+            thread->owner_tag = parent->owner_tag;
+        }
     } else {
         // if scheduler is not started, we are starting driver thread
         furi_thread_set_appid(thread, "driver");
@@ -183,6 +189,11 @@ static void furi_thread_init_common(FuriThread* thread) {
     } else {
         thread->heap_trace_enabled = false;
     }
+
+    // Owned threads are always accounted the same way as their owner
+    if(thread->owner_tag && parent) {
+        thread->heap_trace_enabled = parent->heap_trace_enabled;
+    }
 }
 
 void furi_thread_init(void) {
@@ -292,6 +303,12 @@ void furi_thread_set_appid(FuriThread* thread, const char* appid) {
     thread->appid = appid ? strdup(appid) : NULL;
 }
 
+void furi_thread_set_owner_tag(FuriThread* thread, uint32_t owner_tag) {
+    furi_check(thread);
+    furi_check(thread->state == FuriThreadStateStopped);
+    thread->owner_tag = owner_tag;
+}
+
 void furi_thread_set_stack_size(FuriThread* thread, size_t stack_size) {
     furi_check(thread);
     furi_check(thread->state == FuriThreadStateStopped);
@@ -343,6 +360,22 @@ FuriThreadPriority furi_thread_get_current_priority(void) {
     return (FuriThreadPriority)uxTaskPriorityGet(NULL);
 }
 
+void furi_thread_override_priority(FuriThreadId thread_id, FuriThreadPriority priority) {
+    furi_check(thread_id);
+    furi_check(priority <= FuriThreadPriorityIsr);
+    vTaskPrioritySet((TaskHandle_t)thread_id, priority);
+}
+
+void furi_thread_restore_priority(FuriThreadId thread_id) {
+    furi_check(thread_id);
+
+    TaskHandle_t hTask = (TaskHandle_t)thread_id;
+    FuriThread* thread = (FuriThread*)pvTaskGetThreadLocalStoragePointer(hTask, 0);
+    if(thread) {
+        vTaskPrioritySet(hTask, thread->priority);
+    }
+}
+
 void furi_thread_set_state_callback(FuriThread* thread, FuriThreadStateCallback callback) {
     furi_check(thread);
     furi_check(thread->state == FuriThreadStateStopped);
@@ -395,6 +428,7 @@ void furi_thread_start(FuriThread* thread) {
     furi_check(thread->state == FuriThreadStateStopped);
     furi_check(thread->stack_size > 0);
 
+    thread->heap_untraced = false;
     furi_thread_set_state(thread, FuriThreadStateStarting);
 
     uint32_t stack_depth = thread->stack_size / sizeof(StackType_t);
@@ -667,11 +701,14 @@ bool furi_thread_enumerate(FuriThreadList* thread_list) {
             FuriThreadId thread_id = (FuriThreadId)task[i].xHandle;
             item->thread = (FuriThread*)thread_id;
             item->app_id = furi_thread_get_appid(thread_id);
+            item->owner_tag = furi_thread_get_owner_tag(thread_id);
             item->name = task[i].pcTaskName;
             item->priority = task[i].uxCurrentPriority;
             item->stack_address = (uint32_t)tcb->pxStack;
             size_t thread_heap = memmgr_heap_get_thread_memory(thread_id);
             item->heap = thread_heap == MEMMGR_HEAP_UNKNOWN ? 0u : thread_heap;
+            FuriThread* thread = pvTaskGetThreadLocalStoragePointer(task[i].xHandle, 0);
+            item->heap_untraced = thread && thread->heap_untraced;
             item->stack_size = (tcb->pxEndOfStack - tcb->pxStack + 1) * sizeof(StackType_t);
             item->stack_min_free = furi_thread_get_stack_space(thread_id);
             item->state = furi_thread_state_name(task[i].eCurrentState);
@@ -717,6 +754,20 @@ const char* furi_thread_get_appid(FuriThreadId thread_id) {
     return appid;
 }
 
+uint32_t furi_thread_get_owner_tag(FuriThreadId thread_id) {
+    TaskHandle_t hTask = (TaskHandle_t)thread_id;
+    uint32_t owner_tag = 0;
+
+    if(!FURI_IS_IRQ_MODE() && (hTask != NULL)) {
+        FuriThread* thread = (FuriThread*)pvTaskGetThreadLocalStoragePointer(hTask, 0);
+        if(thread) {
+            owner_tag = thread->owner_tag;
+        }
+    }
+
+    return owner_tag;
+}
+
 uint32_t furi_thread_get_stack_space(FuriThreadId thread_id) {
     TaskHandle_t hTask = (TaskHandle_t)thread_id;
     uint32_t sz;
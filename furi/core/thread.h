@@ -195,6 +195,21 @@ void furi_thread_set_name(FuriThread* thread, const char* name);
  */
 void furi_thread_set_appid(FuriThread* thread, const char* appid);
 
+/**
+ * @brief Set the owner tag of a FuriThread instance.
+ *
+ * The thread MUST be stopped when calling this function.
+ *
+ * Owner tag groups a thread together with every thread it spawns: threads
+ * created by a thread with a non-zero tag inherit both the tag and the heap
+ * trace setting. It is used by the container runtime for per-container
+ * resource accounting.
+ *
+ * @param[in,out] thread pointer to the FuriThread instance to be modified
+ * @param[in] owner_tag owner tag value, 0 means no owner
+ */
+void furi_thread_set_owner_tag(FuriThread* thread, uint32_t owner_tag);
+
 /**
  * @brief Set the stack size of a FuriThread instance.
  *
@@ -244,6 +259,27 @@ void furi_thread_set_priority(FuriThread* thread, FuriThreadPriority priority);
  */
 FuriThreadPriority furi_thread_get_priority(FuriThread* thread);
 
+/**
+ * @brief Temporarily override the priority of a running thread.
+ *
+ * The priority configured with furi_thread_set_priority() is kept and can be
+ * brought back with furi_thread_restore_priority().
+ *
+ * @param[in] thread_id unique identifier of the thread to be modified
+ * @param[in] priority priority level value
+ */
+void furi_thread_override_priority(FuriThreadId thread_id, FuriThreadPriority priority);
+
+/**
+ * @brief Restore the configured priority of a running thread.
+ *
+ * Undoes furi_thread_override_priority(). Does nothing for threads that are
+ * not FuriThreads.
+ *
+ * @param[in] thread_id unique identifier of the thread to be modified
+ */
+void furi_thread_restore_priority(FuriThreadId thread_id);
+
 /**
  * @brief Set the priority of the current FuriThread.
  *
@@ -468,6 +504,14 @@ const char* furi_thread_get_name(FuriThreadId thread_id);
  */
 const char* furi_thread_get_appid(FuriThreadId thread_id);
 
+/**
+ * @brief Get the owner tag of a thread based on its unique identifier.
+ * 
+ * @param[in] thread_id unique identifier of the thread to be queried
+ * @return owner tag value, 0 if thread has no owner or is not a FuriThread
+ */
+uint32_t furi_thread_get_owner_tag(FuriThreadId thread_id);
+
 /**
  * @brief Get thread stack watermark.
  * 
@@ -25,6 +25,9 @@ typedef struct {
     uint32_t counter_previous; /**< Thread previous runtime counter */
     uint32_t counter_current; /**< Thread current runtime counter */
     uint32_t tick; /**< Thread last seen tick */
+
+    uint32_t owner_tag; /**< Thread owner tag, 0 - if thread has no owner */
+    bool heap_untraced; /**< Heap tracking enabled, but no slot was free: heap unknown */
 } FuriThreadListItem;
 
 /** Anonymous FuriThreadList type */
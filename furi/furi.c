@@ -64,10 +64,10 @@ void furi_exit() {
 }
 
 // Global accessor functions for containerization components
-ContainerRuntime* furi_get_container_runtime() {
+ContainerRuntime* furi_get_container_runtime(void) {
     return furi_container_runtime;
 }
 
-ServiceRegistry* furi_get_service_registry() {
+ServiceRegistry* furi_get_service_registry(void) {
     return furi_service_registry;
 }
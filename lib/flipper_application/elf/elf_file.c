@@ -6,6 +6,8 @@
 #include "elf_api_interface.h"
 #include "../api_hashtable/api_hashtable.h"
 
+#include <m-array.h>
+
 #define TAG "Elf"
 
 #define ELF_NAME_BUFFER_LEN        32
@@ -55,6 +57,130 @@ static void address_cache_put(AddressCache_t cache, int symEntry, Elf32_Addr sym
     AddressCache_set_at(cache, symEntry, symAddr);
 }
 
+/**************************************************************************************************/
+/******************************************* Load cache *******************************************/
+/**************************************************************************************************/
+
+#define ELF_LOAD_CACHE_ABSOLUTE     0xFF
+#define ELF_LOAD_CACHE_MAX_SECTIONS ELF_LOAD_CACHE_ABSOLUTE
+
+typedef enum {
+    ELFLoadCacheSectionRoleNone,
+    ELFLoadCacheSectionRolePreinitArray,
+    ELFLoadCacheSectionRoleInitArray,
+    ELFLoadCacheSectionRoleFiniArray,
+} ELFLoadCacheSectionRole;
+
+typedef struct {
+    char* name;
+    void* data; // Only valid while recording
+    Elf32_Off offset;
+    Elf32_Word size;
+    Elf32_Word align;
+    uint16_t sec_idx;
+    bool no_bits;
+    uint8_t role;
+} ELFLoadCacheSection;
+
+typedef struct {
+    Elf32_Addr offset; // Offset in the relocated section
+    Elf32_Addr value; // Absolute address or offset in the target section
+    uint8_t section; // Relocated section index in the cache
+    uint8_t target; // Target section index in the cache or ELF_LOAD_CACHE_ABSOLUTE
+    uint8_t type;
+} FURI_PACKED ELFLoadCacheRelocation;
+
+ARRAY_DEF(ELFLoadCacheSectionArray, ELFLoadCacheSection, M_POD_OPLIST) //-V658
+ARRAY_DEF(ELFLoadCacheRelocationArray, ELFLoadCacheRelocation, M_POD_OPLIST) //-V658
+
+struct ELFLoadCache {
+    ELFLoadCacheSectionArray_t sections;
+    ELFLoadCacheRelocationArray_t relocations;
+    off_t entry; // Entry point offset in .text
+};
+
+static void elf_load_cache_drop(ELFFile* elf) {
+    if(elf->load_cache) {
+        elf_load_cache_free(elf->load_cache);
+        elf->load_cache = NULL;
+    }
+}
+
+static void elf_load_cache_add_section(
+    ELFFile* elf,
+    const char* name,
+    const Elf32_Shdr* section_header,
+    const ELFSection* section) {
+    ELFLoadCache* cache = elf->load_cache;
+
+    if(ELFLoadCacheSectionArray_size(cache->sections) == ELF_LOAD_CACHE_MAX_SECTIONS) {
+        FURI_LOG_W(TAG, "Too many sections to cache");
+        elf_load_cache_drop(elf);
+        return;
+    }
+
+    ELFLoadCacheSectionRole role = ELFLoadCacheSectionRoleNone;
+    if(section == elf->preinit_array) {
+        role = ELFLoadCacheSectionRolePreinitArray;
+    } else if(section == elf->init_array) {
+        role = ELFLoadCacheSectionRoleInitArray;
+    } else if(section == elf->fini_array) {
+        role = ELFLoadCacheSectionRoleFiniArray;
+    }
+
+    ELFLoadCacheSectionArray_push_back(
+        cache->sections,
+        (ELFLoadCacheSection){
+            .name = strdup(name),
+            .data = section->data,
+            .offset = section_header->sh_offset,
+            .size = section_header->sh_size,
+            .align = section_header->sh_addralign,
+            .sec_idx = section->sec_idx,
+            .no_bits = section_header->sh_type == SHT_NOBITS,
+            .role = role,
+        });
+}
+
+static void elf_load_cache_add_relocation(
+    ELFFile* elf,
+    const ELFSection* section,
+    Elf32_Addr rel_offset,
+    int type,
+    Elf32_Addr sym_addr) {
+    ELFLoadCache* cache = elf->load_cache;
+    ELFLoadCacheRelocation relocation = {
+        .offset = rel_offset,
+        .value = sym_addr,
+        .section = ELF_LOAD_CACHE_ABSOLUTE,
+        .target = ELF_LOAD_CACHE_ABSOLUTE,
+        .type = type,
+    };
+
+    // Symbols inside loaded sections move between loads, firmware symbols don't
+    const size_t count = ELFLoadCacheSectionArray_size(cache->sections);
+    for(size_t i = 0; i < count; i++) {
+        const ELFLoadCacheSection* cached = ELFLoadCacheSectionArray_cget(cache->sections, i);
+        const Elf32_Addr base = (Elf32_Addr)cached->data;
+        if(cached->sec_idx == section->sec_idx) {
+            relocation.section = i;
+        }
+        if(relocation.target == ELF_LOAD_CACHE_ABSOLUTE && base && sym_addr >= base &&
+           sym_addr <= base + cached->size) {
+            relocation.target = i;
+            relocation.value = sym_addr - base;
+        }
+    }
+
+    if(relocation.section == ELF_LOAD_CACHE_ABSOLUTE) {
+        FURI_LOG_W(TAG, "Relocated section is not cached");
+        elf_load_cache_drop(elf);
+        return;
+    }
+
+    ELFLoadCacheRelocationArray_push_back(cache->relocations, relocation);
+}
+
 /**************************************************************************************************/
 /********************************************** ELF ***********************************************/
 /**************************************************************************************************/
@@ -415,6 +541,8 @@ static bool elf_relocate(ELFFile* elf, ELFSection* s) {
                     (unsigned int)relAddr);
                 if(!elf_relocate_symbol(elf, relAddr, relType, symAddr)) {
                     relocate_result = false;
+                } else if(elf->load_cache) {
+                    elf_load_cache_add_relocation(elf, s, rel.r_offset, relType, symAddr);
                 }
             } else {
                 FURI_LOG_E(TAG, "  No symbol address of %s", furi_string_get_cstr(symbol_name));
@@ -576,6 +704,8 @@ static SectionTypeInfo elf_preload_section(
 
         if(info.result != ELFLoadSectionResultSuccess) {
             FURI_LOG_E(TAG, "Error loading section '%s'", name);
+        } else if(elf->load_cache) {
+            elf_load_cache_add_section(elf, name, section_header, section_p);
         }
 
         return info;
@@ -760,6 +890,9 @@ static bool elf_relocate_fast(ELFFile* elf, ELFSection* s) {
                 start += 3;
                 Elf32_Addr relAddr = ((Elf32_Addr)s->data) + offset;
                 elf_relocate_symbol(elf, relAddr, type, address);
+                if(elf->load_cache) {
+                    elf_load_cache_add_relocation(elf, s, offset, type, address);
+                }
             }
         }
     }
@@ -857,6 +990,7 @@ void elf_file_free(ELFFile* elf) {
         free(elf->debug_link_info.debug_link);
     }
 
+    elf_load_cache_drop(elf);
     elf_file_maybe_release_fd(elf);
     free(elf);
 }
@@ -992,10 +1126,15 @@ ELFFileLoadStatus elf_file_load_sections(ELFFile* elf) {
             FURI_LOG_E(TAG, "No .text section found");
             status = ELFFileLoadStatusUnspecifiedError;
         } else {
+            if(elf->load_cache) elf->load_cache->entry = elf->entry;
             elf->entry += (uint32_t)text_section->data;
         }
     }
 
+    if(status != ELFFileLoadStatusSuccess) {
+        elf_load_cache_drop(elf);
+    }
+
     FURI_LOG_D(TAG, "Relocation cache size: %u", AddressCache_size(elf->relocation_cache));
     FURI_LOG_D(TAG, "Trampoline cache size: %u", AddressCache_size(elf->trampoline_cache));
     AddressCache_clear(elf->relocation_cache);
@@ -1078,3 +1217,149 @@ void elf_file_clear_debug_info(ELFDebugInfo* debug_info) {
 
     debug_info->mmap_entry_count = 0;
 }
+
+void elf_file_enable_load_cache(ELFFile* elf) {
+    furi_check(elf);
+    furi_check(ELFSectionDict_size(elf->sections) == 0);
+
+    if(!elf->load_cache) {
+        elf->load_cache = malloc(sizeof(ELFLoadCache));
+        ELFLoadCacheSectionArray_init(elf->load_cache->sections);
+        ELFLoadCacheRelocationArray_init(elf->load_cache->relocations);
+    }
+}
+
+ELFLoadCache* elf_file_take_load_cache(ELFFile* elf) {
+    furi_check(elf);
+
+    ELFLoadCache* cache = elf->load_cache;
+    elf->load_cache = NULL;
+
+    // Only a fully relocated load has a complete cache
+    if(cache && elf->fd) {
+        elf_load_cache_free(cache);
+        cache = NULL;
+    }
+
+    if(cache) {
+        ELFLoadCacheSectionArray_it_t it;
+        for(ELFLoadCacheSectionArray_it(it, cache->sections); !ELFLoadCacheSectionArray_end_p(it);
+            ELFLoadCacheSectionArray_next(it)) {
+            ELFLoadCacheSectionArray_ref(it)->data = NULL;
+        }
+        // Drop the growth slack, the cache lives as long as its owner wants
+        ELFLoadCacheSectionArray_reserve(cache->sections, 0);
+        ELFLoadCacheRelocationArray_reserve(cache->relocations, 0);
+    }
+
+    return cache;
+}
+
+ELFFileLoadStatus
+    elf_file_load_from_cache(ELFFile* elf, const char* path, const ELFLoadCache* cache) {
+    furi_check(elf);
+    furi_check(path);
+    furi_check(cache);
+    furi_check(ELFSectionDict_size(elf->sections) == 0);
+
+    if(!storage_file_open(elf->fd, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        return ELFFileLoadStatusUnspecifiedError;
+    }
+
+    ELFFileLoadStatus status = ELFFileLoadStatusSuccess;
+    const size_t section_count = ELFLoadCacheSectionArray_size(cache->sections);
+
+    for(size_t i = 0; i < section_count; i++) {
+        const ELFLoadCacheSection* cached = ELFLoadCacheSectionArray_cget(cache->sections, i);
+        ELFSection* section = elf_file_get_or_put_section(elf, cached->name);
+        section->sec_idx = cached->sec_idx;
+
+        if(cached->role == ELFLoadCacheSectionRolePreinitArray) {
+            elf->preinit_array = section;
+        } else if(cached->role == ELFLoadCacheSectionRoleInitArray) {
+            elf->init_array = section;
+        } else if(cached->role == ELFLoadCacheSectionRoleFiniArray) {
+            elf->fini_array = section;
+        }
+
+        Elf32_Shdr section_header = {
+            .sh_type = cached->no_bits ? SHT_NOBITS : SHT_PROGBITS,
+            .sh_offset = cached->offset,
+            .sh_size = cached->size,
+            .sh_addralign = cached->align,
+        };
+        if(elf_load_section_data(elf, section, &section_header) != ELFLoadSectionResultSuccess) {
+            FURI_LOG_E(TAG, "Error loading cached section '%s'", cached->name);
+            status = ELFFileLoadStatusUnspecifiedError;
+            break;
+        }
+    }
+
+    if(status == ELFFileLoadStatusSuccess) {
+        // Sections are all in place, resolve their final addresses once
+        ELFSection** sections = malloc(sizeof(ELFSection*) * section_count);
+        for(size_t i = 0; i < section_count; i++) {
+            sections[i] = elf_file_get_section(
+                elf, ELFLoadCacheSectionArray_cget(cache->sections, i)->name);
+        }
+
+        ELFLoadCacheRelocationArray_it_t it;
+        for(ELFLoadCacheRelocationArray_it(it, cache->relocations);
+            !ELFLoadCacheRelocationArray_end_p(it);
+            ELFLoadCacheRelocationArray_next(it)) {
+            const ELFLoadCacheRelocation* relocation = ELFLoadCacheRelocationArray_cref(it);
+            Elf32_Addr rel_addr = (Elf32_Addr)sections[relocation->section]->data +
+                                  relocation->offset;
+            Elf32_Addr sym_addr = relocation->value;
+            if(relocation->target != ELF_LOAD_CACHE_ABSOLUTE) {
+                sym_addr += (Elf32_Addr)sections[relocation->target]->data;
+            }
+            elf_relocate_symbol(elf, rel_addr, relocation->type, sym_addr);
+        }
+
+        elf->entry = cache->entry;
+        ELFSection* text_section = elf_file_get_section(elf, ".text");
+        if(text_section == NULL) {
+            FURI_LOG_E(TAG, "No .text section found");
+            status = ELFFileLoadStatusUnspecifiedError;
+        } else {
+            elf->entry += (uint32_t)text_section->data;
+        }
+
+        free(sections);
+    }
+
+    elf_file_maybe_release_fd(elf);
+    return status;
+}
+
+size_t elf_load_cache_get_size(const ELFLoadCache* cache) {
+    furi_check(cache);
+
+    size_t size = sizeof(ELFLoadCache) +
+                  ELFLoadCacheSectionArray_size(cache->sections) * sizeof(ELFLoadCacheSection) +
+                  ELFLoadCacheRelocationArray_size(cache->relocations) *
+                      sizeof(ELFLoadCacheRelocation);
+
+    ELFLoadCacheSectionArray_it_t it;
+    for(ELFLoadCacheSectionArray_it(it, cache->sections); !ELFLoadCacheSectionArray_end_p(it);
+        ELFLoadCacheSectionArray_next(it)) {
+        size += strlen(ELFLoadCacheSectionArray_cref(it)->name) + 1;
+    }
+
+    return size;
+}
+
+void elf_load_cache_free(ELFLoadCache* cache) {
+    furi_check(cache);
+
+    ELFLoadCacheSectionArray_it_t it;
+    for(ELFLoadCacheSectionArray_it(it, cache->sections); !ELFLoadCacheSectionArray_end_p(it);
+        ELFLoadCacheSectionArray_next(it)) {
+        free(ELFLoadCacheSectionArray_ref(it)->name);
+    }
+
+    ELFLoadCacheSectionArray_clear(cache->sections);
+    ELFLoadCacheRelocationArray_clear(cache->relocations);
+    free(cache);
+}
@@ -13,6 +13,9 @@ extern "C" {
 
 typedef struct ELFFile ELFFile;
 
+/** Section layout and resolved relocations of a loaded ELF file */
+typedef struct ELFLoadCache ELFLoadCache;
+
 typedef struct {
     const char* name;
     uint32_t address;
@@ -150,6 +153,46 @@ ElfProcessSectionResult elf_process_section(
     ElfProcessSection* process_section,
     void* context);
 
+/**
+ * @brief Record section layout and relocation results while loading
+ * Must be called before elf_file_load_section_table
+ * @param elf_file 
+ */
+void elf_file_enable_load_cache(ELFFile* elf_file);
+
+/**
+ * @brief Take load cache recorded by a successful elf_file_load_sections
+ * @param elf_file 
+ * @return ELFLoadCache* or NULL if nothing was recorded, owned by the caller
+ */
+ELFLoadCache* elf_file_take_load_cache(ELFFile* elf_file);
+
+/**
+ * @brief Load and relocate ELF file sections from a load cache
+ * Replaces elf_file_open, elf_file_load_section_table and elf_file_load_sections:
+ * headers are not parsed and symbols are not resolved, only section data is read.
+ * The file must be the same the cache was recorded from.
+ * @param elf_file 
+ * @param path 
+ * @param cache 
+ * @return ELFFileLoadStatus 
+ */
+ELFFileLoadStatus
+    elf_file_load_from_cache(ELFFile* elf_file, const char* path, const ELFLoadCache* cache);
+
+/**
+ * @brief Get memory used by a load cache
+ * @param cache 
+ * @return size_t 
+ */
+size_t elf_load_cache_get_size(const ELFLoadCache* cache);
+
+/**
+ * @brief Free load cache
+ * @param cache 
+ */
+void elf_load_cache_free(ELFLoadCache* cache);
+
 #ifdef __cplusplus
 }
 #endif
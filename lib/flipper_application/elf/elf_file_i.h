@@ -51,6 +51,8 @@ struct ELFFile {
     ELFSection* fini_array;
 
     bool init_array_called;
+
+    ELFLoadCache* load_cache; // Recorded while loading, NULL unless enabled
 };
 
 #ifdef __cplusplus
@@ -11,11 +11,17 @@
 struct FlipperApplication {
     ELFDebugInfo state;
     FlipperApplicationManifest manifest;
+    FlipperApplicationLoadTimes load_times;
     ELFFile* elf;
     FuriThread* thread;
     void* ep_thread_args;
 };
 
+struct FlipperApplicationWarmImage {
+    FlipperApplicationManifest manifest;
+    ELFLoadCache* elf_cache;
+};
+
 /********************** Debugger access to loader state **********************/
 
 LIST_DEF(FlipperApplicationList, const FlipperApplication*, M_POD_OPLIST); // NOLINT
@@ -154,9 +160,12 @@ static bool flipper_application_process_assets_section(
 
 static FlipperApplicationPreloadStatus
     flipper_application_load(FlipperApplication* app, const char* path, bool load_full) {
+    memset(&app->load_times, 0, sizeof(app->load_times));
+    app->load_times.open_start = furi_get_tick();
     if(!elf_file_open(app->elf, path)) {
         return FlipperApplicationPreloadStatusInvalidFile;
     }
+    app->load_times.open_end = furi_get_tick();
 
     // if we are loading full file
     if(load_full) {
@@ -185,6 +194,7 @@ static FlipperApplicationPreloadStatus
        ElfProcessSectionResultSuccess) {
         return FlipperApplicationPreloadStatusInvalidFile;
     }
+    app->load_times.sections_end = furi_get_tick();
 
     return flipper_application_validate_manifest(app);
 }
@@ -212,10 +222,14 @@ const FlipperApplicationManifest* flipper_application_get_manifest(FlipperApplic
     return &app->manifest;
 }
 
-FlipperApplicationLoadStatus flipper_application_map_to_memory(FlipperApplication* app) {
+const FlipperApplicationLoadTimes* flipper_application_get_load_times(FlipperApplication* app) {
     furi_check(app);
+    return &app->load_times;
+}
 
-    ELFFileLoadStatus status = elf_file_load_sections(app->elf);
+static FlipperApplicationLoadStatus
+    flipper_application_map_status(FlipperApplication* app, ELFFileLoadStatus status) {
+    app->load_times.relocation_end = furi_get_tick();
 
     switch(status) {
     case ELFFileLoadStatusSuccess:
@@ -229,11 +243,69 @@ FlipperApplicationLoadStatus flipper_application_map_to_memory(FlipperApplicatio
     }
 }
 
+FlipperApplicationLoadStatus flipper_application_map_to_memory(FlipperApplication* app) {
+    furi_check(app);
+
+    app->load_times.relocation_start = furi_get_tick();
+    return flipper_application_map_status(app, elf_file_load_sections(app->elf));
+}
+
+void flipper_application_record_warm_image(FlipperApplication* app) {
+    furi_check(app);
+
+    elf_file_enable_load_cache(app->elf);
+}
+
+FlipperApplicationWarmImage* flipper_application_take_warm_image(FlipperApplication* app) {
+    furi_check(app);
+
+    ELFLoadCache* elf_cache = elf_file_take_load_cache(app->elf);
+    if(!elf_cache) return NULL;
+
+    FlipperApplicationWarmImage* image = malloc(sizeof(FlipperApplicationWarmImage));
+    image->manifest = app->manifest;
+    image->elf_cache = elf_cache;
+
+    return image;
+}
+
+FlipperApplicationLoadStatus flipper_application_map_warm_image(
+    FlipperApplication* app,
+    const char* path,
+    const FlipperApplicationWarmImage* image) {
+    furi_check(app);
+    furi_check(path);
+    furi_check(image);
+
+    // Manifest was validated when the image was recorded
+    app->manifest = image->manifest;
+
+    memset(&app->load_times, 0, sizeof(app->load_times));
+    app->load_times.relocation_start = furi_get_tick();
+    return flipper_application_map_status(
+        app, elf_file_load_from_cache(app->elf, path, image->elf_cache));
+}
+
+size_t flipper_application_warm_image_get_size(const FlipperApplicationWarmImage* image) {
+    furi_check(image);
+
+    return sizeof(FlipperApplicationWarmImage) + elf_load_cache_get_size(image->elf_cache);
+}
+
+void flipper_application_warm_image_free(FlipperApplicationWarmImage* image) {
+    furi_check(image);
+
+    elf_load_cache_free(image->elf_cache);
+    free(image);
+}
+
 static int32_t flipper_application_thread(void* context) {
     furi_check(context);
     FlipperApplication* app = (FlipperApplication*)context;
 
+    app->load_times.init_start = furi_get_tick();
     elf_file_call_init(app->elf);
+    app->load_times.init_end = furi_get_tick();
 
     FlipperApplicationEntryPoint entry_point = elf_file_get_entry_point(app->elf);
     int32_t ret_code = entry_point(app->ep_thread_args);
@@ -46,6 +46,10 @@ const char* flipper_application_load_status_to_string(FlipperApplicationLoadStat
 
 typedef struct FlipperApplication FlipperApplication;
 
+/** Parsed manifest, section layout and relocation results of a mapped application,
+ * used to map the same file again without parsing and symbol resolution */
+typedef struct FlipperApplicationWarmImage FlipperApplicationWarmImage;
+
 typedef struct {
     const char* name;
     uint32_t address;
@@ -58,6 +62,17 @@ typedef struct {
     uint8_t* debug_link;
 } FlipperApplicationState;
 
+/** Ticks taken at the load steps of an application, 0 if the step wasn't reached */
+typedef struct {
+    uint32_t open_start; // ELF headers
+    uint32_t open_end;
+    uint32_t sections_end; // Section table, assets and manifest
+    uint32_t relocation_start; // Section data and relocations, or warm image
+    uint32_t relocation_end;
+    uint32_t init_start; // Init arrays, set by the application thread
+    uint32_t init_end; // Entry point called
+} FlipperApplicationLoadTimes;
+
 /** Initialize FlipperApplication object
  * @param storage Storage instance
  * @param api_interface ELF API interface to use for pre-loading and symbol resolving
@@ -97,12 +112,54 @@ FlipperApplicationPreloadStatus
  */
 const FlipperApplicationManifest* flipper_application_get_manifest(FlipperApplication* app);
 
+/** Get ticks taken while loading and starting the application
+ * @param app Application pointer
+ * @return Pointer to load times, init fields are updated by the application thread
+ */
+const FlipperApplicationLoadTimes* flipper_application_get_load_times(FlipperApplication* app);
+
 /** Load sections and process relocations for already pre-loaded application
  * @param app Application pointer
  * @return Load result code
  */
 FlipperApplicationLoadStatus flipper_application_map_to_memory(FlipperApplication* app);
 
+/** Record warm image while loading, must be called before preload
+ * @param app Application pointer
+ */
+void flipper_application_record_warm_image(FlipperApplication* app);
+
+/** Take warm image recorded by preload and map_to_memory
+ * @param app Application pointer
+ * @return Warm image owned by the caller, NULL if not recorded or mapping failed
+ */
+FlipperApplicationWarmImage* flipper_application_take_warm_image(FlipperApplication* app);
+
+/** Load sections and process relocations using a warm image, replaces
+ * preload and map_to_memory. Only section data is read from the file.
+ *
+ * @param      app    Application pointer
+ * @param[in]  path   The path to fap file, must be unchanged since the image was recorded
+ * @param[in]  image  Warm image
+ *
+ * @return     Load result code
+ */
+FlipperApplicationLoadStatus flipper_application_map_warm_image(
+    FlipperApplication* app,
+    const char* path,
+    const FlipperApplicationWarmImage* image);
+
+/** Get memory held by a warm image
+ * @param image Warm image
+ * @return Size in bytes
+ */
+size_t flipper_application_warm_image_get_size(const FlipperApplicationWarmImage* image);
+
+/** Destroy warm image
+ * @param image Warm image
+ */
+void flipper_application_warm_image_free(FlipperApplicationWarmImage* image);
+
 /** Allocate application thread at entry point address, using app name and
  * stack size from metadata. Returned thread isn't started yet. 
  * Can be only called once for application instance.
@@ -13,6 +13,10 @@ def GetProjetDirName(env, project=None):
         suffix += "D"
     if env["COMPACT"]:
         suffix += "C"
+    if env["HEAP"] == "tlsf":
+        suffix += "T"
+    if env["HEAP_SLAB"] != "0":
+        suffix += "S"
     if suffix:
         parts.append(suffix)
 